@@ -0,0 +1,94 @@
+/**
+ * @file bench_divide.cpp
+ * @brief Cycles par conversion : division 64 bits contre PreciseTimeDivide
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTime.h>
+#include <PreciseTimeDivide.h>
+#include <PreciseTimeTsc.h>
+
+#define DIVIDE_CALLS  5000000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+static volatile uint64_t divide_sink;
+
+// Diviseurs lus en mémoire : le compilateur ne peut pas les remplacer par
+// une multiplication, comme sur une cible sans division matérielle
+// 64 bits où chaque / appelle __udivdi3.
+static volatile uint64_t opaque_1000 = 1000ULL;
+static volatile uint64_t opaque_86400 = 86400ULL;
+static volatile uint64_t opaque_3600 = 3600ULL;
+static volatile uint64_t opaque_60 = 60ULL;
+
+static uint64_t millisDivide(uint64_t us) { return us / opaque_1000; }
+static uint64_t millisConstant(uint64_t us) { return us / 1000ULL; }
+static uint64_t millisReciprocal(uint64_t us) { return PreciseTimeDivide<1000ULL>::quotient(us); }
+
+static uint64_t formattedDivide(uint64_t total) {
+    uint64_t days = total / opaque_86400;
+    uint64_t remaining = total % opaque_86400;
+    uint64_t hours = remaining / opaque_3600;
+    remaining %= opaque_3600;
+    uint64_t minutes = remaining / opaque_60;
+    uint64_t seconds = remaining % opaque_60;
+    return days + hours + minutes + seconds;
+}
+
+static uint64_t formattedReciprocal(uint64_t total) {
+    uint64_t days = PreciseTimeDivide<86400ULL>::quotient(total);
+    uint32_t remaining = (uint32_t)(total - days * 86400ULL);
+    uint32_t hours = PreciseTimeDivide<3600ULL>::quotient32(remaining);
+    remaining -= hours * 3600UL;
+    uint32_t minutes = PreciseTimeDivide<60ULL>::quotient32(remaining);
+    uint32_t seconds = remaining - minutes * 60UL;
+    return days + hours + minutes + seconds;
+}
+
+/**
+ * @brief Cycles TSC moyens par appel sur des entrées pseudo-aléatoires,
+ *        meilleur de 5 séries (le xorshift est inclus dans la mesure)
+ */
+template <uint64_t (*Convert)(uint64_t)>
+static double cyclesPerConversion() {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < DIVIDE_CALLS; i++) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            divide_sink = Convert(x >> 8);
+        }
+        double cycles = (double)(__rdtsc() - start) / DIVIDE_CALLS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+#endif
+
+void run_divide_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Conversions d'unités (%d appels) ---\n", DIVIDE_CALLS);
+    report("us / 1000 (division)", cyclesPerConversion<millisDivide>());
+    report("us / 1000 (constante, compilateur)", cyclesPerConversion<millisConstant>());
+    report("PreciseTimeDivide<1000>::quotient()", cyclesPerConversion<millisReciprocal>());
+    report("j/h/min/s (4 divisions + 2 modulos)", cyclesPerConversion<formattedDivide>());
+    report("j/h/min/s (PreciseTimeDivide)", cyclesPerConversion<formattedReciprocal>());
+    printf("\n");
+#else
+    printf("--- Conversions d'unités : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
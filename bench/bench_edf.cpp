@@ -0,0 +1,171 @@
+/**
+ * @file bench_edf.cpp
+ * @brief Ordonnanceur EDF (tas 4-aire indexé) contre std::priority_queue,
+ *        de 1 000 à 100 000 travaux en attente
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <queue>
+#include <vector>
+#include <PreciseTimeEdfScheduler.h>
+#include <PreciseTimeTsc.h>
+
+#define EDF_OPERATIONS  1000000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+// Horloge virtuelle : la comptabilité des retards ne lit pas le matériel
+typedef PreciseTimeT<PreciseTimeSimBackend> EdfBenchTime;
+
+static volatile uint32_t edf_sink;
+
+static void noopJob(void*) {
+    edf_sink++;
+}
+
+struct EdfBenchRng {
+    uint32_t state;
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+// Référence : tas binaire de la STL ; sans décroissance de clé, une
+// nouvelle entrée est poussée et l'ancienne ignorée au retrait (version)
+struct PqEntry {
+    uint64_t deadline;
+    uint32_t id;
+    uint32_t version;
+    bool operator>(const PqEntry& other) const { return deadline > other.deadline; }
+};
+
+struct PqScheduler {
+    std::priority_queue<PqEntry, std::vector<PqEntry>, std::greater<PqEntry> > queue;
+    std::vector<uint32_t> versions;
+
+    explicit PqScheduler(size_t count) : versions(count, 0) {}
+
+    void submit(uint64_t deadline, uint32_t id) {
+        PqEntry entry = { deadline, id, versions[id] };
+        queue.push(entry);
+    }
+
+    void setDeadline(uint32_t id, uint64_t deadline) {
+        versions[id]++;
+        submit(deadline, id);
+    }
+
+    // Ne garde que les entrées vivantes, une par travail, comme le tas
+    // d'EDF : les entrées périmées de setDeadline() ne faussent pas la suite
+    void compact(const std::vector<uint64_t>& deadlines) {
+        std::vector<PqEntry> live(versions.size());
+        for (uint32_t id = 0; id < live.size(); id++) {
+            PqEntry entry = { deadlines[id], id, versions[id] };
+            live[id] = entry;
+        }
+        queue = std::priority_queue<PqEntry, std::vector<PqEntry>, std::greater<PqEntry> >(
+            std::greater<PqEntry>(), live);
+    }
+
+    // Exécute le plus urgent ; renvoie son identifiant
+    uint32_t runNext(uint64_t& deadline) {
+        for (;;) {
+            PqEntry entry = queue.top();
+            queue.pop();
+            if (entry.version != versions[entry.id]) continue;
+            noopJob(nullptr);
+            deadline = entry.deadline;
+            return entry.id;
+        }
+    }
+};
+
+static void report(const char* name, double edf, double pq) {
+    printf("  %-40s %8.1f cycles  %8.1f cycles\n", name, edf, pq);
+}
+
+template <uint32_t N>
+static void benchEdf() {
+    typedef PreciseTimeEdfScheduler<EdfBenchTime, N, 1> Edf;
+    Edf* edf = new Edf();
+    PqScheduler pq(N);
+    std::vector<typename Edf::Handle> handles(N);
+    EdfBenchRng rng = { 88172645UL };
+
+    std::vector<uint64_t> deadlines(N);
+    for (uint32_t i = 0; i < N; i++) deadlines[i] = rng.next() % 1000000;
+
+    uint64_t start = __rdtsc();
+    for (uint32_t i = 0; i < N; i++) handles[i] = edf->submit(deadlines[i], noopJob);
+    double edf_submit = (double)(__rdtsc() - start) / N;
+    start = __rdtsc();
+    for (uint32_t i = 0; i < N; i++) pq.submit(deadlines[i], i);
+    double pq_submit = (double)(__rdtsc() - start) / N;
+
+    // Décroissance de clé sur un travail au hasard
+    std::vector<uint32_t> picks(EDF_OPERATIONS);
+    for (uint32_t i = 0; i < EDF_OPERATIONS; i++) picks[i] = rng.next() % N;
+    start = __rdtsc();
+    for (uint32_t i = 0; i < EDF_OPERATIONS; i++) {
+        typename Edf::Handle handle = handles[picks[i]];
+        edf->setDeadline(handle, edf->deadline(handle) - (edf->deadline(handle) >> 4));
+    }
+    double edf_decrease = (double)(__rdtsc() - start) / EDF_OPERATIONS;
+    start = __rdtsc();
+    for (uint32_t i = 0; i < EDF_OPERATIONS; i++) {
+        uint32_t id = picks[i];
+        deadlines[id] -= deadlines[id] >> 4;
+        pq.setDeadline(id, deadlines[id]);
+    }
+    double pq_decrease = (double)(__rdtsc() - start) / EDF_OPERATIONS;
+    pq.compact(deadlines);
+
+    // Régime établi : exécuter le plus urgent, soumettre son successeur
+    start = __rdtsc();
+    for (uint32_t i = 0; i < EDF_OPERATIONS; i++) {
+        uint64_t deadline = edf->nextDeadline();
+        edf->runNext();
+        edf->submit(deadline + (picks[i] & 0xFFFF), noopJob);
+    }
+    double edf_hold = (double)(__rdtsc() - start) / EDF_OPERATIONS;
+    start = __rdtsc();
+    for (uint32_t i = 0; i < EDF_OPERATIONS; i++) {
+        uint64_t deadline;
+        uint32_t id = pq.runNext(deadline);
+        pq.submit(deadline + (picks[i] & 0xFFFF), id);
+    }
+    double pq_hold = (double)(__rdtsc() - start) / EDF_OPERATIONS;
+
+    char title[48];
+    snprintf(title, sizeof(title), "%u travaux en attente", N);
+    printf("  %-40s %15s  %15s\n", title, "EDF 4-aire", "priority_queue");
+    report("  submit()", edf_submit, pq_submit);
+    report("  setDeadline() (décroissance)", edf_decrease, pq_decrease);
+    report("  runNext() + submit()", edf_hold, pq_hold);
+    delete edf;
+}
+#endif
+
+void run_edf_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Ordonnanceur EDF (%d opérations) ---\n", EDF_OPERATIONS);
+    EdfBenchTime::begin();
+    benchEdf<1000>();
+    benchEdf<10000>();
+    benchEdf<100000>();
+    printf("\n");
+#else
+    printf("--- Ordonnanceur EDF : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
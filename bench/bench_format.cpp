@@ -0,0 +1,122 @@
+/**
+ * @file bench_format.cpp
+ * @brief Cycles et allocations par mise en forme du temps
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <PreciseTime.h>
+#include <PreciseTimeFormat.h>
+#include <PreciseTimeTsc.h>
+
+#define FORMAT_CALLS  1000000
+
+// Compte les allocations de tout le programme de benchmark
+static unsigned long long format_allocations = 0;
+
+void* operator new(size_t size) {
+    format_allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+#if defined(PRECISE_TIME_HAS_TSC)
+static volatile size_t format_sink;
+
+// Ancienne implémentation de getFormattedString() : snprintf puis chaîne
+static size_t legacyFormattedString(uint64_t micros) {
+    uint64_t total_seconds = micros / 1000000ULL;
+    uint64_t days = total_seconds / 86400ULL;
+    uint64_t remaining = total_seconds % 86400ULL;
+    unsigned long hours = remaining / 3600ULL;
+    remaining %= 3600ULL;
+    unsigned long minutes = remaining / 60ULL;
+    unsigned long seconds = remaining % 60ULL;
+    char buffer[64];
+    if (days > 0) {
+        snprintf(buffer, sizeof(buffer), "%llu jours, %02lu:%02lu:%02lu",
+                 (unsigned long long)days, hours, minutes, seconds);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%02lu:%02lu:%02lu", hours, minutes, seconds);
+    }
+    PreciseTimeString text(buffer);
+    return text.length();
+}
+
+static size_t snprintfBuffer(uint64_t micros) {
+    uint64_t s = micros / 1000000ULL;
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    return (size_t)snprintf(buffer, sizeof(buffer), "%llud %02u:%02u:%02u",
+                            (unsigned long long)(s / 86400ULL), (unsigned)(s % 86400ULL / 3600ULL),
+                            (unsigned)(s % 3600ULL / 60ULL), (unsigned)(s % 60ULL));
+}
+
+static size_t formatterUptime(uint64_t micros) {
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    return PreciseTimeFormatter::formatUptime(buffer, sizeof(buffer), micros / 1000000ULL);
+}
+
+static size_t formatterDays(uint64_t micros) {
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    return PreciseTimeFormatter::format(buffer, sizeof(buffer), micros, PRECISE_TIME_DAYS_HMS);
+}
+
+static size_t formatterMicros(uint64_t micros) {
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    return PreciseTimeFormatter::format(buffer, sizeof(buffer), micros, PRECISE_TIME_HMS_MICROS);
+}
+
+/**
+ * @brief Cycles TSC et allocations par appel, meilleur de 5 séries
+ *
+ * Durées de 0 à ~12 jours : la chaîne "N jours, HH:MM:SS" dépasse le
+ * tampon interne de std::string (SSO), comme String l'est toujours.
+ */
+template <size_t (*Format)(uint64_t)>
+static void measure(const char* name) {
+    double best = 1e30;
+    unsigned long long allocations = 0;
+    for (int round = 0; round < 5; round++) {
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        unsigned long long before = format_allocations;
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < FORMAT_CALLS; i++) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            format_sink = Format(x >> 24);
+        }
+        double cycles = (double)(__rdtsc() - start) / FORMAT_CALLS;
+        allocations = format_allocations - before;
+        if (cycles < best) best = cycles;
+    }
+    printf("  %-40s %8.1f cycles  %5.2f alloc/appel\n", name, best,
+           (double)allocations / FORMAT_CALLS);
+}
+#endif
+
+void run_format_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Mise en forme (%d appels) ---\n", FORMAT_CALLS);
+    measure<legacyFormattedString>("snprintf + chaîne (ancien)");
+    measure<snprintfBuffer>("snprintf dans un tampon");
+    measure<formatterUptime>("formatUptime() (sans chaîne)");
+    measure<formatterDays>("format(PRECISE_TIME_DAYS_HMS)");
+    measure<formatterMicros>("format(PRECISE_TIME_HMS_MICROS)");
+    printf("\n");
+#else
+    printf("--- Mise en forme : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
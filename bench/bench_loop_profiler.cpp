@@ -0,0 +1,81 @@
+/**
+ * @file bench_loop_profiler.cpp
+ * @brief Coût de PreciseTimeLoopProfiler::tick() par itération
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTimeLoopProfiler.h>
+#include <PreciseTimeTsc.h>
+
+#define LOOP_ITERATIONS  2000000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+typedef PreciseTimeT<PreciseTimeNativeBackend> LoopNativeTime;
+typedef PreciseTimeT<PreciseTimeTscBackend> LoopTscTime;
+
+static PreciseTimeLoopProfiler<LoopNativeTime> native_profiler(1000);
+static PreciseTimeLoopProfiler<LoopTscTime> tsc_profiler(1000);
+static volatile uint64_t loop_sink;
+
+static void readNative() {
+    loop_sink = LoopNativeTime::getTicks();
+}
+
+static void tickNative() {
+    native_profiler.tick();
+}
+
+static void tickTsc() {
+    tsc_profiler.tick();
+}
+
+static void labelAndTickTsc() {
+    tsc_profiler.label("bench");
+    tsc_profiler.tick();
+}
+
+/**
+ * @brief Cycles TSC moyens par itération, meilleur de 5 séries
+ */
+template <void (*Body)()>
+static double cyclesPerIteration() {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < LOOP_ITERATIONS; i++) {
+            Body();
+        }
+        double cycles = (double)(__rdtsc() - start) / LOOP_ITERATIONS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+#endif
+
+void run_loop_profiler_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- LoopProfiler (%d itérations) ---\n", LOOP_ITERATIONS);
+    LoopNativeTime::begin();
+    LoopTscTime::begin();
+    report("getTicks() natif seul", cyclesPerIteration<readNative>());
+    report("tick() (natif)", cyclesPerIteration<tickNative>());
+    report("tick() (TSC)", cyclesPerIteration<tickTsc>());
+    report("label() + tick() (TSC)", cyclesPerIteration<labelAndTickTsc>());
+    printf("\n");
+#else
+    printf("--- LoopProfiler : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
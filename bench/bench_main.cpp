@@ -0,0 +1,66 @@
+/**
+ * @file bench_main.cpp
+ * @brief Point d'entrée des benchmarks natifs (pio run -e bench)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+// Benchmarks définis dans les autres fichiers de bench/
+void run_native_clock_benchmarks();
+void run_divide_benchmarks();
+void run_format_benchmarks();
+void run_scope_benchmarks();
+void run_trace_benchmarks();
+void run_trace_stream_benchmarks();
+void run_loop_profiler_benchmarks();
+void run_timer_wheel_benchmarks();
+void run_edf_benchmarks();
+void run_sleep_benchmarks();
+uint32_t run_precise_time_benchmarks(bool json, const char* filter);
+
+/**
+ * Options : --json (suite PRECISE_BENCHMARK seule, en JSON sur stdout),
+ * --filter=texte (benchmarks dont le nom contient texte).
+ */
+int main(int argc, char** argv) {
+    bool json = false;
+    const char* filter = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else {
+            fprintf(stderr, "usage : %s [--json] [--filter=texte]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (json) {
+        return run_precise_time_benchmarks(true, filter) > 0 ? 0 : 1;
+    }
+
+    printf("=== Benchmarks natifs PreciseTime ===\n\n");
+    run_precise_time_benchmarks(false, filter);
+    run_native_clock_benchmarks();
+    run_divide_benchmarks();
+    run_format_benchmarks();
+    run_scope_benchmarks();
+    run_trace_benchmarks();
+    run_trace_stream_benchmarks();
+    run_loop_profiler_benchmarks();
+    run_timer_wheel_benchmarks();
+    run_edf_benchmarks();
+    run_sleep_benchmarks();
+    return 0;
+}
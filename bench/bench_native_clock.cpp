@@ -0,0 +1,95 @@
+/**
+ * @file bench_native_clock.cpp
+ * @brief Cycles par appel des backends natifs : clock_gettime() et TSC
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTime.h>
+#include <PreciseTimeTsc.h>
+
+#define NATIVE_CLOCK_CALLS  2000000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+static volatile uint64_t native_clock_sink;
+
+static uint64_t clockGettime(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t monotonicRaw() { return clockGettime(CLOCK_MONOTONIC_RAW); }
+static uint64_t monotonic() { return clockGettime(CLOCK_MONOTONIC); }
+static uint64_t monotonicCoarse() { return clockGettime(CLOCK_MONOTONIC_COARSE); }
+typedef PreciseTimeT<PreciseTimeNativeBackend> NativeTime;
+typedef PreciseTimeT<PreciseTimeTscBackend> TscTime;
+static uint64_t nativeTimeNanos() { return NativeTime::getNanoseconds(); }
+static uint64_t tscTimeNanos() { return TscTime::getNanoseconds(); }
+static uint64_t nativeTimeMillis() { return NativeTime::getMilliseconds(); }
+static uint64_t nativeCoarseMillis() { return NativeTime::getCoarseMilliseconds(); }
+
+static PreciseTimeTsc bench_tsc;
+static uint64_t tscNanos() { return bench_tsc.nanoseconds(); }
+
+/**
+ * @brief Cycles TSC moyens par appel, meilleur de 5 séries
+ */
+template <uint64_t (*Clock)()>
+static double cyclesPerCall() {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < NATIVE_CLOCK_CALLS; i++) {
+            native_clock_sink = Clock();
+        }
+        double cycles = (double)(__rdtsc() - start) / NATIVE_CLOCK_CALLS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles, double ghz) {
+    printf("  %-40s %8.1f cycles  %8.2f ns\n", name, cycles, cycles / ghz);
+}
+#endif
+
+void run_native_clock_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Horloges natives (%d appels) ---\n", NATIVE_CLOCK_CALLS);
+    NativeTime::begin();
+    TscTime::begin();
+    bool tsc_ok = bench_tsc.calibrate();
+    double ghz = tsc_ok ? bench_tsc.frequencyHz() / 1e9 : 1.0;
+    if (tsc_ok) {
+        printf("  TSC invariant: %.3f GHz\n", ghz);
+    } else {
+        printf("  TSC invariant absent (cycles = ns affichés en ticks)\n");
+    }
+
+    report("clock_gettime(CLOCK_MONOTONIC_RAW)", cyclesPerCall<monotonicRaw>(), ghz);
+    report("clock_gettime(CLOCK_MONOTONIC)", cyclesPerCall<monotonic>(), ghz);
+    if (tsc_ok) {
+        report("PreciseTimeTsc::nanoseconds()", cyclesPerCall<tscNanos>(), ghz);
+    }
+    report("PreciseTimeT<Native>::getNanoseconds()", cyclesPerCall<nativeTimeNanos>(), ghz);
+    report(PreciseTimeTscBackend::usesTsc() ? "PreciseTimeT<Tsc>::getNanoseconds()"
+                                            : "PreciseTimeT<Tsc> (repli vDSO)",
+           cyclesPerCall<tscTimeNanos>(), ghz);
+    NativeTime::beginCoarse();
+    report("clock_gettime(CLOCK_MONOTONIC_COARSE)", cyclesPerCall<monotonicCoarse>(), ghz);
+    report("PreciseTimeT<Native>::getMilliseconds()", cyclesPerCall<nativeTimeMillis>(), ghz);
+    report("getCoarseMilliseconds()", cyclesPerCall<nativeCoarseMillis>(), ghz);
+    printf("\n");
+#else
+    printf("--- Horloges natives : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
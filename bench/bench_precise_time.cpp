@@ -0,0 +1,39 @@
+/**
+ * @file bench_precise_time.cpp
+ * @brief Suite PRECISE_BENCHMARK des méthodes publiques de PreciseTime,
+ *        en texte ou en JSON
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTimeBenchmarkSuite.h>
+#include <PreciseTimeTsc.h>
+
+struct BenchStdout {
+    size_t write(const uint8_t* data, size_t size) {
+        return fwrite(data, 1, size, stdout);
+    }
+};
+
+uint32_t run_precise_time_benchmarks(bool json, const char* filter) {
+    PreciseTime::begin();
+    PreciseTime::beginCoarse();
+#if defined(PRECISE_TIME_HAS_TSC)
+    PreciseTimeTsc tsc;
+    if (tsc.calibrate()) {
+        PreciseTimeBenchmarkRunner<PreciseTime>::setCpuMHz(tsc.frequencyHz() / 1e6);
+    }
+#endif
+    BenchStdout out;
+    uint32_t count = PreciseTimeBenchmarkRunner<PreciseTime>::runAll(out, json, filter);
+    fflush(stdout);
+    return count;
+}
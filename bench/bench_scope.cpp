@@ -0,0 +1,83 @@
+/**
+ * @file bench_scope.cpp
+ * @brief Surcoût d'une portée PRECISE_SCOPE
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTimeScope.h>
+#include <PreciseTimeTsc.h>
+
+#define SCOPE_CALLS  2000000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+typedef PreciseTimeT<PreciseTimeNativeBackend> ScopeNativeTime;
+typedef PreciseTimeT<PreciseTimeTscBackend> ScopeTscTime;
+
+static volatile uint64_t scope_sink;
+
+static void emptyBody() {
+    scope_sink = 0;
+}
+
+static void twoReadsNative() {
+    uint64_t start = ScopeNativeTime::getTicks();
+    scope_sink = 0;
+    scope_sink = ScopeNativeTime::getTicks() - start;
+}
+
+static void scopeNative() {
+    PRECISE_SCOPE_CLOCK(ScopeNativeTime, "bench_native");
+    scope_sink = 0;
+}
+
+static void scopeTsc() {
+    PRECISE_SCOPE_CLOCK(ScopeTscTime, "bench_tsc");
+    scope_sink = 0;
+}
+
+/**
+ * @brief Cycles TSC moyens par appel, meilleur de 5 séries
+ */
+template <void (*Body)()>
+static double cyclesPerScope() {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        uint64_t start = __rdtsc();
+        for (int i = 0; i < SCOPE_CALLS; i++) {
+            Body();
+        }
+        double cycles = (double)(__rdtsc() - start) / SCOPE_CALLS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+#endif
+
+void run_scope_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- PRECISE_SCOPE (%d portées) ---\n", SCOPE_CALLS);
+    ScopeNativeTime::begin();
+    ScopeTscTime::begin();
+    report("corps seul", cyclesPerScope<emptyBody>());
+    report("deux getTicks() natifs", cyclesPerScope<twoReadsNative>());
+    report("PRECISE_SCOPE (natif)", cyclesPerScope<scopeNative>());
+    report(PreciseTimeTscBackend::usesTsc() ? "PRECISE_SCOPE (TSC)" : "PRECISE_SCOPE (TSC, repli vDSO)",
+           cyclesPerScope<scopeTsc>());
+    printf("\n");
+#else
+    printf("--- PRECISE_SCOPE : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
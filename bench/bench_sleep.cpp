@@ -0,0 +1,83 @@
+/**
+ * @file bench_sleep.cpp
+ * @brief Erreur de réveil de sleepFor() (attente hybride) contre nanosleep()
+ *        seul, et part de CPU consommée
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <PreciseTime.h>
+#include <PreciseTimeHistogram.h>
+
+// Erreurs de réveil en ns, jusqu'à 10 ms, deux chiffres significatifs
+typedef PreciseTimeLatencyHistogram<10000000UL, 2> SleepErrorHistogram;
+
+static uint64_t threadCpuNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char* name, const SleepErrorHistogram& errors, double cpu) {
+    printf("  %-40s %8.1f µs  %8.1f µs  %8.1f µs  %5.1f %%\n", name,
+           errors.valueAtPercentile(50.0) / 1000.0,
+           errors.valueAtPercentile(99.0) / 1000.0,
+           errors.max() / 1000.0, cpu * 100.0);
+}
+
+// `hybrid` : sleepUntil() ; sinon nanosleep() de toute la durée
+static void measure(uint64_t duration_us, uint32_t samples, bool hybrid,
+                    SleepErrorHistogram& errors, double& cpu) {
+    errors.reset();
+    uint64_t cpu_start = threadCpuNanos();
+    uint64_t wall_start = PreciseTime::getNanoseconds();
+    for (uint32_t i = 0; i < samples; i++) {
+        uint64_t deadline_ns = PreciseTime::getNanoseconds() + duration_us * 1000ULL;
+        if (hybrid) {
+            PreciseTime::sleepUntil((deadline_ns + 999) / 1000);
+        } else {
+            PreciseTimeYield::sleep(duration_us);
+        }
+        uint64_t woke = PreciseTime::getNanoseconds();
+        errors.record(woke > deadline_ns ? (uint32_t)(woke - deadline_ns) : 0);
+    }
+    uint64_t wall = PreciseTime::getNanoseconds() - wall_start;
+    cpu = wall ? (double)(threadCpuNanos() - cpu_start) / (double)wall : 0.0;
+}
+
+static void benchDuration(uint64_t duration_us, uint32_t samples) {
+    static SleepErrorHistogram errors;
+    double cpu;
+    char title[48];
+
+    // Chauffe : la marge s'ajuste sur les premiers réveils
+    measure(duration_us, samples / 4 + 1, true, errors, cpu);
+
+    snprintf(title, sizeof(title), "nanosleep(%llu µs)", (unsigned long long)duration_us);
+    measure(duration_us, samples, false, errors, cpu);
+    report(title, errors, cpu);
+
+    snprintf(title, sizeof(title), "sleepFor(%llu µs)", (unsigned long long)duration_us);
+    measure(duration_us, samples, true, errors, cpu);
+    report(title, errors, cpu);
+}
+
+void run_sleep_benchmarks() {
+    printf("--- Erreur de réveil (retard sur l'échéance) ---\n");
+    printf("  %-40s %11s  %11s  %11s  %7s\n", "", "p50", "p99", "max", "CPU");
+    PreciseTime::begin();
+    benchDuration(100, 2000);
+    benchDuration(1000, 500);
+    benchDuration(10000, 100);
+    printf("  marge ajustée : %u µs\n\n",
+           (unsigned)PreciseTimeSleeper<PreciseTime, PreciseTimeYield>::margin());
+}
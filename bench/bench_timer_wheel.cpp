@@ -0,0 +1,94 @@
+/**
+ * @file bench_timer_wheel.cpp
+ * @brief Coût d'insertion, d'annulation et de tick de la roue de
+ *        temporisation, de 10 000 à 1 000 000 de minuteries
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <vector>
+#include <PreciseTimeTimerWheel.h>
+#include <PreciseTimeTsc.h>
+
+#define WHEEL_SPAN_US   (600ULL * 1000000ULL)   // échéances sur 10 minutes
+#define WHEEL_STEP_US   1000ULL                 // un advance() par ms
+
+#if defined(PRECISE_TIME_HAS_TSC)
+// Horloge virtuelle : la roue est entraînée par advance(), sans lecture d'horloge
+typedef PreciseTimeT<PreciseTimeSimBackend> WheelBenchTime;
+typedef PreciseTimeTimerWheel<WheelBenchTime> BenchWheel;
+
+static uint64_t wheel_expired;
+
+static void onExpire(PreciseTimeWheelTimer&, void*) {
+    wheel_expired++;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+
+static void benchWheel(size_t count) {
+    std::vector<PreciseTimeWheelTimer> timers(count);
+    std::vector<uint64_t> deadlines(count);
+    uint32_t seed = 2463534242UL;
+    for (size_t i = 0; i < count; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        deadlines[i] = 1000 + seed % WHEEL_SPAN_US;
+    }
+
+    BenchWheel* wheel = new BenchWheel();
+    uint64_t start = __rdtsc();
+    for (size_t i = 0; i < count; i++) {
+        wheel->startAt(timers[i], deadlines[i], onExpire);
+    }
+    double insert = (double)(__rdtsc() - start) / count;
+
+    start = __rdtsc();
+    for (size_t i = 0; i < count; i += 2) {
+        wheel->cancel(timers[i]);
+    }
+    double cancel = (double)(__rdtsc() - start) / ((count + 1) / 2);
+
+    wheel_expired = 0;
+    uint64_t steps = 0;
+    start = __rdtsc();
+    for (uint64_t now = WHEEL_STEP_US; now <= WHEEL_SPAN_US + 1000; now += WHEEL_STEP_US) {
+        wheel->advance(now);
+        steps++;
+    }
+    uint64_t total = __rdtsc() - start;
+
+    char title[64];
+    snprintf(title, sizeof(title), "%zu minuteries", count);
+    printf("  %s (%llu expirées, %u restantes)\n", title,
+           (unsigned long long)wheel_expired, wheel->pending());
+    report("  startAt()", insert);
+    report("  cancel()", cancel);
+    report("  advance() d'1 ms (par appel)", (double)total / steps);
+    report("  advance() total / expiration", (double)total / (wheel_expired ? wheel_expired : 1));
+    delete wheel;
+}
+#endif
+
+void run_timer_wheel_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Roue de temporisation (tick 1 ms, échéances sur 10 min) ---\n");
+    benchWheel(10000);
+    benchWheel(100000);
+    benchWheel(1000000);
+    printf("\n");
+#else
+    printf("--- Roue de temporisation : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
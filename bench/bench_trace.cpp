@@ -0,0 +1,91 @@
+/**
+ * @file bench_trace.cpp
+ * @brief Coût d'enregistrement d'un événement de trace
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTimeTrace.h>
+#include <PreciseTimeTsc.h>
+
+#define TRACE_EVENTS  65536
+
+#if defined(PRECISE_TIME_HAS_TSC)
+typedef PreciseTimeT<PreciseTimeNativeBackend> TraceNativeTime;
+typedef PreciseTimeT<PreciseTimeTscBackend> TraceTscTime;
+typedef PreciseTimeTraceBuffer<TraceNativeTime, TRACE_EVENTS> NativeTraceBuffer;
+typedef PreciseTimeTraceBuffer<TraceTscTime, TRACE_EVENTS> TscTraceBuffer;
+
+static NativeTraceBuffer native_trace;
+static TscTraceBuffer tsc_trace;
+
+static void recordNative(uint32_t i) {
+    native_trace.record(PRECISE_TIME_TRACE_INSTANT, 1, i, 0);
+}
+
+static void recordTsc(uint32_t i) {
+    tsc_trace.record(PRECISE_TIME_TRACE_INSTANT, 1, i, 0);
+}
+
+static void instantTsc(uint32_t i) {
+    tsc_trace.instant(1, i);
+}
+
+static void recordAndPopTsc(uint32_t i) {
+    PreciseTimeTraceEvent event;
+    tsc_trace.record(PRECISE_TIME_TRACE_INSTANT, 1, i, 0);
+    tsc_trace.pop(event);
+}
+
+/**
+ * @brief Cycles TSC moyens par événement, anneau vidé avant chaque série,
+ *        meilleur de 5 séries
+ */
+template <void (*Record)(uint32_t)>
+static double cyclesPerEvent(bool fill_first) {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        native_trace.clear();
+        tsc_trace.clear();
+        if (fill_first) {
+            for (uint32_t i = 0; i < TRACE_EVENTS; i++) Record(i);
+        }
+        uint64_t start = __rdtsc();
+        for (uint32_t i = 0; i < TRACE_EVENTS; i++) {
+            Record(i);
+        }
+        double cycles = (double)(__rdtsc() - start) / TRACE_EVENTS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+#endif
+
+void run_trace_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Traces (%d événements, sizeof(PreciseTimeTraceEvent) = %u) ---\n",
+           TRACE_EVENTS, (unsigned)sizeof(PreciseTimeTraceEvent));
+    TraceNativeTime::begin();
+    TraceTscTime::begin();
+    report("record() (natif)", cyclesPerEvent<recordNative>(false));
+    report("record() (TSC)", cyclesPerEvent<recordTsc>(false));
+    report("instant() (TSC, piste thread_local)", cyclesPerEvent<instantTsc>(false));
+    report("record() + pop() (TSC)", cyclesPerEvent<recordAndPopTsc>(false));
+    report("record() anneau plein (rejet)", cyclesPerEvent<recordTsc>(true));
+    printf("\n");
+#else
+    printf("--- Traces : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_trace_stream.cpp
+ * @brief Débit d'encodage et de décodage du flux binaire de traces
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <stdio.h>
+#include <PreciseTimeTraceStream.h>
+#include <PreciseTimeTsc.h>
+
+#define STREAM_EVENTS  100000
+
+#if defined(PRECISE_TIME_HAS_TSC)
+static PreciseTimeTraceEvent stream_events[STREAM_EVENTS];
+static uint8_t stream_bytes[STREAM_EVENTS * PRECISE_TIME_TRACE_FRAME_MAX];
+static size_t stream_length;
+static volatile uint64_t stream_sink;
+
+// Charge réaliste : événements espacés de 1 à 2000 µs, argument une fois sur quatre
+static void makeEvents() {
+    uint32_t seed = 1;
+    uint64_t timestamp = 0;
+    static const uint8_t phases[3] = {
+        PRECISE_TIME_TRACE_BEGIN, PRECISE_TIME_TRACE_END, PRECISE_TIME_TRACE_INSTANT
+    };
+    for (uint32_t i = 0; i < STREAM_EVENTS; i++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        timestamp += 1 + (seed >> 8) % 2000;
+        stream_events[i].timestamp = timestamp;
+        stream_events[i].arg = (seed & 3) == 0 ? seed >> 20 : 0;
+        stream_events[i].id = (uint16_t)((seed >> 4) % 32);
+        stream_events[i].phase = phases[(seed >> 12) % 3];
+        stream_events[i].track = (uint8_t)((seed >> 16) & 1);
+    }
+}
+
+static void encodeAll() {
+    PreciseTimeTraceEncoder encoder(1000000ULL);
+    size_t length = 0;
+    for (uint32_t i = 0; i < STREAM_EVENTS; i++) {
+        length += encoder.encode(stream_bytes + length, stream_events[i]);
+    }
+    stream_length = length;
+}
+
+static void decodeAll() {
+    PreciseTimeTraceDecoder decoder;
+    PreciseTimeTraceFrame frame;
+    uint64_t sum = 0;
+    size_t pos = 0;
+    for (;;) {
+        size_t used = decoder.next(stream_bytes + pos, stream_length - pos, frame);
+        if (used == 0) break;
+        pos += used;
+        sum += frame.event.timestamp;
+    }
+    stream_sink = sum;
+}
+
+/**
+ * @brief Cycles TSC moyens par événement, meilleur de 5 séries
+ */
+template <void (*Pass)()>
+static double cyclesPerEvent() {
+    double best = 1e30;
+    for (int round = 0; round < 5; round++) {
+        uint64_t start = __rdtsc();
+        Pass();
+        double cycles = (double)(__rdtsc() - start) / STREAM_EVENTS;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+static void report(const char* name, double cycles) {
+    printf("  %-40s %8.1f cycles\n", name, cycles);
+}
+#endif
+
+void run_trace_stream_benchmarks() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    printf("--- Flux binaire de traces (%d événements) ---\n", STREAM_EVENTS);
+    makeEvents();
+    report("encode() par événement", cyclesPerEvent<encodeAll>());
+    report("décodage next() par événement", cyclesPerEvent<decodeAll>());
+    double bytes = (double)stream_length / STREAM_EVENTS;
+    printf("  %-40s %8.2f octets (brut : %u)\n", "taille moyenne par événement", bytes,
+           (unsigned)sizeof(PreciseTimeTraceEvent));
+    printf("  %-40s %8.0f événements/s\n", "débit à 115200 bauds (8N1)", 11520.0 / bytes);
+    printf("\n");
+#else
+    printf("--- Flux binaire de traces : TSC indisponible sur cette architecture ---\n\n");
+#endif
+}
@@ -15,21 +15,38 @@
 
 #include <Arduino.h>
 #include <PreciseTime.h>
+#include <PreciseTimeScope.h>
+#include <PreciseTimeTrace.h>
+#include <PreciseTimeLoopProfiler.h>
+#include <PreciseTimeScheduler.h>
 
 // Périodes des différentes tâches
-#define DISPLAY_INTERVAL_MS    2000    // Affichage toutes les 2 secondes
-#define LED_BLINK_INTERVAL_MS  500     // LED toutes les 500ms
-#define TASK_INTERVAL_MS       100     // Tâche périodique toutes les 100ms
+#define DISPLAY_INTERVAL_US    2000000 // Affichage toutes les 2 secondes
+#define LED_BLINK_INTERVAL_US  500000  // LED toutes les 500ms
+#define TASK_INTERVAL_US       100000  // Tâche périodique toutes les 100ms
+#define LOOP_BUDGET_US         5000    // Durée tolérée d'une itération de loop()
+
+// Identifiants des événements de trace (commande 'j')
+enum TraceId {
+    TRACE_TASK = 1,
+    TRACE_BLINK = 2
+};
 
 // Variables d'état
 bool ledState = false;
 int taskCounter = 0;
+PreciseTimeLoopProfiler<> loopProfiler(LOOP_BUDGET_US);
+PreciseScheduler scheduler;
 
 /**
  * @brief Mesure le temps d'exécution d'une tâche
  */
 void measureTaskExecution() {
+#if defined(PRECISE_TIME_HAS_CHRONO)
+    PreciseTime::clock::time_point startTime = PreciseTime::clock::now();
+#else
     uint64_t startTime = PreciseTime::getMicroseconds();
+#endif
     
     // Simuler une tâche qui prend du temps
     volatile long result = 0;
@@ -38,14 +55,21 @@ void measureTaskExecution() {
         delayMicroseconds(5);
     }
     
-    uint64_t endTime = PreciseTime::getMicroseconds();
-    uint64_t duration = endTime - startTime;
+#if defined(PRECISE_TIME_HAS_CHRONO)
+    // Durée dans le tick natif du backend, convertie par std::chrono
+    PreciseTime::clock::duration elapsed = PreciseTime::clock::now() - startTime;
+    long long duration = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    double duration_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+#else
+    long long duration = (long long)(PreciseTime::getMicroseconds() - startTime);
+    double duration_ms = duration / 1000.0;
+#endif
     
     // Afficher occasionnellement la durée
     taskCounter++;
     if (taskCounter % 10 == 0) {
-        Serial.printf("[Tâche %d] Exécutée en %llu µs (%.3f ms)\n", 
-                     taskCounter, duration, duration / 1000.0);
+        Serial.printf("[Tâche %d] Exécutée en %lld µs (%.3f ms)\n", 
+                     taskCounter, duration, duration_ms);
     }
 }
 
@@ -53,10 +77,15 @@ void measureTaskExecution() {
  * @brief Affiche des informations détaillées sur le temps
  */
 void displayDetailedTime() {
+    PRECISE_SCOPE("displayDetailedTime");     // statistiques : commande 'p'
     Serial.println("\n=== 🕒 INFORMATIONS TEMPS ===");
     
     // Différentes représentations du temps
-    Serial.printf("Formaté:        %s\n", PreciseTime::getFormattedString().c_str());
+    Serial.print("Formaté:        ");
+    PreciseTime::printTo(Serial);                       // sans allocation
+    Serial.print(" (");
+    PreciseTime::printTo(Serial, PRECISE_TIME_HMS_MILLIS);
+    Serial.println(")");
     Serial.printf("Microsecondes:  %llu µs\n", PreciseTime::getMicroseconds());
     Serial.printf("Millisecondes:  %llu ms\n", PreciseTime::getMilliseconds());
     Serial.printf("Secondes:       %llu s\n", PreciseTime::getSeconds());
@@ -78,6 +107,27 @@ void displayDetailedTime() {
     Serial.println("==========================\n");
 }
 
+/**
+ * @brief Tâches planifiées : échéances absolues, sans dérive
+ */
+void displayTask(void*) {
+    loopProfiler.label("displayDetailedTime");
+    displayDetailedTime();
+}
+
+void blinkTask(void*) {
+    ledState = !ledState;
+    PRECISE_TRACE_INSTANT(TRACE_BLINK, ledState);
+    digitalWrite(LED_BUILTIN, ledState);
+}
+
+void measureTask(void*) {
+    loopProfiler.label("measureTaskExecution");
+    PRECISE_TRACE_BEGIN(TRACE_TASK);
+    measureTaskExecution();
+    PRECISE_TRACE_END(TRACE_TASK);
+}
+
 void setup() {
     Serial.begin(115200);
     delay(1000);
@@ -89,6 +139,9 @@ void setup() {
     
     // Initialiser le chronométrage
     PreciseTime::begin();
+    PreciseTime::beginCoarse();
+    PreciseTimeTrace::instance().setName(TRACE_TASK, "measureTaskExecution");
+    PreciseTimeTrace::instance().setName(TRACE_BLINK, "led");
     
     // Configurer la LED
     pinMode(LED_BUILTIN, OUTPUT);
@@ -98,53 +151,60 @@ void setup() {
     Serial.println("  'r' - Réinitialiser le chronomètre");
     Serial.println("  's' - Afficher l'état du système");
     Serial.println("  't' - Exécuter un test de performance");
+    Serial.println("  'p' - Afficher le profil des portées PRECISE_SCOPE");
+    Serial.println("  'j' - Exporter la trace en JSON (Perfetto, chrome://tracing)");
+    Serial.println("  'l' - Afficher le profil de loop() (gigue, dépassements)");
     Serial.println();
     
     Serial.println("Démarrage des tâches périodiques...");
+    scheduler.every(DISPLAY_INTERVAL_US, displayTask);
+    scheduler.every(LED_BLINK_INTERVAL_US, blinkTask);
+    // La mesure peut sauter une période si loop() est bloquée, sans décaler les suivantes
+    scheduler.every(TASK_INTERVAL_US, measureTask, nullptr, PRECISE_TIME_SKIP);
 }
 
 void loop() {
-    static uint64_t lastDisplay = 0;
-    static uint64_t lastBlink = 0;
-    static uint64_t lastTask = 0;
-    uint64_t currentTime = PreciseTime::getMilliseconds();
-    
-    // 1. Affichage périodique
-    if (currentTime - lastDisplay >= DISPLAY_INTERVAL_MS) {
-        lastDisplay = currentTime;
-        displayDetailedTime();
-    }
+    loopProfiler.tick();                    // durée et gigue : commande 'l'
     
-    // 2. Clignotement LED
-    if (currentTime - lastBlink >= LED_BLINK_INTERVAL_MS) {
-        lastBlink = currentTime;
-        ledState = !ledState;
-        digitalWrite(LED_BUILTIN, ledState);
-    }
-    
-    // 3. Tâche périodique avec mesure de temps
-    if (currentTime - lastTask >= TASK_INTERVAL_MS) {
-        lastTask = currentTime;
-        measureTaskExecution();
-    }
+    // Affichage, LED et tâche mesurée
+    scheduler.run();
     
-    // 4. Gestion des commandes série
+    // Gestion des commandes série
     if (Serial.available() > 0) {
         char command = Serial.read();
         
         switch (command) {
             case 'r':
-            case 'R':
+            case 'R': {
+                uint64_t before = PreciseTime::getMicroseconds();
                 PreciseTime::reset();
+                scheduler.rebase(before, PreciseTime::getMicroseconds());
                 Serial.println("✅ Chronomètre réinitialisé");
-                lastDisplay = lastBlink = lastTask = 0;
                 break;
+            }
                 
             case 's':
             case 'S':
                 Serial.print("📊 État système: ");
                 Serial.println(PreciseTime::isInitialized() ? "Initialisé" : "Non initialisé");
                 Serial.printf("Mémoire libre: %d bytes\n", ESP.getFreeHeap());
+                Serial.printf("Horloge grossière: %lu ms\n", (unsigned long)PreciseTime::getCoarseMilliseconds());
+                break;
+                
+            case 'p':
+            case 'P':
+                PreciseTimeScopeRegistry<PreciseTime>::dump(Serial);
+                break;
+                
+            case 'j':
+            case 'J':
+                PreciseTimeTrace::instance().exportChromeJson(Serial);
+                break;
+                
+            case 'l':
+            case 'L':
+                loopProfiler.report(Serial);
+                loopProfiler.reset();
                 break;
                 
             case 't':
@@ -0,0 +1,101 @@
+/**
+ * @file main.cpp
+ * @brief Suite PRECISE_BENCHMARK des méthodes publiques de PreciseTime,
+ *        exécutée sur la cible et rapportée sur Serial
+ * @example BenchmarkSuite.ino
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ *
+ * Au démarrage, le tableau texte (médiane ± MAD en ns et en cycles).
+ * Commandes série : 't' relance en texte, 'j' en JSON (à copier pour
+ * comparer deux cartes ou deux versions), 'g' seulement les get*(),
+ * 's' l'erreur de réveil de sleepFor() contre l'attente seule
+ * (vTaskDelay() sur ESP32, delay() ailleurs).
+ */
+
+#include <Arduino.h>
+#include <PreciseTimeBenchmarkSuite.h>
+#include <PreciseTimeHistogram.h>
+
+typedef PreciseTimeBenchmarkRunner<PreciseTime> Runner;
+
+// Retards de réveil en µs, jusqu'à 100 ms
+typedef PreciseTimeLatencyHistogram<100000UL, 2> SleepErrors;
+
+static SleepErrors sleep_errors;
+
+static void printSleepErrors(const char* name, uint32_t duration_us) {
+    Serial.print(name);
+    Serial.print("(");
+    Serial.print(duration_us);
+    Serial.print(" us) p50 ");
+    Serial.print(sleep_errors.valueAtPercentile(50.0));
+    Serial.print(" us, p99 ");
+    Serial.print(sleep_errors.valueAtPercentile(99.0));
+    Serial.print(" us, max ");
+    Serial.print(sleep_errors.max());
+    Serial.println(" us");
+}
+
+static void sleepReport(uint32_t duration_us, uint32_t samples) {
+    sleep_errors.reset();
+    for (uint32_t i = 0; i < samples; i++) {
+        uint64_t deadline = PreciseTime::getMicroseconds() + duration_us;
+        PreciseTimeYield::sleep(duration_us);
+        uint64_t woke = PreciseTime::getMicroseconds();
+        sleep_errors.record(woke > deadline ? (uint32_t)(woke - deadline) : 0);
+    }
+    printSleepErrors("attente seule", duration_us);
+
+    sleep_errors.reset();
+    for (uint32_t i = 0; i < samples; i++) {
+        sleep_errors.record((uint32_t)PreciseTime::sleepFor(duration_us));
+    }
+    printSleepErrors("sleepFor     ", duration_us);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    PreciseTime::begin();
+    PreciseTime::beginCoarse();
+#if defined(ESP32) || defined(ESP8266)
+    Runner::setCpuMHz(ESP.getCpuFreqMHz());
+#endif
+
+    Serial.println("\n=== PreciseTime BenchmarkSuite ===");
+    Runner::runAll(Serial);
+    Serial.println("Commandes : t (texte), j (JSON), g (get* seulement), s (sleepFor)");
+}
+
+void loop() {
+    PreciseTime::update();
+    if (!Serial.available()) return;
+
+    switch (Serial.read()) {
+        case 't':
+            Runner::runAll(Serial);
+            break;
+        case 'j':
+            Runner::runAll(Serial, true);
+            break;
+        case 'g':
+            Runner::runAll(Serial, false, "get");
+            break;
+        case 's':
+            sleepReport(2000, 200);
+            sleepReport(10000, 100);
+            Serial.print("marge ajustee : ");
+            Serial.print(PreciseTimeSleeper<PreciseTime, PreciseTimeYield>::margin());
+            Serial.println(" us");
+            break;
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file main.cpp
+ * @brief Mesure de la charge CPU prise par le chronométrage sur ESP32
+ * @example InterruptLoadBenchmark.ino
+ * @version 1.1.0
+ * @date 2026
+ * 
+ * Copyright (C) 2025 Fo170
+ * 
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ *
+ * Compte les itérations d'une boucle de calcul pendant une fenêtre fixe
+ * de cycles CPU, avant puis après PreciseTime::begin(). L'écart donne la
+ * part du cœur volée par les interruptions du timer, puis la latence
+ * d'entrée d'une ISR de test (timer 1) derrière les sections critiques :
+ *   pio run -e esp32dev_isr -t upload       (ancien mode, ISR à 1 MHz)
+ *   pio run -e esp32dev_tickless -t upload  (compteur libre, 0 interruption)
+ */
+
+#include <Arduino.h>
+#include <PreciseTime.h>
+#include <PreciseTimeIrqLatency.h>
+
+#define WINDOW_CYCLES    (240UL * 1000000UL)   // ~1 s à 240 MHz
+#define CALLS_PER_ROUND  100000
+#define PROBE_PERIOD_US  1000
+
+PreciseTimeIrqLatency<> probeLatency("timer1");
+
+/**
+ * @brief Itérations de calcul réalisées pendant WINDOW_CYCLES cycles
+ */
+uint32_t countIterations() {
+    volatile uint32_t acc = 0;
+    uint32_t iterations = 0;
+    uint32_t start = ESP.getCycleCount();
+    while ((uint32_t)(ESP.getCycleCount() - start) < WINDOW_CYCLES) {
+        acc += iterations * 7;
+        iterations++;
+    }
+    return iterations;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+
+    Serial.println("=== Benchmark charge d'interruption PreciseTime ===");
+#if defined(PRECISE_TIME_ESP32_TICKLESS)
+    Serial.println("Mode: compteur libre (sans interruption)");
+#else
+    Serial.println("Mode: timerISR() à 1 MHz");
+#endif
+
+    uint32_t idle = countIterations();
+    PreciseTime::begin();
+    uint32_t loaded = countIterations();
+
+    double stolen = 100.0 * (double)(idle - loaded) / (double)idle;
+    Serial.printf("Itérations sans PreciseTime: %lu\n", (unsigned long)idle);
+    Serial.printf("Itérations avec PreciseTime: %lu\n", (unsigned long)loaded);
+    Serial.printf("CPU pris par le timer:       %.2f %%\n", stolen < 0 ? 0.0 : stolen);
+
+    uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < CALLS_PER_ROUND; i++) {
+        volatile uint64_t t = PreciseTime::getMicroseconds();
+        (void)t;
+    }
+    uint32_t cycles = ESP.getCycleCount() - start;
+    Serial.printf("getMicroseconds():           %.1f cycles/appel\n",
+                  (double)cycles / CALLS_PER_ROUND);
+
+    // Vérifie que le compteur suit bien le temps réel
+    uint64_t t0 = PreciseTime::getMicroseconds();
+    delay(1000);
+    uint64_t t1 = PreciseTime::getMicroseconds();
+    Serial.printf("Dérive sur 1 s:              %lld µs\n", (long long)(t1 - t0) - 1000000LL);
+
+#if defined(PRECISE_TIME_HAS_IRQ_PROBE)
+    // Retard d'entrée de l'ISR du timer 1 pendant 2 s
+    // (l'ISR ne fait qu'horodater : collect() enregistre en contexte de tâche)
+    PreciseTimeIrqProbe<>::start(probeLatency, PROBE_PERIOD_US);
+    for (int i = 0; i < 200; i++) {
+        delay(10);
+        probeLatency.collect();
+    }
+    PreciseTimeIrqProbe<>::stop();
+    Serial.print("Latence ISR: ");
+    probeLatency.report(Serial);
+#endif
+}
+
+void loop() {
+    delay(1000);
+}
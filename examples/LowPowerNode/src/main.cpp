@@ -0,0 +1,84 @@
+/**
+ * @file main.cpp
+ * @brief Nœud sur batterie : tâches périodiques et veille légère entre
+ *        deux échéances, sans delay() dans loop()
+ * @example LowPowerNode.ino
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ *
+ * Une mesure toutes les 100 ms, un rapport toutes les 10 s. Entre deux,
+ * loop() dort en veille légère jusqu'à la prochaine échéance ; le rapport
+ * montre la part du temps passée en veille, le pire retard des mesures et
+ * sur ESP32 l'écart esp_timer - PreciseTime, constant si la compensation
+ * de la veille est juste.
+ */
+
+#include <Arduino.h>
+#if defined(ESP8266)
+#include <ESP8266WiFi.h>
+#endif
+#include <PreciseTimeScheduler.h>
+#include <PreciseTimeIdle.h>
+
+PreciseScheduler scheduler;
+PreciseTimeIdle<> idle;
+
+PreciseScheduler::TaskId sampleTask = PreciseScheduler::INVALID_TASK;
+uint32_t samples = 0;
+uint32_t sampleSum = 0;
+
+void sample(void*) {
+    sampleSum += analogRead(A0);
+    samples++;
+}
+
+void report(void*) {
+    uint64_t now = PreciseTime::getMicroseconds();
+    Serial.print("t = ");
+    Serial.print((uint32_t)(now / 1000));
+    Serial.print(" ms, veille ");
+    Serial.print((uint32_t)(idle.sleptMicros() * 100 / (now ? now : 1)));
+    Serial.print(" %, mesures ");
+    Serial.print(samples);
+    Serial.print(" (moyenne ");
+    Serial.print(samples ? sampleSum / samples : 0);
+    Serial.print("), pire retard ");
+    Serial.print(scheduler.maxLateness(sampleTask));
+    Serial.print(" us, marge de reveil ");
+    Serial.print(idle.wakeMargin());
+#if defined(ESP32)
+    Serial.print(" us, esp_timer - PreciseTime ");
+    Serial.print((int32_t)(esp_timer_get_time() - (int64_t)now));
+#endif
+    Serial.println(" us");
+    // Rien ne doit rester dans l'UART au moment de la veille
+    Serial.flush();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+#if defined(ESP8266)
+    WiFi.mode(WIFI_OFF);
+#endif
+
+    PreciseTime::begin();
+    Serial.println("\n=== PreciseTime LowPowerNode ===");
+    Serial.flush();
+
+    sampleTask = scheduler.every(100000, sample);
+    scheduler.every(10000000, report);
+    idle.watch(scheduler);
+}
+
+void loop() {
+    scheduler.run();
+    idle.idle();
+}
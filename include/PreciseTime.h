@@ -25,132 +25,324 @@
 #ifndef PRECISE_TIME_H
 #define PRECISE_TIME_H
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+typedef String PreciseTimeString;
+#else
+// Compilation native (Linux, CI) : pas de couche Arduino
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+typedef std::string PreciseTimeString;
+#endif
 #include <math.h>
 
-#if defined(ESP32)
-#include "driver/timer.h"
-#include "soc/timer_group_struct.h"
-#include "soc/timer_group_reg.h"
+// <chrono> est fourni par la libstdc++ des cœurs ESP32/ESP8266 et en natif,
+// pas par les cœurs AVR : PRECISE_TIME_NO_CHRONO le désactive partout.
+#if !defined(PRECISE_TIME_NO_CHRONO) && (!defined(ARDUINO) || defined(ESP32) || defined(ESP8266))
+#define PRECISE_TIME_HAS_CHRONO
+#include <chrono>
+#endif
+
+#include "PreciseTimeDivide.h"
+#include "PreciseTimeInline.h"
+#include "PreciseTimeFormat.h"
+#include "PreciseTimeBackendEsp32.h"
+#include "PreciseTimeBackendEsp8266.h"
+#include "PreciseTimeBackendMillis.h"
+#include "PreciseTimeBackendNative.h"
+#include "PreciseTimeBackendSim.h"
+#include "PreciseTimeCoarse.h"
+#include "PreciseTimeSleep.h"
+#include "PreciseTimeLightSleep.h"
+
+/**
+ * Backend par défaut de l'alias PreciseTime. Chaque backend est une
+ * politique : begin(), now_ticks(), reset(), update() et la constante
+ * TICKS_PER_SECOND. -DPRECISE_TIME_BACKEND=<type> impose un backend.
+ */
+#if defined(PRECISE_TIME_BACKEND)
+typedef PRECISE_TIME_BACKEND PreciseTimeDefaultBackend;
+#elif defined(PRECISE_TIME_SIMULATED)
+// Horloge virtuelle : le temps n'avance que par PreciseTimeSimBackend::advance()
+typedef PreciseTimeSimBackend PreciseTimeDefaultBackend;
+#elif defined(ESP32)
+// Par défaut le timer 0 compte librement à 1 MHz et getMicroseconds()
+// lit directement son compteur 64 bits : aucune interruption.
+// Définir PRECISE_TIME_ESP32_USE_ISR pour revenir à l'ancien mode où
+// timerISR() incrémente time_fct_micros à chaque microseconde.
+#if defined(PRECISE_TIME_ESP32_USE_ISR)
+typedef PreciseTimeEsp32IsrBackend PreciseTimeDefaultBackend;
+#else
+#define PRECISE_TIME_ESP32_TICKLESS
+typedef PreciseTimeEsp32TimerBackend PreciseTimeDefaultBackend;
+#endif
+#elif defined(ESP8266)
+// PRECISE_TIME_ESP8266_CCOUNT : base de temps sur le compteur de cycles
+// CPU (12,5 ns à 80 MHz, 6,25 ns à 160 MHz) au lieu de micros() (~4 µs).
+#if defined(PRECISE_TIME_ESP8266_CCOUNT)
+typedef PreciseTimeEsp8266CcountBackend PreciseTimeDefaultBackend;
+#else
+typedef PreciseTimeEsp8266MicrosBackend PreciseTimeDefaultBackend;
 #endif
+#elif defined(ARDUINO)
+typedef PreciseTimeMillisBackend PreciseTimeDefaultBackend;
+#else
+// PRECISE_TIME_NATIVE_TSC : lit le TSC (RDTSCP) calibré à begin() au lieu
+// d'appeler clock_gettime() ; repli automatique sans TSC invariant.
+#if defined(PRECISE_TIME_NATIVE_TSC)
+typedef PreciseTimeTscBackend PreciseTimeDefaultBackend;
+#else
+typedef PreciseTimeNativeBackend PreciseTimeDefaultBackend;
+#endif
+#endif
+
+/**
+ * @brief Conversion de ticks entre deux fréquences connues à la compilation
+ *
+ * La spécialisation est choisie sur les constantes : identité, une
+ * multiplication, ou une division par constante faite en
+ * multiplication-décalage (PreciseTimeDivide). Aucune division à
+ * l'exécution, ce qui compte sur ESP8266 où une division 64 bits est une
+ * routine logicielle de plusieurs centaines de cycles.
+ */
+template <uint64_t FROM_HZ, uint64_t TO_HZ,
+          int KIND = (FROM_HZ == TO_HZ) ? 0
+                   : (FROM_HZ % TO_HZ == 0) ? 1
+                   : (TO_HZ % FROM_HZ == 0) ? 2 : 3>
+struct PreciseTimeConvert {
+    static inline uint64_t apply(uint64_t ticks) {
+        uint64_t whole = PreciseTimeDivide<FROM_HZ>::quotient(ticks);
+        uint64_t rest = ticks - whole * FROM_HZ;
+        return whole * TO_HZ + PreciseTimeDivide<FROM_HZ>::quotient(rest * TO_HZ);
+    }
+};
+
+template <uint64_t FROM_HZ, uint64_t TO_HZ>
+struct PreciseTimeConvert<FROM_HZ, TO_HZ, 0> {
+    static inline uint64_t apply(uint64_t ticks) { return ticks; }
+};
 
-class PreciseTime {
+template <uint64_t FROM_HZ, uint64_t TO_HZ>
+struct PreciseTimeConvert<FROM_HZ, TO_HZ, 1> {
+    static inline uint64_t apply(uint64_t ticks) {
+        return PreciseTimeDivide<FROM_HZ / TO_HZ>::quotient(ticks);
+    }
+};
+
+template <uint64_t FROM_HZ, uint64_t TO_HZ>
+struct PreciseTimeConvert<FROM_HZ, TO_HZ, 2> {
+    static inline uint64_t apply(uint64_t ticks) { return ticks * (TO_HZ / FROM_HZ); }
+};
+
+template <class Backend>
+class PreciseTimeT {
 private:
     static bool initialized;
-    
-#if defined(ESP32)
-    static hw_timer_t* timer;
-    static volatile uint64_t time_fct_micros;
-    static portMUX_TYPE timerMux;
-
-    // Declare ISR here, implement in PreciseTime.cpp to avoid
-    // emitting the ISR inline into every translation unit.
-    static void IRAM_ATTR timerISR();
-    
-#elif defined(ESP8266)
-    static volatile uint32_t overflow_counter;
-    static uint32_t last_micros;
-    static uint64_t total_micros;
 
-    static void IRAM_ATTR microsOverflowISR();
-    static void updateTime();
-    
-#else
-    static uint32_t last_millis;
-    static uint64_t total_millis;
+    typedef typename PreciseTimeCoarseTickerFor<Backend>::type CoarseTicker;
 
-    static void updateSoftwareTimer();
-#endif
+    static PreciseTimeCoarseCell& coarse_millis() {
+        static PreciseTimeCoarseCell cell;
+        return cell;
+    }
+
+    static void publishCoarse(void*) {
+        coarse_millis().store((PreciseTimeCoarseWord)getMilliseconds());
+    }
 
 public:
+    typedef Backend backend_type;
+    typedef typename PreciseTimeLightSleepFor<Backend>::type light_sleep_type;
+    static const uint64_t TICKS_PER_SECOND = Backend::TICKS_PER_SECOND;
+
+#if defined(PRECISE_TIME_HAS_CHRONO)
+    /**
+     * @brief Horloge std::chrono (TrivialClock) sur le tick natif du backend
+     *
+     * period vaut 1/TICKS_PER_SECOND : now() ne fait aucune conversion et
+     * duration_cast vers une unité plus fine est une multiplication par une
+     * constante. is_steady est faux car reset() ramène l'horloge à 0.
+     */
+    struct clock {
+        typedef int64_t rep;
+        typedef std::ratio<1, (intmax_t)Backend::TICKS_PER_SECOND> period;
+        typedef std::chrono::duration<rep, period> duration;
+        typedef std::chrono::time_point<clock> time_point;
+        static constexpr bool is_steady = false;
+
+        static time_point now() noexcept {
+            return time_point(duration((rep)getTicks()));
+        }
+    };
+#endif
+
     static void begin() {
         if (initialized) return;
-#if defined(ESP32)
-        timer = timerBegin(0, 80, true);
-        timerAttachInterrupt(timer, &timerISR, true);
-        timerAlarmWrite(timer, 1, true);
-        timerAlarmEnable(timer);
-#elif defined(ESP8266)
-        last_micros = micros();
-        total_micros = 0;
-        overflow_counter = 0;
-        timer1_isr_init();
-        timer1_attachInterrupt(microsOverflowISR);
-        timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
-#else
-        last_millis = millis();
-        total_millis = 0;
-#endif
+        Backend::begin();
         initialized = true;
     }
 
-    static uint64_t getMicroseconds() {
-#if defined(ESP32)
-        if (!initialized) return 0;
-        uint64_t time;
-        portENTER_CRITICAL(&timerMux);
-        time = time_fct_micros;
-        portEXIT_CRITICAL(&timerMux);
-        return time;
-#elif defined(ESP8266)
+    /**
+     * @brief Ticks natifs du backend depuis begin()/reset()
+     *
+     * Inliné de force : lisible depuis une ISR en IRAM.
+     */
+    static PRECISE_TIME_FORCE_INLINE uint64_t getTicks() {
         if (!initialized) return 0;
-        updateTime();
-        return total_micros;
-#else
-        if (!initialized) return 0;
-        updateSoftwareTimer();
-        return total_millis * 1000ULL;
-#endif
+        return Backend::now_ticks();
+    }
+
+    static uint64_t getNanoseconds() {
+        return PreciseTimeConvert<TICKS_PER_SECOND, 1000000000ULL>::apply(getTicks());
+    }
+
+    static uint64_t getMicroseconds() {
+        return PreciseTimeConvert<TICKS_PER_SECOND, 1000000ULL>::apply(getTicks());
     }
 
     static uint64_t getMilliseconds() {
-        return getMicroseconds() / 1000ULL;
+        return PreciseTimeConvert<TICKS_PER_SECOND, 1000ULL>::apply(getTicks());
     }
 
     static uint64_t getSeconds() {
-        return getMicroseconds() / 1000000ULL;
+        return PreciseTimeConvert<TICKS_PER_SECOND, 1ULL>::apply(getTicks());
     }
 
     static double getSecondsPrecise() {
-        return (double)getMicroseconds() / 1000000.0;
+        return (double)getTicks() / (double)TICKS_PER_SECOND;
+    }
+
+    // Disponible si le backend fournit cycles() (ESP8266 CCOUNT)
+    static uint64_t getCycles() {
+        return Backend::cycles();
+    }
+
+    // Disponible si le backend fournit setCpuFrequencyMHz() (ESP8266 CCOUNT)
+    static bool setCpuFrequencyMHz(uint8_t mhz) {
+        return Backend::setCpuFrequencyMHz(mhz);
     }
 
     static void getFormattedTime(uint64_t &days, uint32_t &hours, 
                                  uint32_t &minutes, uint32_t &seconds) {
         uint64_t total_seconds = getSeconds();
-        days = total_seconds / 86400ULL;
-        uint64_t remaining = total_seconds % 86400ULL;
-        hours = remaining / 3600ULL;
-        remaining %= 3600ULL;
-        minutes = remaining / 60ULL;
-        seconds = remaining % 60ULL;
-    }
-
-    static String getFormattedString() {
-        uint64_t days;
-        uint32_t hours, minutes, seconds;
-        getFormattedTime(days, hours, minutes, seconds);
-        char buffer[64];
-        if (days > 0) {
-            snprintf(buffer, sizeof(buffer), "%llu jours, %02lu:%02lu:%02lu", 
-                     days, hours, minutes, seconds);
-        } else {
-            snprintf(buffer, sizeof(buffer), "%02lu:%02lu:%02lu", 
-                     hours, minutes, seconds);
-        }
-        return String(buffer);
+        days = PreciseTimeDivide<86400ULL>::quotient(total_seconds);
+        // Moins d'une journée : la suite tient sur 32 bits
+        uint32_t remaining = (uint32_t)(total_seconds - days * 86400ULL);
+        hours = PreciseTimeDivide<3600ULL>::quotient32(remaining);
+        remaining -= hours * 3600UL;
+        minutes = PreciseTimeDivide<60ULL>::quotient32(remaining);
+        seconds = remaining - minutes * 60UL;
+    }
+
+    /**
+     * @brief "N jours, HH:MM:SS" ; alloue une chaîne à chaque appel, voir
+     *        formatTo()/printTo() pour les chemins fréquents
+     */
+    static PreciseTimeString getFormattedString() {
+        char buffer[PRECISE_TIME_FORMAT_BUFFER];
+        PreciseTimeFormatter::formatUptime(buffer, sizeof(buffer), getSeconds());
+        return PreciseTimeString(buffer);
+    }
+
+    /**
+     * @brief Écrit le temps écoulé dans `buffer`, sans allocation
+     * @return Octets écrits hors zéro final, 0 si le tampon est trop petit
+     *         (PRECISE_TIME_FORMAT_BUFFER suffit toujours)
+     */
+    static size_t formatTo(char* buffer, size_t size,
+                           PreciseTimeLayout layout = PRECISE_TIME_DAYS_HMS) {
+        return PreciseTimeFormatter::format(buffer, size, getMicroseconds(), layout);
+    }
+
+    /**
+     * @brief Écrit le temps écoulé sur `out` (Serial, fichier...), sans allocation
+     * @return Octets écrits
+     */
+    template <class Output>
+    static size_t printTo(Output& out, PreciseTimeLayout layout = PRECISE_TIME_DAYS_HMS) {
+        return PreciseTimeFormatter::print(out, getMicroseconds(), layout);
+    }
+
+    /**
+     * @brief Attend jusqu'à l'instant `deadline_us` (µs depuis begin())
+     *
+     * Rend la main (vTaskDelay() sur ESP32, delay() sur ESP8266 et Arduino,
+     * nanosleep() en natif) jusqu'à une marge avant l'échéance, puis finit
+     * en boucle active sur getMicroseconds(). La marge suit le retard
+     * observé des réveils, voir PreciseTimeSleeper.
+     * @return Retard du réveil en µs
+     */
+    static uint64_t sleepUntil(uint64_t deadline_us) {
+        return PreciseTimeSleeper<PreciseTimeT,
+                                  typename PreciseTimeYieldFor<Backend>::type>::until(deadline_us);
+    }
+
+    static uint64_t sleepFor(uint64_t duration_us) {
+        return sleepUntil(getMicroseconds() + duration_us);
+    }
+
+    /**
+     * @brief Veille légère d'environ `duration_us` µs (ESP32, ESP8266 ;
+     *        delay() sur Arduino générique, nanosleep() en natif)
+     *
+     * Le temps que le backend n'a pas compté pendant la veille, mesuré par
+     * l'horloge qui continue de tourner (RTC), est ajouté au compteur :
+     * getMicroseconds() reste continu.
+     * @return Durée de la veille en µs
+     */
+    static uint64_t lightSleep(uint64_t duration_us) {
+        uint64_t before = getMicroseconds();
+        uint64_t slept = light_sleep_type::sleep(duration_us);
+        uint64_t counted = getMicroseconds() - before;
+        if (!initialized || slept <= counted) return slept > counted ? slept : counted;
+        Backend::skip(PreciseTimeConvert<1000000ULL, TICKS_PER_SECOND>::apply(slept - counted));
+        if (CoarseTicker::running()) publishCoarse(nullptr);
+        return slept;
     }
 
     static double getOverflowYears() {
         return (pow(2, 64) / 1000000.0 / 3600.0 / 24.0 / 365.0);
     }
 
+    /**
+     * @brief Démarre l'horloge grossière : getMilliseconds() est publié
+     *        toutes les `period_ms` millisecondes
+     *
+     * Sans effet si le tick tourne déjà ; le réarme s'il a été arrêté
+     * (endCoarse(), PreciseTimeSimBackend::clear()).
+     */
+    static void beginCoarse(uint32_t period_ms = PRECISE_TIME_COARSE_PERIOD_MS) {
+        if (CoarseTicker::running()) return;
+        begin();
+        publishCoarse(nullptr);
+        CoarseTicker::start(period_ms, publishCoarse);
+    }
+
+    /**
+     * @brief Arrête le tick de l'horloge grossière ; getCoarseMilliseconds()
+     *        garde la dernière valeur publiée
+     */
+    static void endCoarse() {
+        CoarseTicker::stop();
+    }
+
+    /**
+     * @brief Millisecondes depuis begin()/reset(), en retard d'au plus une
+     *        période de publication (10 ms par défaut) ; un simple chargement, sans lecture du
+     *        matériel ni conversion (équivalent de CLOCK_MONOTONIC_COARSE)
+     *
+     * 0 tant que beginCoarse() n'a pas été appelé. Sur Arduino générique,
+     * la valeur est publiée par update().
+     */
+    static inline PreciseTimeCoarseWord getCoarseMilliseconds() {
+        return coarse_millis().load();
+    }
+
     static void update() {
-#if defined(ESP8266)
-        updateTime();
-#elif !defined(ESP32)
-        updateSoftwareTimer();
-#endif
+        if (!initialized) return;
+        Backend::update();
+        if (CoarseTicker::running()) publishCoarse(nullptr);
     }
 
     static bool isInitialized() {
@@ -158,72 +350,24 @@ public:
     }
 
     static void reset() {
-#if defined(ESP32)
-        portENTER_CRITICAL(&timerMux);
-        time_fct_micros = 0;
-        portEXIT_CRITICAL(&timerMux);
-#elif defined(ESP8266)
-        last_micros = micros();
-        total_micros = 0;
-        overflow_counter = 0;
-#else
-        last_millis = millis();
-        total_millis = 0;
-#endif
+        if (!initialized) return;
+        Backend::reset();
+        if (CoarseTicker::running()) publishCoarse(nullptr);
     }
 };
 
 // Static variable definitions
-bool PreciseTime::initialized = false;
-
-#if defined(ESP32)
-hw_timer_t* PreciseTime::timer = nullptr;
-volatile uint64_t PreciseTime::time_fct_micros = 0;
-portMUX_TYPE PreciseTime::timerMux = portMUX_INITIALIZER_UNLOCKED;
-
-void IRAM_ATTR PreciseTime::timerISR() {
-    portENTER_CRITICAL_ISR(&timerMux);
-    time_fct_micros++;
-    portEXIT_CRITICAL_ISR(&timerMux);
-}
-
-#elif defined(ESP8266)
-volatile uint32_t PreciseTime::overflow_counter = 0;
-uint32_t PreciseTime::last_micros = 0;
-uint64_t PreciseTime::total_micros = 0;
+template <class Backend>
+bool PreciseTimeT<Backend>::initialized = false;
 
-void IRAM_ATTR PreciseTime::microsOverflowISR() {
-    overflow_counter++;
-}
-
-void PreciseTime::updateTime() {
-    if (!initialized) return;
-    uint32_t current_micros = micros();
-    uint32_t high_part = overflow_counter;
-    if (current_micros < last_micros) {
-        high_part++;
-    }
-    total_micros = ((uint64_t)high_part << 32) | current_micros;
-    last_micros = current_micros;
-}
-
-#else
-uint32_t PreciseTime::last_millis = 0;
-uint64_t PreciseTime::total_millis = 0;
-
-void PreciseTime::updateSoftwareTimer() {
-    if (!initialized) return;
-    uint32_t current = millis();
-    uint32_t delta;
-    if (current >= last_millis) {
-        delta = current - last_millis;
-    } else {
-        delta = (UINT32_MAX - last_millis) + current + 1;
-    }
-    total_millis += delta;
-    last_millis = current;
-}
+template <class Backend>
+const uint64_t PreciseTimeT<Backend>::TICKS_PER_SECOND;
 
+#if defined(PRECISE_TIME_HAS_CHRONO)
+template <class Backend>
+constexpr bool PreciseTimeT<Backend>::clock::is_steady;
 #endif
 
+typedef PreciseTimeT<PreciseTimeDefaultBackend> PreciseTime;
+
 #endif // PRECISE_TIME_H
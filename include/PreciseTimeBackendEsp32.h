@@ -0,0 +1,144 @@
+/**
+ * @file PreciseTimeBackendEsp32.h
+ * @brief Backends ESP32 : timer 0 en compteur libre ou incrémenté par ISR
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BACKEND_ESP32_H
+#define PRECISE_TIME_BACKEND_ESP32_H
+
+#if defined(ESP32)
+#include <Arduino.h>
+#include "driver/timer.h"
+#include "soc/timer_group_struct.h"
+#include "soc/timer_group_reg.h"
+#include "PreciseTimeTimerGroup.h"
+#include "PreciseTimeSeqlock.h"
+
+/**
+ * @brief Timer 0 à 1 MHz en compteur libre, lu directement : aucune interruption
+ *
+ * reset() recharge le compteur matériel à 0 : pas d'origine à soustraire.
+ * Le temps de veille légère, pendant laquelle le compteur est arrêté,
+ * s'ajoute par skip_micros à la lecture ; le compteur matériel n'est
+ * jamais réécrit en marche, ce qui perdrait les ticks écoulés entre la
+ * lecture et l'écriture.
+ */
+struct PreciseTimeEsp32TimerBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000ULL;
+
+    typedef PreciseTimeTimerGroup<PreciseTimeTimerGroup0Regs> hardwareCounter;
+
+    static hw_timer_t*& timer() {
+        static hw_timer_t* instance = nullptr;
+        return instance;
+    }
+
+    // Lu depuis les ISR : inliné de force, initialisé statiquement
+    static PRECISE_TIME_FORCE_INLINE PreciseTimeSeqlock64& skip_micros() {
+        static PreciseTimeSeqlock64 skipped;
+        return skipped;
+    }
+
+    static void begin() {
+        timer() = timerBegin(0, 80, true);
+        reset();
+    }
+
+    static PRECISE_TIME_FORCE_INLINE uint64_t now_ticks() {
+        return hardwareCounter::read() + skip_micros().load();
+    }
+
+    static void reset() {
+        hardwareCounter::write(0);
+        skip_micros().store(0);
+    }
+
+    static void update() {
+    }
+
+    // Ajoute `ticks` au temps lu : le compteur est arrêté pendant la veille
+    // légère (APB coupé)
+    static void skip(uint64_t ticks) {
+        skip_micros().store(skip_micros().load() + ticks);
+    }
+};
+
+/**
+ * @brief Ancien mode : timerISR() incrémente time_fct_micros à 1 MHz
+ *
+ * time_fct_micros est lu sans verrou ; timerMux ne sert qu'à sérialiser
+ * les écrivains (timerISR() et reset()).
+ */
+struct PreciseTimeEsp32IsrBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000ULL;
+
+    static hw_timer_t*& timer() {
+        static hw_timer_t* instance = nullptr;
+        return instance;
+    }
+
+    // Appelés depuis timerISR() : inlinés de force, et initialisés
+    // statiquement (constructeurs constexpr, pas de garde d'initialisation)
+    static PRECISE_TIME_FORCE_INLINE PreciseTimeSeqlock64& time_fct_micros() {
+        static PreciseTimeSeqlock64 counter;
+        return counter;
+    }
+
+    static PRECISE_TIME_FORCE_INLINE portMUX_TYPE& timerMux() {
+        static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+        return mux;
+    }
+
+    // Défini une seule fois dans src/PreciseTime.cpp : une ISR inline
+    // serait émise dans chaque unité de traduction
+    static void IRAM_ATTR timerISR();
+
+    static void begin() {
+        timer() = timerBegin(0, 80, true);
+        timerAttachInterrupt(timer(), &timerISR, true);
+        timerAlarmWrite(timer(), 1, true);
+        timerAlarmEnable(timer());
+    }
+
+    static PRECISE_TIME_FORCE_INLINE uint64_t now_ticks() {
+        return time_fct_micros().load();
+    }
+
+    static void reset() {
+        portENTER_CRITICAL(&timerMux());
+        time_fct_micros().store(0);
+        portEXIT_CRITICAL(&timerMux());
+    }
+
+    static void update() {
+    }
+
+    // Ajoute `ticks` au compteur : timerISR() ne tourne pas en veille légère
+    static void skip(uint64_t ticks) {
+        portENTER_CRITICAL(&timerMux());
+        time_fct_micros().store(time_fct_micros().load() + ticks);
+        portEXIT_CRITICAL(&timerMux());
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_BACKEND_ESP32_H
@@ -0,0 +1,159 @@
+/**
+ * @file PreciseTimeBackendEsp8266.h
+ * @brief Backends ESP8266 : micros() ou compteur de cycles CPU, sans interruption
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BACKEND_ESP8266_H
+#define PRECISE_TIME_BACKEND_ESP8266_H
+
+#if defined(ESP8266)
+#include <Arduino.h>
+extern "C" {
+#include "osapi.h"
+#include "user_interface.h"
+}
+#include "PreciseTimeWrapExtender.h"
+#include "PreciseTimeSeqlock.h"
+#include "PreciseTimeCycleClock.h"
+
+/**
+ * @brief micros() étendu à 63 bits par ses seuls débordements
+ *
+ * Pas de timer1, pas d'interruption. epoch_micros est l'origine fixée par
+ * begin()/reset(). Un os_timer (contexte tâche) toutes les 15 minutes
+ * garantit une lecture par demi-période de micros() (~35 min) même si
+ * l'application ne lit jamais le temps.
+ */
+struct PreciseTimeEsp8266MicrosBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000ULL;
+
+    static PreciseTimeWrapExtender& micros_extender() {
+        static PreciseTimeWrapExtender extender;
+        return extender;
+    }
+
+    static PreciseTimeSeqlock64& epoch_micros() {
+        static PreciseTimeSeqlock64 epoch;
+        return epoch;
+    }
+
+    static os_timer_t& keepalive_timer() {
+        static os_timer_t instance;
+        return instance;
+    }
+
+    static uint64_t extendedMicros() { return micros_extender().read(micros); }
+    static void keepAlive(void*) { extendedMicros(); }
+
+    static void begin() {
+        epoch_micros().store(extendedMicros());
+        os_timer_setfn(&keepalive_timer(), keepAlive, nullptr);
+        os_timer_arm(&keepalive_timer(), 15UL * 60UL * 1000UL, true);
+    }
+
+    static inline uint64_t now_ticks() {
+        return extendedMicros() - epoch_micros().load();
+    }
+
+    static void reset() {
+        epoch_micros().store(extendedMicros());
+    }
+
+    static void update() {
+        extendedMicros();
+    }
+
+    // Recule l'origine de `ticks` : micros() ne compte pas en veille légère
+    static void skip(uint64_t ticks) {
+        epoch_micros().store(epoch_micros().load() - ticks);
+    }
+};
+
+/**
+ * @brief Compteur de cycles CPU (CCOUNT) converti en nanosecondes
+ *
+ * 12,5 ns à 80 MHz, 6,25 ns à 160 MHz. CCOUNT déborde toutes les 26,8 s à
+ * 160 MHz : l'os_timer de maintien tourne donc toutes les 5 secondes.
+ */
+struct PreciseTimeEsp8266CcountBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000000ULL;
+
+    static PreciseTimeCycleClock<PreciseTimeEsp8266Cpu>& cycle_clock() {
+        static PreciseTimeCycleClock<PreciseTimeEsp8266Cpu> clock;
+        return clock;
+    }
+
+    static PreciseTimeSeqlock64& epoch_nanos() {
+        static PreciseTimeSeqlock64 epoch;
+        return epoch;
+    }
+
+    static os_timer_t& keepalive_timer() {
+        static os_timer_t instance;
+        return instance;
+    }
+
+    static void keepAlive(void*) { cycle_clock().nanoseconds(); }
+
+    static void begin() {
+        cycle_clock().begin();
+        epoch_nanos().store(0);
+        os_timer_setfn(&keepalive_timer(), keepAlive, nullptr);
+        os_timer_arm(&keepalive_timer(), 5UL * 1000UL, true);
+    }
+
+    static inline uint64_t now_ticks() {
+        return cycle_clock().nanoseconds() - epoch_nanos().load();
+    }
+
+    static void reset() {
+        epoch_nanos().store(cycle_clock().nanoseconds());
+    }
+
+    static void update() {
+        cycle_clock().nanoseconds();
+    }
+
+    // Recule l'origine de `ticks` : CCOUNT est arrêté en veille légère
+    // (arithmétique modulo 2^64, l'origine peut passer sous 0)
+    static void skip(uint64_t ticks) {
+        epoch_nanos().store(epoch_nanos().load() - ticks);
+    }
+
+    // Cycles CPU depuis le démarrage (non remis à zéro par reset())
+    static uint64_t cycles() {
+        return cycle_clock().cycles();
+    }
+
+    // Change la fréquence CPU en clôturant le segment de conversion au
+    // cycle près ; un appel direct à system_update_cpu_freq() n'est
+    // détecté qu'à la lecture suivante.
+    static bool setCpuFrequencyMHz(uint8_t mhz) {
+        cycle_clock().nanoseconds();
+        bool ok = system_update_cpu_freq(mhz);
+        cycle_clock().nanoseconds();
+        return ok;
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_BACKEND_ESP8266_H
@@ -0,0 +1,82 @@
+/**
+ * @file PreciseTimeBackendMillis.h
+ * @brief Backend Arduino générique basé sur millis() (résolution 1 ms)
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BACKEND_MILLIS_H
+#define PRECISE_TIME_BACKEND_MILLIS_H
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+
+/**
+ * @brief Cumul logiciel de millis() ; update() doit être appelé au moins
+ *        une fois par débordement de millis() (~49 jours)
+ */
+struct PreciseTimeMillisBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000ULL;
+
+    static uint32_t& last_millis() {
+        static uint32_t value = 0;
+        return value;
+    }
+
+    static uint64_t& total_millis() {
+        static uint64_t value = 0;
+        return value;
+    }
+
+    static void begin() {
+        reset();
+    }
+
+    static inline uint64_t now_ticks() {
+        update();
+        return total_millis();
+    }
+
+    static void reset() {
+        last_millis() = millis();
+        total_millis() = 0;
+    }
+
+    static void update() {
+        uint32_t current = millis();
+        uint32_t delta;
+        if (current >= last_millis()) {
+            delta = current - last_millis();
+        } else {
+            delta = (UINT32_MAX - last_millis()) + current + 1;
+        }
+        total_millis() += delta;
+        last_millis() = current;
+    }
+
+    // Ajoute `ticks` millisecondes que millis() n'a pas comptées
+    static void skip(uint64_t ticks) {
+        update();
+        total_millis() += ticks;
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_BACKEND_MILLIS_H
@@ -0,0 +1,144 @@
+/**
+ * @file PreciseTimeBackendNative.h
+ * @brief Backends natifs (Linux, CI) : clock_gettime() et TSC calibré
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BACKEND_NATIVE_H
+#define PRECISE_TIME_BACKEND_NATIVE_H
+
+#if !defined(ARDUINO)
+#include <stdint.h>
+#include <time.h>
+#include <atomic>
+#include "PreciseTimeTsc.h"
+
+// CLOCK_MONOTONIC_RAW est servi par le vDSO (pas d'appel système) et
+// n'est pas ajusté par NTP.
+#if defined(CLOCK_MONOTONIC_RAW)
+#define PRECISE_TIME_NATIVE_CLOCK  CLOCK_MONOTONIC_RAW
+#else
+#define PRECISE_TIME_NATIVE_CLOCK  CLOCK_MONOTONIC
+#endif
+
+/**
+ * @brief clock_gettime(CLOCK_MONOTONIC_RAW), nanosecondes, sans update()
+ */
+struct PreciseTimeNativeBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000000ULL;
+
+    static std::atomic<uint64_t>& epoch_nanos() {
+        static std::atomic<uint64_t> epoch(0);
+        return epoch;
+    }
+
+    static inline uint64_t monotonicNanos() {
+        struct timespec ts;
+        clock_gettime(PRECISE_TIME_NATIVE_CLOCK, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    }
+
+    static void begin() {
+        reset();
+    }
+
+    static inline uint64_t now_ticks() {
+        return monotonicNanos() - epoch_nanos().load(std::memory_order_relaxed);
+    }
+
+    static void reset() {
+        epoch_nanos().store(monotonicNanos(), std::memory_order_relaxed);
+    }
+
+    static void update() {
+    }
+
+    // Recule l'origine : CLOCK_MONOTONIC_RAW ne compte pas la suspension
+    static void skip(uint64_t ticks) {
+        epoch_nanos().fetch_sub(ticks, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief TSC (RDTSCP) calibré à begin() ; repli sur clock_gettime() sans
+ *        TSC invariant ou hors x86-64
+ */
+struct PreciseTimeTscBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000000ULL;
+
+#if defined(PRECISE_TIME_HAS_TSC)
+    static PreciseTimeTsc& tsc() {
+        static PreciseTimeTsc instance;
+        return instance;
+    }
+
+    static bool& tsc_enabled() {
+        static bool enabled = false;
+        return enabled;
+    }
+#endif
+
+    static std::atomic<uint64_t>& epoch_nanos() {
+        static std::atomic<uint64_t> epoch(0);
+        return epoch;
+    }
+
+    static inline uint64_t monotonicNanos() {
+#if defined(PRECISE_TIME_HAS_TSC)
+        if (tsc_enabled()) return tsc().nanoseconds();
+#endif
+        return PreciseTimeNativeBackend::monotonicNanos();
+    }
+
+    static void begin() {
+#if defined(PRECISE_TIME_HAS_TSC)
+        tsc_enabled() = tsc().calibrate();
+#endif
+        reset();
+    }
+
+    static inline uint64_t now_ticks() {
+        return monotonicNanos() - epoch_nanos().load(std::memory_order_relaxed);
+    }
+
+    static void reset() {
+        epoch_nanos().store(monotonicNanos(), std::memory_order_relaxed);
+    }
+
+    static void update() {
+    }
+
+    static void skip(uint64_t ticks) {
+        epoch_nanos().fetch_sub(ticks, std::memory_order_relaxed);
+    }
+
+    // Vrai si la calibration a réussi et que le TSC est lu directement
+    static bool usesTsc() {
+#if defined(PRECISE_TIME_HAS_TSC)
+        return tsc_enabled();
+#else
+        return false;
+#endif
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_BACKEND_NATIVE_H
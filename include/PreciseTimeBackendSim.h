@@ -0,0 +1,218 @@
+/**
+ * @file PreciseTimeBackendSim.h
+ * @brief Backend d'horloge virtuelle déterministe pour simulation et tests
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BACKEND_SIM_H
+#define PRECISE_TIME_BACKEND_SIM_H
+
+#include <stdint.h>
+
+#ifndef PRECISE_TIME_SIM_MAX_TIMERS
+#define PRECISE_TIME_SIM_MAX_TIMERS  32
+#endif
+
+/**
+ * @brief Horloge virtuelle en microsecondes, avancée explicitement
+ *
+ * Le temps ne bouge que par advance() ou runUntil() : une semaine de
+ * fonctionnement se simule en quelques millisecondes de CPU. Les timers
+ * enregistrés par addTimer() sont déclenchés dans l'ordre de leur échéance
+ * (puis d'enregistrement) pendant le saut ; l'horloge vaut exactement
+ * l'échéance au moment du rappel, qui peut réarmer ou ajouter des timers.
+ *
+ * now() est le temps virtuel absolu ; now_ticks() (donc PreciseTime) le
+ * compte depuis begin()/reset(). Table fixe, sans allocation.
+ */
+struct PreciseTimeSimBackend {
+    static const uint64_t TICKS_PER_SECOND = 1000000ULL;
+
+    typedef void (*Callback)(void* arg);
+
+    // Générations possibles d'un emplacement sans rendre l'identifiant négatif
+    static const uint32_t GENERATIONS = (uint32_t)INT32_MAX / PRECISE_TIME_SIM_MAX_TIMERS;
+
+    struct Timer {
+        uint64_t deadline;
+        uint32_t sequence;
+        uint32_t generation;
+        Callback callback;
+        void* arg;
+        bool active;
+    };
+
+    struct State {
+        uint64_t now;
+        uint64_t epoch;
+        uint32_t next_sequence;
+        Timer timers[PRECISE_TIME_SIM_MAX_TIMERS];
+    };
+
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    static void begin() {
+        reset();
+    }
+
+    static inline uint64_t now_ticks() {
+        return state().now - state().epoch;
+    }
+
+    static void reset() {
+        state().epoch = state().now;
+    }
+
+    static void update() {
+    }
+
+    // Temps pendant lequel le compteur était figé : le temps virtuel avance
+    // et les timers échus sont déclenchés
+    static void skip(uint64_t ticks) {
+        advance(ticks);
+    }
+
+    static uint64_t now() {
+        return state().now;
+    }
+
+    /**
+     * @brief Enregistre un rappel à l'instant virtuel absolu `deadline`
+     * @return Identifiant pour cancelTimer() (génération ×
+     *         PRECISE_TIME_SIM_MAX_TIMERS + emplacement), -1 si la table est
+     *         pleine
+     */
+    static int addTimer(uint64_t deadline, Callback callback, void* arg = nullptr) {
+        State& s = state();
+        for (int i = 0; i < PRECISE_TIME_SIM_MAX_TIMERS; i++) {
+            Timer& timer = s.timers[i];
+            if (!timer.active) {
+                timer.deadline = deadline;
+                timer.sequence = s.next_sequence++;
+                timer.callback = callback;
+                timer.arg = arg;
+                timer.generation = timer.generation + 1 < GENERATIONS ? timer.generation + 1 : 0;
+                timer.active = true;
+                return (int)(timer.generation * PRECISE_TIME_SIM_MAX_TIMERS + i);
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Annule le timer `id` s'il n'a pas encore été déclenché
+     * @return false si `id` est périmé : timer déclenché, annulé, ou
+     *         emplacement réutilisé depuis
+     */
+    static bool cancelTimer(int id) {
+        Timer* timer = pending(id);
+        if (timer == nullptr) return false;
+        timer->active = false;
+        return true;
+    }
+
+    /**
+     * @brief Vrai si le timer `id` attend encore son échéance
+     */
+    static bool isPending(int id) {
+        return pending(id) != nullptr;
+    }
+
+    /**
+     * @brief Prochaine échéance enregistrée, UINT64_MAX s'il n'y en a pas
+     */
+    static uint64_t nextDeadline() {
+        int index = earliest(UINT64_MAX);
+        return index < 0 ? UINT64_MAX : state().timers[index].deadline;
+    }
+
+    /**
+     * @brief Avance jusqu'à l'instant absolu `target` en déclenchant les
+     *        timers échus ; sans effet si `target` est dans le passé
+     * @return Nombre de rappels exécutés
+     */
+    static uint32_t runUntil(uint64_t target) {
+        State& s = state();
+        uint32_t fired = 0;
+        for (;;) {
+            int index = earliest(target);
+            if (index < 0) break;
+            Timer& timer = s.timers[index];
+            if (timer.deadline > s.now) s.now = timer.deadline;
+            timer.active = false;
+            timer.callback(timer.arg);
+            fired++;
+        }
+        if (target > s.now) s.now = target;
+        return fired;
+    }
+
+    static uint32_t advance(uint64_t micros) {
+        return runUntil(state().now + micros);
+    }
+
+    /**
+     * @brief Remet l'horloge à 0 et vide la table (entre deux tests)
+     *
+     * Les générations des emplacements sont conservées : un identifiant
+     * antérieur reste périmé.
+     */
+    static void clear() {
+        State& s = state();
+        s.now = 0;
+        s.epoch = 0;
+        s.next_sequence = 0;
+        for (int i = 0; i < PRECISE_TIME_SIM_MAX_TIMERS; i++) {
+            s.timers[i].active = false;
+        }
+    }
+
+private:
+    // Timer désigné par `id` s'il n'est ni déclenché, ni annulé, ni remplacé
+    static Timer* pending(int id) {
+        if (id < 0) return nullptr;
+        Timer& timer = state().timers[(uint32_t)id % PRECISE_TIME_SIM_MAX_TIMERS];
+        if (!timer.active || timer.generation != (uint32_t)id / PRECISE_TIME_SIM_MAX_TIMERS) {
+            return nullptr;
+        }
+        return &timer;
+    }
+
+    static int earliest(uint64_t limit) {
+        State& s = state();
+        int best = -1;
+        for (int i = 0; i < PRECISE_TIME_SIM_MAX_TIMERS; i++) {
+            const Timer& timer = s.timers[i];
+            if (!timer.active || timer.deadline > limit) continue;
+            if (best < 0 || timer.deadline < s.timers[best].deadline
+                || (timer.deadline == s.timers[best].deadline
+                    && timer.sequence < s.timers[best].sequence)) {
+                best = i;
+            }
+        }
+        return best;
+    }
+};
+
+#endif // PRECISE_TIME_BACKEND_SIM_H
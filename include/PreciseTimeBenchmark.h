@@ -0,0 +1,503 @@
+/**
+ * @file PreciseTimeBenchmark.h
+ * @brief Micro-benchmarks PRECISE_BENCHMARK() chronométrés par PreciseTime :
+ *        calibrage du nombre d'itérations, chauffe, soustraction du coût de
+ *        mesure, rejet des valeurs aberrantes, médiane et MAD
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BENCHMARK_H
+#define PRECISE_TIME_BENCHMARK_H
+
+#include "PreciseTime.h"
+
+// Nombre maximal de benchmarks enregistrés par horloge
+#ifndef PRECISE_TIME_BENCHMARK_MAX
+#define PRECISE_TIME_BENCHMARK_MAX  64
+#endif
+
+// Échantillons mesurés par benchmark (après la chauffe)
+#ifndef PRECISE_TIME_BENCHMARK_SAMPLES
+#define PRECISE_TIME_BENCHMARK_SAMPLES  15
+#endif
+
+// Échantillons de chauffe, ignorés
+#ifndef PRECISE_TIME_BENCHMARK_WARMUP
+#define PRECISE_TIME_BENCHMARK_WARMUP  2
+#endif
+
+// Durée visée d'un échantillon, en microsecondes
+#ifndef PRECISE_TIME_BENCHMARK_SAMPLE_US
+#define PRECISE_TIME_BENCHMARK_SAMPLE_US  2000
+#endif
+
+// Plafond d'itérations par échantillon
+#ifndef PRECISE_TIME_BENCHMARK_MAX_ITERATIONS
+#define PRECISE_TIME_BENCHMARK_MAX_ITERATIONS  (1UL << 24)
+#endif
+
+/**
+ * @brief Empêche le compilateur d'éliminer le calcul de `value`
+ */
+template <class T>
+inline void preciseBenchmarkKeep(const T& value) {
+    __asm__ __volatile__("" : : "r"(&value) : "memory");
+}
+
+/**
+ * @brief Rend `value` (entier ou pointeur) opaque pour le compilateur : le
+ *        corps qui l'utilise ne peut plus être évalué à la compilation
+ */
+template <class T>
+inline T preciseBenchmarkOpaque(T value) {
+    __asm__ __volatile__("" : "+r"(value));
+    return value;
+}
+
+/**
+ * @brief Barrière de compilation entre deux itérations
+ */
+inline void preciseBenchmarkBarrier() {
+    __asm__ __volatile__("" : : : "memory");
+}
+
+/**
+ * @brief Résultat d'un benchmark, durées en nanosecondes par itération
+ */
+struct PreciseTimeBenchmarkResult {
+    const char* name;
+    uint32_t iterations;    ///< Itérations par échantillon (après calibrage)
+    uint16_t samples;       ///< Échantillons mesurés
+    uint16_t kept;          ///< Échantillons conservés après rejet
+    double median_ns;       ///< Médiane, coût de mesure soustrait
+    double mad_ns;          ///< Écart absolu médian des échantillons conservés
+    double min_ns;          ///< Plus petit échantillon conservé
+    double overhead_ns;     ///< Coût de la boucle et des lectures d'horloge soustrait
+    double resolution_ns;   ///< Plus petite durée distinguable du coût de mesure
+    bool below_resolution;  ///< Médiane sous resolution_ns : rien de mesurable
+};
+
+template <class Clock> class PreciseTimeBenchmarkRegistry;
+
+/**
+ * @brief Benchmark enregistré : nom et boucle chronométrée
+ */
+template <class Clock>
+struct PreciseTimeBenchmarkCase {
+    typedef uint64_t (*Measure)(uint32_t iterations);
+
+    const char* name;
+    Measure measure;
+
+    PreciseTimeBenchmarkCase(const char* case_name, Measure loop)
+        : name(case_name), measure(loop) {
+        PreciseTimeBenchmarkRegistry<Clock>::add(this);
+    }
+};
+
+/**
+ * @brief Table fixe des benchmarks d'une horloge, remplie à l'initialisation
+ *        statique
+ */
+template <class Clock>
+class PreciseTimeBenchmarkRegistry {
+private:
+    typedef PreciseTimeBenchmarkCase<Clock> Case;
+
+    static Case** table() {
+        static Case* cases[PRECISE_TIME_BENCHMARK_MAX];
+        return cases;
+    }
+
+    static uint32_t& next_slot() {
+        static uint32_t slot = 0;
+        return slot;
+    }
+
+public:
+    static void add(Case* entry) {
+        uint32_t slot = next_slot()++;
+        if (slot < PRECISE_TIME_BENCHMARK_MAX) table()[slot] = entry;
+    }
+
+    static uint32_t size() {
+        uint32_t used = next_slot();
+        return used < PRECISE_TIME_BENCHMARK_MAX ? used : PRECISE_TIME_BENCHMARK_MAX;
+    }
+
+    static uint32_t dropped() {
+        uint32_t used = next_slot();
+        return used > PRECISE_TIME_BENCHMARK_MAX ? used - PRECISE_TIME_BENCHMARK_MAX : 0;
+    }
+
+    static const Case& at(uint32_t index) {
+        return *table()[index];
+    }
+};
+
+/**
+ * @brief Exécution et rapport des benchmarks chronométrés par Clock
+ *
+ * Pour chaque benchmark : le nombre d'itérations par échantillon double
+ * (ou plus) jusqu'à ce qu'un échantillon dure PRECISE_TIME_BENCHMARK_SAMPLE_US ;
+ * PRECISE_TIME_BENCHMARK_WARMUP échantillons de chauffe sont jetés ; chacun
+ * des PRECISE_TIME_BENCHMARK_SAMPLES échantillons est suivi de la même
+ * boucle à corps vide, dont la médiane (boucle, barrière, deux lectures
+ * d'horloge) est soustraite. Les échantillons à plus de 3 MAD normalisés
+ * (3 × 1,4826 × MAD) de la médiane sont rejetés, puis médiane et MAD sont
+ * recalculées sur ceux qui restent. Les durées nettes gardent leur signe :
+ * les ramener à 0 fausserait médiane et MAD. Une médiane inférieure à la
+ * résolution (un tick d'horloge, ou 3 MAD normalisés de la boucle vide, par
+ * itération) est rapportée « sous la résolution » plutôt qu'en chiffres.
+ */
+template <class Clock>
+class PreciseTimeBenchmarkRunner {
+public:
+    typedef PreciseTimeBenchmarkCase<Clock> Case;
+    typedef PreciseTimeBenchmarkRegistry<Clock> Registry;
+
+private:
+    static double& cpu_mhz() {
+        static double value = 0.0;
+        return value;
+    }
+
+    static void emptyBody() {}
+
+    static double ticksToNanos(double ticks) {
+        return ticks * 1e9 / (double)Clock::TICKS_PER_SECOND;
+    }
+
+    static void sort(double* values, uint16_t count) {
+        for (uint16_t i = 1; i < count; i++) {
+            double value = values[i];
+            uint16_t j = i;
+            while (j > 0 && values[j - 1] > value) {
+                values[j] = values[j - 1];
+                j--;
+            }
+            values[j] = value;
+        }
+    }
+
+    // Médiane de `count` valeurs triées
+    static double sortedMedian(const double* values, uint16_t count) {
+        if (count == 0) return 0.0;
+        return (count & 1) ? values[count / 2]
+                           : (values[count / 2 - 1] + values[count / 2]) / 2.0;
+    }
+
+    static double medianAbsoluteDeviation(const double* sorted, uint16_t count, double median) {
+        double deviations[PRECISE_TIME_BENCHMARK_SAMPLES];
+        for (uint16_t i = 0; i < count; i++) {
+            deviations[i] = sorted[i] > median ? sorted[i] - median : median - sorted[i];
+        }
+        sort(deviations, count);
+        return sortedMedian(deviations, count);
+    }
+
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+    // Nombre décimal à `decimals` chiffres après la virgule
+    static size_t appendFixed(char* out, double value, unsigned decimals) {
+        size_t length = 0;
+        if (value < 0) {
+            out[length++] = '-';
+            value = -value;
+        }
+        uint32_t scale = 1;
+        for (unsigned i = 0; i < decimals; i++) scale *= 10;
+        uint64_t scaled = (uint64_t)(value * scale + 0.5);
+        length += PreciseTimeFormatter::appendUnsigned(out + length, scaled / scale);
+        if (decimals > 0) {
+            out[length++] = '.';
+            length += PreciseTimeFormatter::appendPadded(out + length, (uint32_t)(scaled % scale), decimals);
+        }
+        return length;
+    }
+
+    // `text` aligné à droite sur `width` caractères
+    static size_t appendRight(char* out, const char* text, size_t text_length, size_t width) {
+        size_t length = 0;
+        while (length + text_length < width) out[length++] = ' ';
+        for (size_t i = 0; i < text_length; i++) out[length++] = text[i];
+        return length;
+    }
+
+    static size_t appendFixedRight(char* out, double value, unsigned decimals, size_t width) {
+        char number[32];
+        return appendRight(out, number, appendFixed(number, value, decimals), width);
+    }
+
+    static bool matches(const char* name, const char* filter) {
+        if (filter == nullptr || *filter == '\0') return true;
+        for (; *name != '\0'; name++) {
+            const char* a = name;
+            const char* b = filter;
+            while (*a != '\0' && *a == *b) { a++; b++; }
+            if (*b == '\0') return true;
+        }
+        return false;
+    }
+
+public:
+    /**
+     * @brief Boucle chronométrée de `Body`, en ticks de Clock
+     */
+    template <void (*Body)()>
+    static uint64_t measure(uint32_t iterations) {
+        uint64_t start = Clock::getTicks();
+        for (uint32_t i = 0; i < iterations; i++) {
+            Body();
+            preciseBenchmarkBarrier();
+        }
+        return Clock::getTicks() - start;
+    }
+
+    /**
+     * @brief Fréquence CPU pour la colonne « cycles » (0 : non affichée)
+     */
+    static void setCpuMHz(double mhz) {
+        cpu_mhz() = mhz;
+    }
+
+    static double cpuMHz() {
+        return cpu_mhz();
+    }
+
+    /**
+     * @brief Médiane, MAD et minimum de `count` échantillons (ns/itération)
+     *        après rejet des valeurs aberrantes ; `values` est trié en place
+     */
+    static void summarize(double* values, uint16_t count, PreciseTimeBenchmarkResult& result) {
+        sort(values, count);
+        double median = sortedMedian(values, count);
+        double threshold = 3.0 * 1.4826 * medianAbsoluteDeviation(values, count, median);
+
+        uint16_t kept = 0;
+        for (uint16_t i = 0; i < count; i++) {
+            double deviation = values[i] > median ? values[i] - median : median - values[i];
+            if (deviation <= threshold) values[kept++] = values[i];
+        }
+        result.samples = count;
+        result.kept = kept;
+        result.median_ns = sortedMedian(values, kept);
+        result.mad_ns = medianAbsoluteDeviation(values, kept, result.median_ns);
+        result.min_ns = kept > 0 ? values[0] : 0.0;
+    }
+
+    /**
+     * @brief Exécute un benchmark
+     */
+    static PreciseTimeBenchmarkResult run(const Case& entry) {
+        PreciseTimeBenchmarkResult result;
+        result.name = entry.name;
+
+        uint64_t target = PreciseTimeConvert<1000000ULL, Clock::TICKS_PER_SECOND>::apply(
+            PRECISE_TIME_BENCHMARK_SAMPLE_US);
+        uint32_t iterations = 1;
+        for (;;) {
+            uint64_t elapsed = entry.measure(iterations);
+            if (elapsed >= target || iterations >= PRECISE_TIME_BENCHMARK_MAX_ITERATIONS) break;
+            // Vise 1,25 × la cible, en multipliant par 2 à 16
+            uint64_t next = elapsed > 0 ? iterations * (target + target / 4) / elapsed
+                                        : (uint64_t)iterations * 16;
+            if (next < (uint64_t)iterations * 2) next = (uint64_t)iterations * 2;
+            if (next > (uint64_t)iterations * 16) next = (uint64_t)iterations * 16;
+            if (next > PRECISE_TIME_BENCHMARK_MAX_ITERATIONS) next = PRECISE_TIME_BENCHMARK_MAX_ITERATIONS;
+            iterations = (uint32_t)next;
+        }
+        result.iterations = iterations;
+
+        for (int i = 0; i < PRECISE_TIME_BENCHMARK_WARMUP; i++) {
+            entry.measure(iterations);
+            measure<emptyBody>(iterations);
+        }
+
+        double body[PRECISE_TIME_BENCHMARK_SAMPLES];
+        double empty[PRECISE_TIME_BENCHMARK_SAMPLES];
+        for (uint16_t i = 0; i < PRECISE_TIME_BENCHMARK_SAMPLES; i++) {
+            body[i] = (double)entry.measure(iterations);
+            empty[i] = (double)measure<emptyBody>(iterations);
+        }
+        sort(empty, PRECISE_TIME_BENCHMARK_SAMPLES);
+        double overhead = sortedMedian(empty, PRECISE_TIME_BENCHMARK_SAMPLES);
+        double noise = 3.0 * 1.4826 * medianAbsoluteDeviation(empty, PRECISE_TIME_BENCHMARK_SAMPLES, overhead);
+        for (uint16_t i = 0; i < PRECISE_TIME_BENCHMARK_SAMPLES; i++) {
+            body[i] = ticksToNanos(body[i] - overhead) / iterations;
+        }
+        result.overhead_ns = ticksToNanos(overhead) / iterations;
+        result.resolution_ns = ticksToNanos(noise > 1.0 ? noise : 1.0) / iterations;
+        summarize(body, PRECISE_TIME_BENCHMARK_SAMPLES, result);
+        result.below_resolution = result.median_ns < result.resolution_ns;
+        return result;
+    }
+
+    /**
+     * @brief Ligne texte : nom, médiane ± MAD, cycles, itérations,
+     *        échantillons conservés ; `out` doit offrir 160 octets
+     */
+    static size_t formatText(char* out, const PreciseTimeBenchmarkResult& result) {
+        size_t length = appendText(out, "  ");
+        size_t name_length = 0;
+        for (const char* c = result.name; *c != '\0' && name_length < 48; c++, name_length++) {
+            out[length++] = *c;
+        }
+        while (name_length++ < 40) out[length++] = ' ';
+        if (result.below_resolution) {
+            char bound[32];
+            bound[0] = '<';
+            bound[1] = ' ';
+            size_t bound_length = 2 + appendFixed(bound + 2, result.resolution_ns, 2);
+            length += appendRight(out + length, bound, bound_length, 10);
+            length += appendText(out + length, " ns, sous la résolution");
+        } else {
+            length += appendFixedRight(out + length, result.median_ns, 2, 10);
+            length += appendText(out + length, " ns ± ");
+            length += appendFixedRight(out + length, result.mad_ns, 2, 6);
+        }
+        if (cpu_mhz() > 0.0 && !result.below_resolution) {
+            length += appendFixedRight(out + length, result.median_ns * cpu_mhz() / 1000.0, 1, 9);
+            length += appendText(out + length, " cycles");
+        }
+        length += appendText(out + length, "  n=");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.iterations);
+        length += appendText(out + length, " ");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.kept);
+        out[length++] = '/';
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.samples);
+        out[length++] = '\n';
+        return length;
+    }
+
+    /**
+     * @brief Objet JSON d'un résultat ; `out` doit offrir 320 octets
+     */
+    static size_t formatJson(char* out, const PreciseTimeBenchmarkResult& result) {
+        size_t length = appendText(out, "{\"name\":\"");
+        for (const char* c = result.name; *c != '\0' && length < 64; c++) {
+            if (*c == '"' || *c == '\\') out[length++] = '\\';
+            out[length++] = *c;
+        }
+        length += appendText(out + length, "\",\"iterations\":");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.iterations);
+        length += appendText(out + length, ",\"samples\":");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.samples);
+        length += appendText(out + length, ",\"kept\":");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, result.kept);
+        length += appendText(out + length, ",\"median_ns\":");
+        length += appendFixed(out + length, result.median_ns, 3);
+        length += appendText(out + length, ",\"mad_ns\":");
+        length += appendFixed(out + length, result.mad_ns, 3);
+        length += appendText(out + length, ",\"min_ns\":");
+        length += appendFixed(out + length, result.min_ns, 3);
+        length += appendText(out + length, ",\"overhead_ns\":");
+        length += appendFixed(out + length, result.overhead_ns, 3);
+        length += appendText(out + length, ",\"resolution_ns\":");
+        length += appendFixed(out + length, result.resolution_ns, 3);
+        length += appendText(out + length, ",\"below_resolution\":");
+        length += appendText(out + length, result.below_resolution ? "true" : "false");
+        if (cpu_mhz() > 0.0) {
+            length += appendText(out + length, ",\"cycles\":");
+            length += appendFixed(out + length, result.median_ns * cpu_mhz() / 1000.0, 1);
+        }
+        out[length++] = '}';
+        return length;
+    }
+
+    /**
+     * @brief Exécute les benchmarks dont le nom contient `filter` (tous si
+     *        nullptr) et écrit un tableau texte ou un document JSON
+     *
+     * `out` est un Print& ou tout objet fournissant write(const uint8_t*, size_t).
+     * @return Nombre de benchmarks exécutés
+     */
+    template <class Output>
+    static uint32_t runAll(Output& out, bool json = false, const char* filter = nullptr) {
+        char line[352];
+        size_t length;
+        if (json) {
+            length = appendText(line, "{\"clock_ticks_per_second\":");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, Clock::TICKS_PER_SECOND);
+            if (cpu_mhz() > 0.0) {
+                length += appendText(line + length, ",\"cpu_mhz\":");
+                length += appendFixed(line + length, cpu_mhz(), 3);
+            }
+            length += appendText(line + length, ",\"benchmarks\":[\n");
+        } else {
+            length = appendText(line, "--- PRECISE_BENCHMARK (médiane ± MAD par itération) ---\n");
+        }
+        out.write((const uint8_t*)line, length);
+
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < Registry::size(); i++) {
+            const Case& entry = Registry::at(i);
+            if (!matches(entry.name, filter)) continue;
+            PreciseTimeBenchmarkResult result = run(entry);
+            length = 0;
+            if (json) {
+                if (count > 0) line[length++] = ',';
+                length += formatJson(line + length, result);
+                line[length++] = '\n';
+            } else {
+                length = formatText(line, result);
+            }
+            out.write((const uint8_t*)line, length);
+            count++;
+        }
+
+        length = json ? appendText(line, "]}\n") : appendText(line, "\n");
+        out.write((const uint8_t*)line, length);
+        return count;
+    }
+};
+
+#define PRECISE_BENCHMARK_CONCAT_(a, b) a##b
+#define PRECISE_BENCHMARK_CONCAT(a, b) PRECISE_BENCHMARK_CONCAT_(a, b)
+
+/**
+ * @brief Déclare un benchmark `name` (identifiant) chronométré par Clock ;
+ *        le bloc qui suit est le corps d'une itération
+ */
+#define PRECISE_BENCHMARK_CLOCK(Clock, name)                                              \
+    static void PRECISE_BENCHMARK_CONCAT(precise_benchmark_body_, name)();                \
+    static PreciseTimeBenchmarkCase<Clock> PRECISE_BENCHMARK_CONCAT(precise_benchmark_case_, name)( \
+        #name, &PreciseTimeBenchmarkRunner<Clock>::template measure<                      \
+                   &PRECISE_BENCHMARK_CONCAT(precise_benchmark_body_, name)>);            \
+    static void PRECISE_BENCHMARK_CONCAT(precise_benchmark_body_, name)()
+
+/**
+ * @brief Déclare un benchmark chronométré par PreciseTime :
+ *
+ *     PRECISE_BENCHMARK(getMicroseconds) {
+ *         preciseBenchmarkKeep(PreciseTime::getMicroseconds());
+ *     }
+ */
+#define PRECISE_BENCHMARK(name) PRECISE_BENCHMARK_CLOCK(PreciseTime, name)
+
+#endif // PRECISE_TIME_BENCHMARK_H
@@ -0,0 +1,144 @@
+/**
+ * @file PreciseTimeBenchmarkSuite.h
+ * @brief Benchmarks PRECISE_BENCHMARK() des méthodes publiques de PreciseTime
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_BENCHMARK_SUITE_H
+#define PRECISE_TIME_BENCHMARK_SUITE_H
+
+/*
+ * À inclure dans une seule unité de traduction : chaque PRECISE_BENCHMARK
+ * définit un benchmark enregistré à l'initialisation statique. Appeler
+ * PreciseTime::begin() et PreciseTime::beginCoarse() avant
+ * PreciseTimeBenchmarkRunner<PreciseTime>::runAll().
+ *
+ * reset() n'est pas mesuré : il ramène à zéro l'horloge qui chronomètre
+ * les benchmarks. begin() et beginCoarse() sont mesurés sur leur chemin
+ * « déjà démarré », le seul qui se répète.
+ */
+
+#include "PreciseTimeBenchmark.h"
+
+PRECISE_BENCHMARK(getTicks) {
+    preciseBenchmarkKeep(PreciseTime::getTicks());
+}
+
+PRECISE_BENCHMARK(getNanoseconds) {
+    preciseBenchmarkKeep(PreciseTime::getNanoseconds());
+}
+
+PRECISE_BENCHMARK(getMicroseconds) {
+    preciseBenchmarkKeep(PreciseTime::getMicroseconds());
+}
+
+PRECISE_BENCHMARK(getMilliseconds) {
+    preciseBenchmarkKeep(PreciseTime::getMilliseconds());
+}
+
+PRECISE_BENCHMARK(getSeconds) {
+    preciseBenchmarkKeep(PreciseTime::getSeconds());
+}
+
+PRECISE_BENCHMARK(getSecondsPrecise) {
+    preciseBenchmarkKeep(PreciseTime::getSecondsPrecise());
+}
+
+PRECISE_BENCHMARK(getCoarseMilliseconds) {
+    preciseBenchmarkKeep(PreciseTime::getCoarseMilliseconds());
+}
+
+#if defined(PRECISE_TIME_HAS_CHRONO)
+PRECISE_BENCHMARK(clock_now) {
+    preciseBenchmarkKeep(PreciseTime::clock::now());
+}
+#endif
+
+#if defined(PRECISE_TIME_ESP8266_CCOUNT)
+PRECISE_BENCHMARK(getCycles) {
+    preciseBenchmarkKeep(PreciseTime::getCycles());
+}
+
+// Fréquence inchangée : mesure la clôture du segment de conversion
+PRECISE_BENCHMARK(setCpuFrequencyMHz) {
+    preciseBenchmarkKeep(PreciseTime::setCpuFrequencyMHz(system_get_cpu_freq()));
+}
+#endif
+
+PRECISE_BENCHMARK(getFormattedTime) {
+    uint64_t days;
+    uint32_t hours, minutes, seconds;
+    PreciseTime::getFormattedTime(days, hours, minutes, seconds);
+    preciseBenchmarkKeep(days);
+    preciseBenchmarkKeep(seconds);
+}
+
+PRECISE_BENCHMARK(getFormattedString) {
+    PreciseTimeString text = PreciseTime::getFormattedString();
+    preciseBenchmarkKeep(text);
+}
+
+PRECISE_BENCHMARK(formatTo) {
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    preciseBenchmarkKeep(PreciseTime::formatTo(buffer, sizeof(buffer), PRECISE_TIME_HMS_MICROS));
+    preciseBenchmarkKeep(buffer);
+}
+
+/**
+ * @brief Sortie qui jette les octets, pour mesurer printTo() sans le coût
+ *        du port série
+ */
+struct PreciseTimeBenchmarkNullOutput {
+    size_t write(const uint8_t* data, size_t size) {
+        preciseBenchmarkKeep(data);
+        return size;
+    }
+};
+
+PRECISE_BENCHMARK(printTo) {
+    PreciseTimeBenchmarkNullOutput out;
+    preciseBenchmarkKeep(PreciseTime::printTo(out, PRECISE_TIME_HMS_MICROS));
+}
+
+// Constante : sans pointeur opaque, le compilateur replie l'appel et la
+// boucle ne mesure rien ; ici, le coût d'un appel non replié
+PRECISE_BENCHMARK(getOverflowYears) {
+    double (*overflow_years)() = preciseBenchmarkOpaque(&PreciseTime::getOverflowYears);
+    preciseBenchmarkKeep(overflow_years());
+}
+
+PRECISE_BENCHMARK(update) {
+    PreciseTime::update();
+}
+
+PRECISE_BENCHMARK(isInitialized) {
+    preciseBenchmarkKeep(PreciseTime::isInitialized());
+}
+
+PRECISE_BENCHMARK(begin) {
+    PreciseTime::begin();
+}
+
+PRECISE_BENCHMARK(beginCoarse) {
+    PreciseTime::beginCoarse();
+}
+
+#endif // PRECISE_TIME_BENCHMARK_SUITE_H
@@ -0,0 +1,268 @@
+/**
+ * @file PreciseTimeCoarse.h
+ * @brief Horloge grossière : millisecondes publiées par un tick lent, lues
+ *        par un simple chargement mémoire
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_COARSE_H
+#define PRECISE_TIME_COARSE_H
+
+#include <stdint.h>
+#include "PreciseTimeBackendSim.h"
+
+#if defined(ESP32)
+#include "esp_timer.h"
+#elif defined(ESP8266)
+extern "C" {
+#include "osapi.h"
+}
+#elif !defined(ARDUINO)
+#include <time.h>
+#include <thread>
+#endif
+
+#if defined(ARDUINO) && !defined(ESP32) && !defined(ESP8266)
+// Arduino générique : pas de <atomic>, la valeur n'est écrite que par
+// update() depuis loop(), dans le même contexte que les lecteurs.
+#define PRECISE_TIME_COARSE_LOOP_ONLY
+#else
+#include <atomic>
+#endif
+
+// Période de publication par défaut, en millisecondes. Comme
+// CLOCK_MONOTONIC_COARSE, un tick lent (100 Hz) : getCoarseMilliseconds()
+// a jusqu'à une période de retard.
+#ifndef PRECISE_TIME_COARSE_PERIOD_MS
+#define PRECISE_TIME_COARSE_PERIOD_MS  10
+#endif
+
+// ESP8266 : période minimale d'un os_timer sans system_timer_reinit()
+#define PRECISE_TIME_COARSE_ESP8266_MIN_PERIOD_MS  5
+
+/**
+ * Mot machine de l'horloge grossière : 64 bits sur les hôtes 64 bits,
+ * 32 bits sur ESP32/ESP8266/Arduino où un chargement 64 bits n'est pas
+ * atomique. En 32 bits, la valeur reboucle comme millis() (~49,7 jours) :
+ * comparer des différences non signées.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFUL
+typedef uint64_t PreciseTimeCoarseWord;
+#else
+typedef uint32_t PreciseTimeCoarseWord;
+#endif
+
+/**
+ * @brief Cellule contenant la dernière valeur publiée
+ */
+struct PreciseTimeCoarseCell {
+#if defined(PRECISE_TIME_COARSE_LOOP_ONLY)
+    volatile PreciseTimeCoarseWord value;
+
+    PreciseTimeCoarseWord load() const { return value; }
+    void store(PreciseTimeCoarseWord v) { value = v; }
+#else
+    std::atomic<PreciseTimeCoarseWord> value;
+
+    PreciseTimeCoarseWord load() const { return value.load(std::memory_order_relaxed); }
+    void store(PreciseTimeCoarseWord v) { value.store(v, std::memory_order_relaxed); }
+#endif
+
+    constexpr PreciseTimeCoarseCell() : value(0) {}
+};
+
+/**
+ * @brief Tick de publication de la plate-forme
+ *
+ * ESP32 : esp_timer périodique (tâche esp_timer) ; ESP8266 : os_timer,
+ * période ramenée à 5 ms au moins ; natif : thread ; Arduino générique :
+ * aucun, update() publie. Un état par `Owner` : deux horloges
+ * PreciseTimeT ne partagent pas leur tick.
+ *
+ * start() n'est appelé que tick arrêté (running() faux). stop() attend,
+ * en natif, la fin du thread : jusqu'à une période.
+ */
+template <class Owner>
+struct PreciseTimeCoarseTicker {
+    typedef void (*Callback)(void* arg);
+
+#if defined(ESP32)
+    static esp_timer_handle_t& handle() {
+        static esp_timer_handle_t instance = nullptr;
+        return instance;
+    }
+
+    static void start(uint32_t period_ms, Callback callback) {
+        esp_timer_create_args_t args = {};
+        args.callback = callback;
+        args.arg = nullptr;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "precise_coarse";
+        if (esp_timer_create(&args, &handle()) != 0) {
+            handle() = nullptr;
+            return;
+        }
+        esp_timer_start_periodic(handle(), (uint64_t)period_ms * 1000ULL);
+    }
+
+    static void stop() {
+        if (handle() == nullptr) return;
+        esp_timer_stop(handle());
+        esp_timer_delete(handle());
+        handle() = nullptr;
+    }
+
+    static bool running() { return handle() != nullptr; }
+#elif defined(ESP8266)
+    static os_timer_t& timer() {
+        static os_timer_t instance;
+        return instance;
+    }
+
+    static bool& armed() {
+        static bool value = false;
+        return value;
+    }
+
+    static void start(uint32_t period_ms, Callback callback) {
+        if (period_ms < PRECISE_TIME_COARSE_ESP8266_MIN_PERIOD_MS) {
+            period_ms = PRECISE_TIME_COARSE_ESP8266_MIN_PERIOD_MS;
+        }
+        // os_timer_setfn() sur un timer armé corrompt la liste des timers
+        os_timer_disarm(&timer());
+        os_timer_setfn(&timer(), callback, nullptr);
+        os_timer_arm(&timer(), period_ms, true);
+        armed() = true;
+    }
+
+    static void stop() {
+        os_timer_disarm(&timer());
+        armed() = false;
+    }
+
+    static bool running() { return armed(); }
+#elif !defined(ARDUINO)
+    // Jamais détruit : un thread encore joignable à la sortie du programme
+    // appellerait std::terminate()
+    static std::thread*& worker() {
+        static std::thread* instance = nullptr;
+        return instance;
+    }
+
+    static std::atomic<bool>& stopping() {
+        static std::atomic<bool> value(false);
+        return value;
+    }
+
+    static void start(uint32_t period_ms, Callback callback) {
+        stopping().store(false);
+        worker() = new std::thread([period_ms, callback]() {
+            struct timespec period;
+            period.tv_sec = period_ms / 1000;
+            period.tv_nsec = (long)(period_ms % 1000) * 1000000L;
+            for (;;) {
+                nanosleep(&period, nullptr);
+                if (stopping().load()) return;
+                callback(nullptr);
+            }
+        });
+    }
+
+    static void stop() {
+        if (worker() == nullptr) return;
+        stopping().store(true);
+        worker()->join();
+        delete worker();
+        worker() = nullptr;
+    }
+
+    static bool running() { return worker() != nullptr; }
+#else
+    static bool& active() {
+        static bool value = false;
+        return value;
+    }
+
+    static void start(uint32_t, Callback) { active() = true; }
+    static void stop() { active() = false; }
+    static bool running() { return active(); }
+#endif
+};
+
+/**
+ * @brief Tick sur l'horloge virtuelle : un timer PreciseTimeSimBackend réarmé
+ *
+ * PreciseTimeSimBackend::clear() supprime le timer : running() devient
+ * faux, et beginCoarse() peut réarmer le tick.
+ */
+struct PreciseTimeSimCoarseTicker {
+    typedef void (*Callback)(void* arg);
+
+    static uint64_t& period_us() {
+        static uint64_t value = 0;
+        return value;
+    }
+
+    static Callback& callback() {
+        static Callback value = nullptr;
+        return value;
+    }
+
+    static int& timer_id() {
+        static int id = -1;
+        return id;
+    }
+
+    static void fire(void*) {
+        timer_id() = PreciseTimeSimBackend::addTimer(PreciseTimeSimBackend::now() + period_us(), fire);
+        callback()(nullptr);
+    }
+
+    static void start(uint32_t period_ms, Callback publish) {
+        period_us() = (uint64_t)period_ms * 1000ULL;
+        callback() = publish;
+        timer_id() = PreciseTimeSimBackend::addTimer(PreciseTimeSimBackend::now() + period_us(), fire);
+    }
+
+    static void stop() {
+        PreciseTimeSimBackend::cancelTimer(timer_id());
+        timer_id() = -1;
+    }
+
+    static bool running() {
+        return PreciseTimeSimBackend::isPending(timer_id());
+    }
+};
+
+/**
+ * @brief Tick utilisé pour un backend donné
+ */
+template <class Backend>
+struct PreciseTimeCoarseTickerFor {
+    typedef PreciseTimeCoarseTicker<Backend> type;
+};
+
+template <>
+struct PreciseTimeCoarseTickerFor<PreciseTimeSimBackend> {
+    typedef PreciseTimeSimCoarseTicker type;
+};
+
+#endif // PRECISE_TIME_COARSE_H
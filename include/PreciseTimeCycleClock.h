@@ -0,0 +1,136 @@
+/**
+ * @file PreciseTimeCycleClock.h
+ * @brief Horloge nanoseconde basée sur le compteur de cycles CPU (CCOUNT)
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_CYCLE_CLOCK_H
+#define PRECISE_TIME_CYCLE_CLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+#include "PreciseTimeWrapExtender.h"
+
+#if defined(ESP8266)
+#include <Esp.h>
+#endif
+
+/**
+ * @brief Compteur de cycles étendu à 63 bits et converti en nanosecondes
+ *
+ * La conversion se fait par segments : chaque segment fixe une origine
+ * (cycles, ns) et une fréquence. Quand la fréquence lue diffère de celle
+ * du segment actif, un nouveau segment démarre au cycle courant ; les
+ * cycles écoulés depuis la lecture précédente sont comptés à l'ancienne
+ * fréquence. Les deux segments sont en double tampon : le lecteur ne voit
+ * jamais un segment en cours d'écriture tant que les changements de
+ * fréquence ne se succèdent pas pendant une même lecture.
+ *
+ * Le compteur 32 bits déborde toutes les 2^32 / f secondes (26,8 s à
+ * 160 MHz) : il faut lire l'horloge au moins toutes les 13 secondes.
+ *
+ * @tparam Cpu Fournit cycles() (compteur 32 bits) et mhz() (fréquence
+ *         courante). Sur ESP8266, CCOUNT ; sur l'hôte, une maquette.
+ */
+template <class Cpu>
+class PreciseTimeCycleClock {
+private:
+    struct Segment {
+        uint64_t base_cycles;
+        uint64_t base_ns;
+        uint32_t mhz;
+        uint32_t ns_per_cycle_q16;   // 1000 / mhz en virgule fixe 16.16
+    };
+
+    PreciseTimeWrapExtender extender;
+    Segment segments[2];
+    std::atomic<uint32_t> active;
+
+    static uint32_t readCycles() { return Cpu::cycles(); }
+
+    // delta * q >> 16 sans débordement intermédiaire
+    static uint64_t toNanoseconds(const Segment& segment, uint64_t cycles) {
+        uint64_t delta = cycles - segment.base_cycles;
+        return segment.base_ns
+               + (delta >> 16) * segment.ns_per_cycle_q16
+               + (((delta & 0xFFFF) * segment.ns_per_cycle_q16) >> 16);
+    }
+
+    const Segment& rebase(const Segment& current, uint64_t cycles, uint32_t mhz) {
+        uint32_t next = active.load(std::memory_order_relaxed) ^ 1;
+        Segment& segment = segments[next];
+        segment.base_ns = toNanoseconds(current, cycles);
+        segment.base_cycles = cycles;
+        segment.mhz = mhz;
+        segment.ns_per_cycle_q16 = (1000UL << 16) / mhz;
+        active.store(next, std::memory_order_release);
+        return segment;
+    }
+
+public:
+    constexpr PreciseTimeCycleClock() : extender(), segments(), active(0) {}
+
+    /**
+     * @brief Démarre le premier segment ; les nanosecondes partent de 0
+     */
+    void begin() {
+        uint64_t now = cycles();
+        Segment& segment = segments[0];
+        segment.base_cycles = now;
+        segment.base_ns = 0;
+        segment.mhz = Cpu::mhz();
+        segment.ns_per_cycle_q16 = (1000UL << 16) / segment.mhz;
+        active.store(0, std::memory_order_release);
+    }
+
+    /**
+     * @brief Cycles CPU écoulés depuis le démarrage, étendus à 63 bits
+     */
+    uint64_t cycles() {
+        return extender.read(readCycles);
+    }
+
+    uint64_t nanoseconds() {
+        const Segment& segment = segments[active.load(std::memory_order_acquire)];
+        uint32_t mhz = Cpu::mhz();
+        uint64_t now = cycles();
+        if (mhz != segment.mhz) {
+            return toNanoseconds(rebase(segment, now, mhz), now);
+        }
+        return toNanoseconds(segment, now);
+    }
+
+    uint32_t frequencyMHz() const {
+        return segments[active.load(std::memory_order_acquire)].mhz;
+    }
+};
+
+#if defined(ESP8266)
+/**
+ * @brief Registre CCOUNT et fréquence courante (80 ou 160 MHz)
+ */
+struct PreciseTimeEsp8266Cpu {
+    static inline uint32_t cycles() { return ESP.getCycleCount(); }
+    static inline uint32_t mhz() { return ESP.getCpuFreqMHz(); }
+};
+#endif
+
+#endif // PRECISE_TIME_CYCLE_CLOCK_H
@@ -0,0 +1,174 @@
+/**
+ * @file PreciseTimeDivide.h
+ * @brief Division par une constante sans instruction de division
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_DIVIDE_H
+#define PRECISE_TIME_DIVIDE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Calcul à la compilation des inverses et produit haut 64 bits
+ */
+struct PreciseTimeReciprocal {
+    // Plus petit l tel que 2^l >= d
+    static constexpr unsigned ceilLog2(uint64_t d, unsigned l = 0) {
+        return ((1ULL << l) >= d) ? l : ceilLog2(d, l + 1);
+    }
+
+    // floor(rem * 2^bits / d) par division posée, pour rem < d <= 2^63
+    static constexpr uint64_t longDivide(uint64_t rem, uint64_t d,
+                                         unsigned bits, uint64_t q = 0) {
+        return bits == 0 ? q
+             : longDivide((rem << 1) >= d ? (rem << 1) - d : (rem << 1), d,
+                          bits - 1, (q << 1) | ((rem << 1) >= d ? 1 : 0));
+    }
+
+    // 64 bits de poids fort de a * b ; sans __int128 (ESP8266, ESP32),
+    // quatre produits 32 x 32 -> 64.
+    static inline uint64_t mulHigh(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#else
+        uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+        uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+        uint64_t lo_lo = a_lo * b_lo;
+        uint64_t hi_lo = a_hi * b_lo;
+        uint64_t lo_hi = a_lo * b_hi;
+        uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+
+    // floor((2^64 - 1) / d) - 2^32 pour d normalisé (bit 31 à 1), sans
+    // division : 3·2^31 - d approche 2^63 / d à 1/8 près, quatre itérations
+    // de Newton par défaut, puis correction jusqu'à la valeur exacte
+    static inline uint32_t invert(uint32_t d) {
+        if (d == 0x80000000UL) return UINT32_MAX;
+        uint32_t w = (uint32_t)(3ULL * 0x80000000ULL - d);
+        for (int i = 0; i < 4; i++) {
+            int64_t error = (int64_t)((1ULL << 63) - (uint64_t)d * w);
+            w += (uint32_t)(((int64_t)w * (error >> 31)) >> 32);
+        }
+        // w <= 2^63 / d : 2w <= floor((2^64 - 1) / d), à quelques unités
+        uint64_t v = (uint64_t)w << 1;
+        uint64_t rest = UINT64_MAX - (((uint64_t)d * w) << 1);
+        while (rest >= d) {
+            v++;
+            rest -= d;
+        }
+        return (uint32_t)v;
+    }
+
+    // (high·2^32 + low) / d, reste dans rest, pour high < d normalisé et
+    // v = invert(d) (Möller-Granlund, division 2 mots par 1)
+    static inline uint32_t divideStep(uint32_t high, uint32_t low, uint32_t d,
+                                      uint32_t v, uint32_t& rest) {
+        uint64_t q = (uint64_t)v * high + ((((uint64_t)high + 1) << 32) | low);
+        uint32_t quotient = (uint32_t)(q >> 32);
+        uint32_t r = low - quotient * d;
+        if (r > (uint32_t)q) {
+            quotient--;
+            r += d;
+        }
+        if (r >= d) {
+            quotient++;
+            r -= d;
+        }
+        rest = r;
+        return quotient;
+    }
+
+    /**
+     * @brief n / d pour un diviseur d != 0 connu seulement à l'exécution
+     *
+     * Quotient exact en produits 32 x 32 -> 64 seulement : sur ESP8266 et
+     * ESP32, ni __udivdi3 ni __divdi3. Utile quand d change à chaque appel ;
+     * pour un diviseur constant, PreciseTimeDivide est plus court.
+     */
+    static inline uint64_t divide(uint64_t n, uint32_t d) {
+        unsigned shift = (unsigned)__builtin_clz(d);
+        uint32_t normalized = d << shift;
+        uint32_t v = invert(normalized);
+        uint64_t shifted = n << shift;
+        uint32_t top = shift ? (uint32_t)(n >> (64 - shift)) : 0;
+        uint32_t rest;
+        uint32_t high = divideStep(top, (uint32_t)(shifted >> 32), normalized, v, rest);
+        uint32_t low = divideStep(rest, (uint32_t)shifted, normalized, v, rest);
+        return ((uint64_t)high << 32) | low;
+    }
+};
+
+/**
+ * @brief Quotient exact par D en multiplication-décalage (Granlund-Montgomery)
+ *
+ * Avec l = ceil(log2 D) et m = floor(2^N * (2^l - D) / D) + 1, pour tout n
+ * sur N bits : t = (m * n) >> N, puis n / D = (t + ((n - t) >> 1)) >> (l - 1).
+ * Exact sur tout le domaine, sans division à l'exécution ; m est calculé à
+ * la compilation.
+ *
+ * quotient32() fait le même calcul sur 32 bits (un seul produit 32 x 32 -> 64)
+ * pour les restes déjà réduits, par exemple les secondes d'une journée.
+ */
+template <uint64_t D>
+struct PreciseTimeDivide {
+    static_assert(D > 1 && D <= (1ULL << 63), "diviseur hors domaine");
+
+    static const unsigned SHIFT = PreciseTimeReciprocal::ceilLog2(D);
+    static const uint64_t MAGIC64 =
+        PreciseTimeReciprocal::longDivide((1ULL << SHIFT) - D, D, 64) + 1;
+    static const uint32_t MAGIC32 = (D < (1ULL << 32))
+        ? (uint32_t)(PreciseTimeReciprocal::longDivide((1ULL << SHIFT) - D, D, 32) + 1)
+        : 0;
+
+    static inline uint64_t quotient(uint64_t n) {
+        uint64_t t = PreciseTimeReciprocal::mulHigh(MAGIC64, n);
+        return (t + ((n - t) >> 1)) >> (SHIFT - 1);
+    }
+
+    static inline uint64_t remainder(uint64_t n) {
+        return n - quotient(n) * D;
+    }
+
+    static inline uint32_t quotient32(uint32_t n) {
+        static_assert(D < (1ULL << 32), "quotient32() : diviseur sur 32 bits");
+        uint32_t t = (uint32_t)(((uint64_t)MAGIC32 * n) >> 32);
+        return (t + ((n - t) >> 1)) >> (SHIFT - 1);
+    }
+};
+
+template <uint64_t D> const unsigned PreciseTimeDivide<D>::SHIFT;
+template <uint64_t D> const uint64_t PreciseTimeDivide<D>::MAGIC64;
+template <uint64_t D> const uint32_t PreciseTimeDivide<D>::MAGIC32;
+
+/**
+ * @brief Diviser par 1 est l'identité
+ */
+template <>
+struct PreciseTimeDivide<1> {
+    static inline uint64_t quotient(uint64_t n) { return n; }
+    static inline uint64_t remainder(uint64_t) { return 0; }
+    static inline uint32_t quotient32(uint32_t n) { return n; }
+};
+
+#endif // PRECISE_TIME_DIVIDE_H
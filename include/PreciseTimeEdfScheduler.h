@@ -0,0 +1,315 @@
+/**
+ * @file PreciseTimeEdfScheduler.h
+ * @brief Répartition « échéance la plus proche d'abord » (EDF) de travaux
+ *        courts, sur un tas 4-aire en tableau fixe
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_EDF_SCHEDULER_H
+#define PRECISE_TIME_EDF_SCHEDULER_H
+
+#include "PreciseTime.h"
+
+/**
+ * @brief Sort d'un travail dont l'échéance est passée avant son exécution
+ */
+enum PreciseTimeEdfLatePolicy {
+    PRECISE_TIME_EDF_RUN_LATE,      ///< Exécuté quand même (échéance souple)
+    PRECISE_TIME_EDF_DROP_LATE      ///< Abandonné sans être exécuté (échéance ferme)
+};
+
+/**
+ * @brief Ordonnanceur EDF coopératif à capacité fixe
+ *
+ * Les travaux en attente sont rangés dans un tas 4-aire implicite de
+ * (échéance, emplacement) : les quatre fils d'un nœud sont contigus
+ * (64 octets en natif, à cheval sur au plus deux lignes de cache) et la
+ * hauteur est moitié moindre qu'un tas binaire. Chaque travail occupe un emplacement fixe
+ * qui mémorise sa position dans le tas : le handle renvoyé par submit()
+ * permet cancel() et setDeadline() (décroissance ou croissance de clé)
+ * en O(log4 n), sans recherche.
+ *
+ * Chaque travail appartient à une classe (0 à CLASSES - 1) ; par classe
+ * sont comptés les travaux terminés, ceux terminés après leur échéance,
+ * ceux abandonnés (PRECISE_TIME_EDF_DROP_LATE) et le pire retard.
+ *
+ * Un handle désigne son travail jusqu'à ce qu'il soit exécuté, abandonné
+ * ou annulé ; son emplacement est ensuite réutilisé. Le handle porte la
+ * génération de l'emplacement, incrémentée à chaque réutilisation : un
+ * handle périmé est refusé, même quand un rappel resoumet aussitôt un
+ * travail dans l'emplacement qu'il vient de libérer. Aucune allocation :
+ * CAPACITY × 40 octets en natif, 32 sur ESP32. Non synchronisé.
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam CAPACITY Nombre maximal de travaux en attente
+ * @tparam CLASSES Nombre de classes de travaux
+ */
+template <class Time = PreciseTime, uint32_t CAPACITY = 32, unsigned CLASSES = 4>
+class PreciseTimeEdfScheduler {
+public:
+    typedef void (*Job)(void* context);
+    typedef uint32_t Handle;            ///< Génération × CAPACITY + emplacement
+
+    static const Handle INVALID_HANDLE = UINT32_MAX;
+
+    /**
+     * @brief Compteurs d'une classe de travaux
+     */
+    struct ClassStats {
+        uint32_t completed;         ///< Travaux exécutés
+        uint32_t missed;            ///< Exécutés mais terminés après l'échéance
+        uint32_t dropped;           ///< Abandonnés car déjà en retard
+        uint32_t max_tardiness;     ///< Pire retard à la fin d'un travail, en µs
+    };
+
+    static_assert(CAPACITY >= 1 && CAPACITY < UINT32_MAX, "CAPACITY invalide");
+    static_assert(CLASSES >= 1 && CLASSES <= 256, "CLASSES : 1 à 256");
+
+private:
+    static const uint32_t FREE = UINT32_MAX;
+
+    // Générations d'un emplacement : tiennent sur 16 bits et laissent
+    // INVALID_HANDLE hors d'atteinte
+    static const uint32_t GENERATIONS = UINT32_MAX / CAPACITY < 65536 ? UINT32_MAX / CAPACITY : 65536;
+
+    struct Node {
+        uint64_t deadline;
+        uint32_t slot;
+    };
+
+    struct Slot {
+        Job job;
+        void* context;
+        uint32_t position;          // Indice dans le tas, ou suivant libre
+        uint16_t generation;
+        uint8_t job_class;
+        bool pending;
+    };
+
+    Node heap[CAPACITY];
+    Slot slots[CAPACITY];
+    uint32_t count;
+    uint32_t free_head;
+    ClassStats stats[CLASSES];
+    PreciseTimeEdfLatePolicy policies[CLASSES];
+
+    void moveTo(uint32_t position, const Node& node) {
+        heap[position] = node;
+        slots[node.slot].position = position;
+    }
+
+    void siftUp(uint32_t position, Node node) {
+        while (position > 0) {
+            uint32_t parent = (position - 1) >> 2;
+            if (heap[parent].deadline <= node.deadline) break;
+            moveTo(position, heap[parent]);
+            position = parent;
+        }
+        moveTo(position, node);
+    }
+
+    void siftDown(uint32_t position, Node node) {
+        for (;;) {
+            uint32_t first = (position << 2) + 1;
+            if (first >= count) break;
+            uint32_t last = first + 4 < count ? first + 4 : count;
+            uint32_t best = first;
+            for (uint32_t child = first + 1; child < last; child++) {
+                if (heap[child].deadline < heap[best].deadline) best = child;
+            }
+            if (heap[best].deadline >= node.deadline) break;
+            moveTo(position, heap[best]);
+            position = best;
+        }
+        moveTo(position, node);
+    }
+
+    // Retire le nœud en `position` et rend son emplacement
+    void removeAt(uint32_t position) {
+        uint32_t slot = heap[position].slot;
+        count--;
+        if (position < count) {
+            Node moved = heap[count];
+            if (position > 0 && moved.deadline < heap[(position - 1) >> 2].deadline) {
+                siftUp(position, moved);
+            } else {
+                siftDown(position, moved);
+            }
+        }
+        slots[slot].pending = false;
+        slots[slot].position = free_head;
+        free_head = slot;
+    }
+
+    bool valid(Handle handle) const {
+        if (handle == INVALID_HANDLE) return false;
+        const Slot& slot = slots[handle % CAPACITY];
+        return slot.pending && slot.generation == handle / CAPACITY;
+    }
+
+public:
+    PreciseTimeEdfScheduler() {
+        // Les générations survivent à clear() : les anciens handles restent périmés
+        for (uint32_t i = 0; i < CAPACITY; i++) slots[i].generation = 0;
+        clear();
+        resetStats();
+        for (unsigned i = 0; i < CLASSES; i++) policies[i] = PRECISE_TIME_EDF_RUN_LATE;
+    }
+
+    /**
+     * @brief Met en attente `job` pour l'échéance absolue `deadline_us`
+     *        (µs de Time)
+     * @return Handle, ou INVALID_HANDLE si la file est pleine ou si
+     *         `job_class` n'est pas une classe (>= CLASSES)
+     */
+    Handle submit(uint64_t deadline_us, Job job, void* context = nullptr, uint8_t job_class = 0) {
+        if (free_head == FREE || job_class >= CLASSES) return INVALID_HANDLE;
+        uint32_t slot = free_head;
+        free_head = slots[slot].position;
+        slots[slot].job = job;
+        slots[slot].context = context;
+        slots[slot].job_class = job_class;
+        slots[slot].pending = true;
+        uint32_t generation = slots[slot].generation + 1u < GENERATIONS ? slots[slot].generation + 1u : 0;
+        slots[slot].generation = (uint16_t)generation;
+        Node node = { deadline_us, slot };
+        siftUp(count++, node);
+        return generation * CAPACITY + slot;
+    }
+
+    /**
+     * @brief Change l'échéance d'un travail en attente
+     */
+    bool setDeadline(Handle handle, uint64_t deadline_us) {
+        if (!valid(handle)) return false;
+        uint32_t slot = handle % CAPACITY;
+        uint32_t position = slots[slot].position;
+        Node node = { deadline_us, slot };
+        if (deadline_us < heap[position].deadline) {
+            siftUp(position, node);
+        } else {
+            siftDown(position, node);
+        }
+        return true;
+    }
+
+    bool cancel(Handle handle) {
+        if (!valid(handle)) return false;
+        removeAt(slots[handle % CAPACITY].position);
+        return true;
+    }
+
+    /**
+     * @brief Exécute le travail d'échéance la plus proche
+     *
+     * S'il est déjà en retard et que sa classe est en
+     * PRECISE_TIME_EDF_DROP_LATE, il est abandonné et compté sans être
+     * exécuté. Sinon il est exécuté, puis compté manqué s'il se termine
+     * après son échéance.
+     * @return false si la file est vide
+     */
+    bool runNext() {
+        if (count == 0) return false;
+        Node node = heap[0];
+        Slot& slot = slots[node.slot];
+        Job job = slot.job;
+        void* context = slot.context;
+        ClassStats& stat = stats[slot.job_class];
+        PreciseTimeEdfLatePolicy policy = policies[slot.job_class];
+        removeAt(0);
+
+        if (policy == PRECISE_TIME_EDF_DROP_LATE && Time::getMicroseconds() > node.deadline) {
+            stat.dropped++;
+            return true;
+        }
+        job(context);
+        uint64_t finished = Time::getMicroseconds();
+        stat.completed++;
+        if (finished > node.deadline) {
+            stat.missed++;
+            uint64_t tardiness = finished - node.deadline;
+            if (tardiness > stat.max_tardiness) {
+                stat.max_tardiness = tardiness < UINT32_MAX ? (uint32_t)tardiness : UINT32_MAX;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Exécute au plus `max_jobs` travaux, par échéance croissante
+     * @return Nombre de travaux retirés de la file
+     */
+    uint32_t run(uint32_t max_jobs = UINT32_MAX) {
+        uint32_t done = 0;
+        while (done < max_jobs && runNext()) done++;
+        return done;
+    }
+
+    void setLatePolicy(uint8_t job_class, PreciseTimeEdfLatePolicy policy) {
+        if (job_class < CLASSES) policies[job_class] = policy;
+    }
+
+    /**
+     * @brief Échéance la plus proche en µs de Time, UINT64_MAX si vide
+     */
+    uint64_t nextDeadline() const {
+        return count ? heap[0].deadline : UINT64_MAX;
+    }
+
+    bool isPending(Handle handle) const { return valid(handle); }
+    uint64_t deadline(Handle handle) const {
+        return valid(handle) ? heap[slots[handle % CAPACITY].position].deadline : UINT64_MAX;
+    }
+
+    uint32_t size() const { return count; }
+    static uint32_t capacity() { return CAPACITY; }
+
+    const ClassStats& classStats(uint8_t job_class) const {
+        return stats[job_class < CLASSES ? job_class : CLASSES - 1];
+    }
+
+    /**
+     * @brief Vide la file sans exécuter les travaux
+     */
+    void clear() {
+        count = 0;
+        for (uint32_t i = 0; i < CAPACITY; i++) {
+            slots[i].pending = false;
+            slots[i].position = i + 1 < CAPACITY ? i + 1 : FREE;
+        }
+        free_head = 0;
+    }
+
+    void resetStats() {
+        for (unsigned i = 0; i < CLASSES; i++) {
+            stats[i].completed = 0;
+            stats[i].missed = 0;
+            stats[i].dropped = 0;
+            stats[i].max_tardiness = 0;
+        }
+    }
+};
+
+template <class Time, uint32_t CAPACITY, unsigned CLASSES>
+const typename PreciseTimeEdfScheduler<Time, CAPACITY, CLASSES>::Handle
+    PreciseTimeEdfScheduler<Time, CAPACITY, CLASSES>::INVALID_HANDLE;
+
+#endif // PRECISE_TIME_EDF_SCHEDULER_H
@@ -0,0 +1,187 @@
+/**
+ * @file PreciseTimeFormat.h
+ * @brief Formatage d'une durée sans allocation ni printf
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_FORMAT_H
+#define PRECISE_TIME_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "PreciseTimeDivide.h"
+
+/**
+ * Taille de tampon suffisante pour toutes les mises en forme, zéro final
+ * compris (2^64 µs font 5 124 095 576 heures).
+ */
+#define PRECISE_TIME_FORMAT_BUFFER  32
+
+/**
+ * @brief Mises en forme disponibles
+ */
+enum PreciseTimeLayout {
+    PRECISE_TIME_HMS,           ///< HH:MM:SS, heures totales (dépasse 24)
+    PRECISE_TIME_HMS_MILLIS,    ///< HH:MM:SS.mmm
+    PRECISE_TIME_HMS_MICROS,    ///< HH:MM:SS.uuuuuu
+    PRECISE_TIME_DAYS_HMS       ///< Dd HH:MM:SS, heures dans la journée
+};
+
+/**
+ * @brief Écriture des chiffres à la main, dans un tampon fourni
+ *
+ * Aucune allocation, aucun printf ; les divisions par 10, 60, 3600... sont
+ * faites par PreciseTimeDivide. Les fonctions renvoient le nombre
+ * d'octets écrits hors zéro final, ou 0 si le tampon est trop petit (il
+ * contient alors une chaîne vide).
+ */
+struct PreciseTimeFormatter {
+    /**
+     * @brief Met en forme `micros` microsecondes selon `layout`
+     */
+    static size_t format(char* buffer, size_t size, uint64_t micros,
+                         PreciseTimeLayout layout) {
+        char scratch[PRECISE_TIME_FORMAT_BUFFER];
+        size_t length = layoutTo(scratch, micros, layout);
+        return copyOut(buffer, size, scratch, length);
+    }
+
+    /**
+     * @brief Variante de getFormattedString() : "N jours, HH:MM:SS" ou
+     *        "HH:MM:SS" à partir de secondes
+     */
+    static size_t formatUptime(char* buffer, size_t size, uint64_t seconds) {
+        char scratch[PRECISE_TIME_FORMAT_BUFFER];
+        uint64_t days = PreciseTimeDivide<86400ULL>::quotient(seconds);
+        size_t length = 0;
+        if (days > 0) {
+            length = appendUnsigned(scratch, days);
+            length += appendText(scratch + length, " jours, ");
+        }
+        length += appendClock(scratch + length, (uint32_t)(seconds - days * 86400ULL));
+        return copyOut(buffer, size, scratch, length);
+    }
+
+    /**
+     * @brief Écrit la mise en forme sur une sortie Arduino (Print&) ou tout
+     *        objet fournissant write(const uint8_t*, size_t)
+     * @return Octets écrits
+     */
+    template <class Output>
+    static size_t print(Output& out, uint64_t micros, PreciseTimeLayout layout) {
+        char scratch[PRECISE_TIME_FORMAT_BUFFER];
+        size_t length = layoutTo(scratch, micros, layout);
+        return out.write((const uint8_t*)scratch, length);
+    }
+
+    // Décimal sans zéros de tête (au moins un chiffre)
+    static size_t appendUnsigned(char* out, uint64_t value) {
+        char digits[20];
+        size_t count = 0;
+        while (value >= (1ULL << 32)) {
+            uint64_t q = PreciseTimeDivide<10ULL>::quotient(value);
+            digits[count++] = (char)('0' + (value - q * 10ULL));
+            value = q;
+        }
+        uint32_t small = (uint32_t)value;
+        do {
+            uint32_t q = PreciseTimeDivide<10ULL>::quotient32(small);
+            digits[count++] = (char)('0' + (small - q * 10UL));
+            small = q;
+        } while (small != 0);
+        for (size_t i = 0; i < count; i++) out[i] = digits[count - 1 - i];
+        return count;
+    }
+
+    // `width` chiffres exactement, complétés par des zéros à gauche
+    static size_t appendPadded(char* out, uint32_t value, size_t width) {
+        for (size_t i = width; i > 0; i--) {
+            uint32_t q = PreciseTimeDivide<10ULL>::quotient32(value);
+            out[i - 1] = (char)('0' + (value - q * 10UL));
+            value = q;
+        }
+        return width;
+    }
+
+private:
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+    // Heures (au moins deux chiffres), minutes et secondes
+    static size_t appendHours(char* out, uint64_t hours, uint32_t seconds_in_hour) {
+        size_t length = (hours < 10) ? appendPadded(out, (uint32_t)hours, 2)
+                                     : appendUnsigned(out, hours);
+        uint32_t minutes = PreciseTimeDivide<60ULL>::quotient32(seconds_in_hour);
+        out[length++] = ':';
+        length += appendPadded(out + length, minutes, 2);
+        out[length++] = ':';
+        length += appendPadded(out + length, seconds_in_hour - minutes * 60UL, 2);
+        return length;
+    }
+
+    // HH:MM:SS pour moins d'une journée
+    static size_t appendClock(char* out, uint32_t seconds_in_day) {
+        uint32_t hours = PreciseTimeDivide<3600ULL>::quotient32(seconds_in_day);
+        return appendHours(out, hours, seconds_in_day - hours * 3600UL);
+    }
+
+    static size_t layoutTo(char* out, uint64_t micros, PreciseTimeLayout layout) {
+        uint64_t seconds = PreciseTimeDivide<1000000ULL>::quotient(micros);
+        uint32_t fraction = (uint32_t)(micros - seconds * 1000000ULL);
+        size_t length;
+        if (layout == PRECISE_TIME_DAYS_HMS) {
+            uint64_t days = PreciseTimeDivide<86400ULL>::quotient(seconds);
+            length = appendUnsigned(out, days);
+            out[length++] = 'd';
+            out[length++] = ' ';
+            return length + appendClock(out + length, (uint32_t)(seconds - days * 86400ULL));
+        }
+        uint64_t hours = PreciseTimeDivide<3600ULL>::quotient(seconds);
+        length = appendHours(out, hours, (uint32_t)(seconds - hours * 3600ULL));
+        if (layout == PRECISE_TIME_HMS_MILLIS) {
+            out[length++] = '.';
+            length += appendPadded(out + length, PreciseTimeDivide<1000ULL>::quotient32(fraction), 3);
+        } else if (layout == PRECISE_TIME_HMS_MICROS) {
+            out[length++] = '.';
+            length += appendPadded(out + length, fraction, 6);
+        }
+        return length;
+    }
+
+    static size_t copyOut(char* buffer, size_t size, const char* scratch, size_t length) {
+        if (size == 0) return 0;
+        if (length + 1 > size) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        for (size_t i = 0; i < length; i++) buffer[i] = scratch[i];
+        buffer[length] = '\0';
+        return length;
+    }
+};
+
+#endif // PRECISE_TIME_FORMAT_H
@@ -0,0 +1,206 @@
+/**
+ * @file PreciseTimeHistogram.h
+ * @brief Histogramme de latences log-linéaire (style HDR) en mémoire fixe
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_HISTOGRAM_H
+#define PRECISE_TIME_HISTOGRAM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Paramètres dérivés à la compilation
+ */
+struct PreciseTimeHistogramLayout {
+    static constexpr uint32_t pow10(unsigned digits) {
+        return digits == 0 ? 1 : 10 * pow10(digits - 1);
+    }
+
+    // Plus petit S tel que 2^(S-1) >= 10^digits
+    static constexpr unsigned subBucketBits(unsigned digits, unsigned bits = 1) {
+        return (1UL << (bits - 1)) >= pow10(digits) ? bits : subBucketBits(digits, bits + 1);
+    }
+
+    static constexpr unsigned msb(uint32_t value) {
+        return value <= 1 ? 0 : 1 + msb(value >> 1);
+    }
+
+    static constexpr uint32_t index(uint32_t value, unsigned sub_bits) {
+        return msb(value) < sub_bits ? value
+             : ((msb(value) - (sub_bits - 1)) << (sub_bits - 1))
+               + (value >> (msb(value) - (sub_bits - 1)));
+    }
+};
+
+/**
+ * @brief Histogramme de latences à précision relative constante
+ *
+ * Les valeurs sous 2^S sont comptées exactement ; au-delà, chaque
+ * puissance de 2 est découpée en 2^(S-1) cases de même largeur, donc
+ * l'erreur relative d'un percentile reste sous 2^-(S-1) <= 10^-DIGITS.
+ * La case d'une valeur se calcule par un clz, sans boucle ni division.
+ *
+ * Taille : (index(MAX_VALUE) + 1) compteurs. Avec MAX_VALUE = 10^6 (1 s
+ * en µs) et DIGITS = 1, 271 compteurs : 542 octets en uint16_t, 1084 en
+ * uint32_t (le défaut, environ 1,1 Ko avec l'en-tête). Avec DIGITS = 2,
+ * 1781 compteurs. Sur cible, préférer uint16_t et vider l'histogramme
+ * (snapshotAndReset()) avant 65535 échantillons dans une même case.
+ *
+ * Les compteurs saturent au lieu de reboucler ; les percentiles sont
+ * alors calculés sur les comptes saturés, plus sur count(), et ne sont
+ * plus qu'indicatifs : saturated() le signale.
+ *
+ * record() n'est pas synchronisé : l'appeler depuis un seul contexte,
+ * et copier l'histogramme (snapshot) depuis ce même contexte ou
+ * interruptions masquées.
+ *
+ * @tparam MAX_VALUE Plus grande valeur distinguée ; au-delà, les valeurs
+ *         sont comptées dans la dernière case (max() reste exact)
+ * @tparam DIGITS Chiffres significatifs (1 à 3)
+ * @tparam Counter Type des compteurs (uint16_t, uint32_t...)
+ */
+template <uint32_t MAX_VALUE = 1000000UL, unsigned DIGITS = 1, class Counter = uint32_t>
+class PreciseTimeLatencyHistogram {
+public:
+    static const unsigned SUB_BUCKET_BITS = PreciseTimeHistogramLayout::subBucketBits(DIGITS);
+    static const uint32_t BUCKETS = PreciseTimeHistogramLayout::index(MAX_VALUE, SUB_BUCKET_BITS) + 1;
+
+    static_assert(DIGITS >= 1 && DIGITS <= 3, "1 à 3 chiffres significatifs");
+    static_assert(MAX_VALUE >= (1UL << SUB_BUCKET_BITS), "MAX_VALUE trop petit pour DIGITS");
+
+private:
+    Counter counts[BUCKETS];
+    uint32_t total;
+    uint32_t min_value;
+    uint32_t max_value;
+    uint64_t sum;
+
+    static inline uint32_t indexOf(uint32_t value) {
+        int magnitude = 31 - __builtin_clz(value | 1) - (int)(SUB_BUCKET_BITS - 1);
+        magnitude &= ~(magnitude >> 31);            // max(0, magnitude) sans branche
+        return ((uint32_t)magnitude << (SUB_BUCKET_BITS - 1)) + (value >> magnitude);
+    }
+
+    // Plus grande valeur comptée dans la case `index`
+    static uint32_t highestIn(uint32_t index) {
+        if (index < (1UL << SUB_BUCKET_BITS)) return index;
+        uint32_t magnitude = (index >> (SUB_BUCKET_BITS - 1)) - 1;
+        uint32_t sub = index - (magnitude << (SUB_BUCKET_BITS - 1));
+        return ((sub + 1) << magnitude) - 1;
+    }
+
+    static inline void add(Counter& counter, Counter amount) {
+        Counter room = (Counter)(~(Counter)0 - counter);
+        counter = (Counter)(counter + (amount < room ? amount : room));
+    }
+
+public:
+    PreciseTimeLatencyHistogram() {
+        reset();
+    }
+
+    void reset() {
+        for (uint32_t i = 0; i < BUCKETS; i++) counts[i] = 0;
+        total = 0;
+        min_value = UINT32_MAX;
+        max_value = 0;
+        sum = 0;
+    }
+
+    /**
+     * @brief Ajoute une latence (unité libre : µs, ns, cycles...)
+     */
+    inline void record(uint32_t value) {
+        uint32_t clamped = value < MAX_VALUE ? value : MAX_VALUE;
+        add(counts[indexOf(clamped)], 1);
+        total++;
+        sum += value;
+        if (value < min_value) min_value = value;
+        if (value > max_value) max_value = value;
+    }
+
+    /**
+     * @brief Ajoute les comptes de `other` (autre cœur, autre période...)
+     */
+    void merge(const PreciseTimeLatencyHistogram& other) {
+        for (uint32_t i = 0; i < BUCKETS; i++) add(counts[i], other.counts[i]);
+        total += other.total;
+        sum += other.sum;
+        if (other.min_value < min_value) min_value = other.min_value;
+        if (other.max_value > max_value) max_value = other.max_value;
+    }
+
+    /**
+     * @brief Copie l'état dans `out` puis le remet à zéro (fenêtre glissante)
+     */
+    void snapshotAndReset(PreciseTimeLatencyHistogram& out) {
+        out = *this;
+        reset();
+    }
+
+    uint32_t count() const { return total; }
+    uint32_t min() const { return total ? min_value : 0; }
+    uint32_t max() const { return max_value; }
+    uint32_t mean() const { return total ? (uint32_t)(sum / total) : 0; }
+
+    /**
+     * @brief Plus petite valeur v telle qu'au moins `percent` % des
+     *        échantillons soient <= v, à la précision de la case près
+     *        (borne haute de la case, ramenée dans [min(), max()])
+     */
+    uint32_t valueAtPercentile(double percent) const {
+        if (total == 0) return 0;
+        if (percent > 100.0) percent = 100.0;
+        // Rang parmi les échantillons réellement comptés : un compteur
+        // saturé en a perdu, total ne serait jamais atteint
+        uint64_t counted = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++) counted += counts[i];
+        uint64_t rank = (uint64_t)(percent * counted / 100.0 + 0.999999999);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint32_t value = highestIn(i);
+                if (value > max_value) value = max_value;
+                if (value < min_value) value = min_value;
+                return value;
+            }
+        }
+        return max_value;
+    }
+
+    Counter bucketCount(uint32_t index) const { return counts[index]; }
+
+    /**
+     * @brief Vrai si une case a saturé : count() dépasse les comptes des
+     *        cases et les percentiles sont faussés
+     */
+    bool saturated() const {
+        for (uint32_t i = 0; i < BUCKETS; i++) {
+            if (counts[i] == (Counter)~(Counter)0) return true;
+        }
+        return false;
+    }
+};
+
+#endif // PRECISE_TIME_HISTOGRAM_H
@@ -0,0 +1,190 @@
+/**
+ * @file PreciseTimeIdle.h
+ * @brief Veille sans tick : dort en veille légère jusqu'à la prochaine
+ *        échéance des ordonnanceurs et minuteries surveillés
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_IDLE_H
+#define PRECISE_TIME_IDLE_H
+
+#include "PreciseTime.h"
+
+// Plus longue veille sans échéance connue (µs)
+#ifndef PRECISE_TIME_IDLE_MAX_SLEEP_US
+#define PRECISE_TIME_IDLE_MAX_SLEEP_US  1000000ULL
+#endif
+
+// Plus grande avance du réveil sur l'échéance (µs)
+#ifndef PRECISE_TIME_IDLE_MAX_WAKE_MARGIN_US
+#define PRECISE_TIME_IDLE_MAX_WAKE_MARGIN_US  20000
+#endif
+
+/**
+ * @brief Point de veille de loop() entre deux échéances
+ *
+ * watch() enregistre des sources d'échéances : tout objet dont
+ * nextDeadline() renvoie des µs de Time (PreciseTimeScheduler,
+ * PreciseTimeEdfScheduler, PreciseTimeTimerWheel), ou une fonction.
+ * idle() prend la plus proche, dort en veille légère (Time::lightSleep())
+ * jusqu'à une marge avant elle, puis finit par Time::sleepUntil().
+ * Le compteur de Time est corrigé du temps de veille : les échéances
+ * restent sur la même grille. Une échéance trop proche pour valoir une
+ * veille (light_sleep_type::MIN_SLEEP_US) est attendue par sleepUntil()
+ * seul.
+ *
+ * La marge couvre la sortie de veille ; elle suit le retard observé des
+ * réveils (preciseTimeTrackMargin()), à partir de
+ * light_sleep_type::WAKE_MARGIN_US.
+ *
+ *     void loop() {
+ *         scheduler.run();
+ *         wheel.update();
+ *         idle.idle();
+ *     }
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam MAX_SOURCES Nombre de sources surveillées
+ */
+template <class Time = PreciseTime, unsigned MAX_SOURCES = 4>
+class PreciseTimeIdle {
+public:
+    typedef uint64_t (*NextDeadline)(const void* source);
+    typedef typename Time::light_sleep_type LightSleep;
+
+private:
+    struct Source {
+        NextDeadline next;
+        const void* object;
+    };
+
+    Source sources[MAX_SOURCES];
+    unsigned source_count;
+    uint32_t wake_margin;
+    uint32_t sleep_count;
+    uint64_t slept_total;
+    uint32_t max_late;
+
+    template <class Watched>
+    static uint64_t nextOf(const void* source) {
+        return ((const Watched*)source)->nextDeadline();
+    }
+
+public:
+    PreciseTimeIdle() : source_count(0), wake_margin(LightSleep::WAKE_MARGIN_US) {
+        resetStats();
+    }
+
+    /**
+     * @brief Surveille `source`, qui doit vivre aussi longtemps que l'objet
+     * @return false si la table est pleine
+     */
+    template <class Watched>
+    bool watch(const Watched& source) {
+        return watch(&nextOf<Watched>, &source);
+    }
+
+    /**
+     * @brief Surveille une fonction renvoyant une échéance en µs de Time
+     *        (UINT64_MAX si aucune), appelée avec `object`
+     */
+    bool watch(NextDeadline next, const void* object = nullptr) {
+        if (source_count >= MAX_SOURCES) return false;
+        sources[source_count].next = next;
+        sources[source_count].object = object;
+        source_count++;
+        return true;
+    }
+
+    bool unwatch(const void* object) {
+        for (unsigned i = 0; i < source_count; i++) {
+            if (sources[i].object != object) continue;
+            sources[i] = sources[--source_count];
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Échéance la plus proche des sources, UINT64_MAX si aucune
+     */
+    uint64_t nextDeadline() const {
+        uint64_t best = UINT64_MAX;
+        for (unsigned i = 0; i < source_count; i++) {
+            uint64_t deadline = sources[i].next(sources[i].object);
+            if (deadline < best) best = deadline;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Dort jusqu'à la prochaine échéance, au plus `max_sleep_us`
+     *
+     * Rend la main aussitôt si une échéance est déjà passée.
+     * @return Retard du réveil sur l'échéance, en µs
+     */
+    uint64_t idle(uint64_t max_sleep_us = PRECISE_TIME_IDLE_MAX_SLEEP_US) {
+        uint64_t now = Time::getMicroseconds();
+        uint64_t deadline = nextDeadline();
+        if (deadline <= now) return 0;
+        if (deadline - now > max_sleep_us) deadline = now + max_sleep_us;
+
+        uint64_t span = deadline - now;
+        if (span >= (uint64_t)LightSleep::MIN_SLEEP_US + wake_margin) {
+            uint64_t planned = span - wake_margin;
+            Time::lightSleep(planned);
+            uint64_t slept = Time::getMicroseconds() - now;
+            preciseTimeTrackMargin(wake_margin, slept > planned ? slept - planned : 0,
+                                   0, PRECISE_TIME_IDLE_MAX_WAKE_MARGIN_US);
+            sleep_count++;
+            slept_total += slept;
+        } else if (span >= LightSleep::MIN_SLEEP_US) {
+            // Seule la marge empêche la veille : elle décroît
+            preciseTimeTrackMargin(wake_margin, 0, 0, PRECISE_TIME_IDLE_MAX_WAKE_MARGIN_US);
+        }
+
+        uint64_t late = Time::sleepUntil(deadline);
+        if (late > max_late) max_late = late < UINT32_MAX ? (uint32_t)late : UINT32_MAX;
+        return late;
+    }
+
+    /**
+     * @brief Avance courante du réveil sur l'échéance, en µs
+     */
+    uint32_t wakeMargin() const { return wake_margin; }
+    void setWakeMargin(uint32_t micros) { wake_margin = micros; }
+
+    /**
+     * @brief Veilles légères, temps total passé en veille (µs) et pire
+     *        retard de réveil (µs) depuis resetStats()
+     */
+    uint32_t sleepCount() const { return sleep_count; }
+    uint64_t sleptMicros() const { return slept_total; }
+    uint32_t maxLateness() const { return max_late; }
+
+    void resetStats() {
+        sleep_count = 0;
+        slept_total = 0;
+        max_late = 0;
+    }
+};
+
+#endif // PRECISE_TIME_IDLE_H
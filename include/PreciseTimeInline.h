@@ -0,0 +1,39 @@
+/**
+ * @file PreciseTimeInline.h
+ * @brief Inlining forcé des chemins appelés depuis une ISR en IRAM
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_INLINE_H
+#define PRECISE_TIME_INLINE_H
+
+/**
+ * Une ISR IRAM_ATTR ne doit appeler que du code en IRAM : pendant une
+ * écriture en flash, le cache est coupé et une fonction restée en flash
+ * fait planter l'ISR. Les accesseurs et lectures d'horloge appelés depuis
+ * une ISR sont donc inlinés de force dans son corps, quel que soit le
+ * niveau d'optimisation (-Og, -O0 en débogage).
+ */
+#ifndef PRECISE_TIME_FORCE_INLINE
+#define PRECISE_TIME_FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+#endif // PRECISE_TIME_INLINE_H
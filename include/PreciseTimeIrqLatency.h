@@ -0,0 +1,393 @@
+/**
+ * @file PreciseTimeIrqLatency.h
+ * @brief Latence d'entrée en interruption : échéance attendue d'une alarme
+ *        matérielle contre horodatage à l'entrée de l'ISR
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_IRQ_LATENCY_H
+#define PRECISE_TIME_IRQ_LATENCY_H
+
+#include <atomic>
+#include "PreciseTime.h"
+#include "PreciseTimeHistogram.h"
+#include "PreciseTimeInline.h"
+
+#if defined(ESP32)
+#define PRECISE_TIME_HAS_IRQ_PROBE
+#elif !defined(ARDUINO) && defined(__linux__)
+#include <signal.h>
+#include <time.h>
+#define PRECISE_TIME_HAS_IRQ_PROBE
+#endif
+
+/**
+ * @brief Statistiques de latence d'une source d'interruption
+ *
+ * arm() ou armPeriodic() fixent l'échéance programmée dans l'alarme, en
+ * ticks de Time. stamp(), première instruction de l'ISR, ne fait que lire
+ * Time::getTicks() et ranger l'instant dans un tampon à un producteur et
+ * un consommateur ; collect(), en contexte de tâche (loop()), mesure pour
+ * chaque instant l'écart avec l'échéance et l'enregistre. L'ISR reste
+ * ainsi entièrement en IRAM, sans division 64 bits ni histogramme. Pour
+ * une alarme périodique à rechargement automatique, l'échéance avance
+ * d'une période à chaque instant collecté ; une interruption perdue
+ * (latence d'une période ou plus) est comptée dans missed().
+ *
+ * collect() doit passer avant que PENDING instants ne s'accumulent : au
+ * delà, stamp() les jette (dropped()) et l'instant suivant apparaît
+ * aussi dans missed().
+ *
+ * Les deux horloges (alarme et Time) démarrent rarement au même instant :
+ * minLatency() contient ce décalage fixe, la gigue (max - min) et les
+ * percentiles restent exacts.
+ *
+ * Un seul contexte appelle stamp() (l'ISR de la source), un seul les
+ * autres méthodes.
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam Histogram Histogramme des latences en ticks
+ * @tparam PENDING Instants en attente de collect() (puissance de 2)
+ */
+template <class Time = PreciseTime,
+          class Histogram = PreciseTimeLatencyHistogram<100000UL, 1, uint16_t>,
+          uint32_t PENDING = 64>
+class PreciseTimeIrqLatency {
+private:
+    static_assert(PENDING != 0 && (PENDING & (PENDING - 1)) == 0,
+                  "PENDING doit être une puissance de 2");
+
+    const char* source_name;
+    uint64_t expected;
+    uint64_t period;
+    bool armed;
+    uint64_t pending[PENDING];
+    std::atomic<uint32_t> head;         // écrit par stamp()
+    std::atomic<uint32_t> tail;         // écrit par collect()
+    volatile uint32_t dropped_count;    // écrit par stamp()
+    uint32_t count;
+    uint32_t missed_count;
+    uint32_t early_count;
+    uint64_t total;
+    uint64_t min_latency;
+    uint64_t max_latency;
+    uint64_t last_latency;
+    Histogram latencies;
+
+    static uint64_t toNanos(uint64_t ticks) {
+        return PreciseTimeConvert<Time::TICKS_PER_SECOND, 1000000000ULL>::apply(ticks);
+    }
+
+    void discardPending() {
+        tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    bool record(uint64_t now) {
+        if (!armed) return false;
+        uint64_t deadline = expected;
+        uint64_t step = period;
+        uint64_t latency = 0;
+        if (now < deadline) {
+            early_count++;
+        } else {
+            latency = now - deadline;
+            if (step != 0 && latency >= step) {
+                uint64_t skipped = latency / step;     // rare : interruptions perdues
+                missed_count += (uint32_t)skipped;
+                deadline += skipped * step;
+                latency -= skipped * step;
+            }
+        }
+        if (step != 0) {
+            expected = deadline + step;
+        } else {
+            armed = false;
+        }
+        count++;
+        total += latency;
+        last_latency = latency;
+        if (latency < min_latency) min_latency = latency;
+        if (latency > max_latency) max_latency = latency;
+        latencies.record(latency < UINT32_MAX ? (uint32_t)latency : UINT32_MAX);
+        return true;
+    }
+
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+public:
+    explicit PreciseTimeIrqLatency(const char* name = "irq")
+        : source_name(name), expected(0), period(0), armed(false),
+          head(0), tail(0), dropped_count(0) {
+        clear();
+    }
+
+    /**
+     * @brief Remet les statistiques à zéro (l'échéance armée est conservée)
+     */
+    void clear() {
+        dropped_count = 0;
+        count = 0;
+        missed_count = 0;
+        early_count = 0;
+        total = 0;
+        min_latency = UINT64_MAX;
+        max_latency = 0;
+        last_latency = 0;
+        latencies.reset();
+    }
+
+    /**
+     * @brief Alarme unique programmée pour `deadline` (ticks de Time)
+     *
+     * Les instants non collectés de l'armement précédent sont écartés.
+     */
+    void arm(uint64_t deadline) {
+        discardPending();
+        expected = deadline;
+        period = 0;
+        armed = true;
+    }
+
+    /**
+     * @brief Alarme périodique : première échéance `first`, puis tous les
+     *        `interval` ticks
+     */
+    void armPeriodic(uint64_t first, uint64_t interval) {
+        discardPending();
+        expected = first;
+        period = interval;
+        armed = true;
+    }
+
+    void disarm() {
+        armed = false;
+    }
+
+    /**
+     * @brief À appeler en tête de l'ISR de la source
+     *
+     * Inliné de force avec Time::getTicks() : rien n'est appelé hors IRAM.
+     */
+    PRECISE_TIME_FORCE_INLINE void stamp() {
+        uint64_t now = Time::getTicks();
+        uint32_t position = head.load(std::memory_order_relaxed);
+        if (position - tail.load(std::memory_order_acquire) >= PENDING) {
+            dropped_count = dropped_count + 1;
+            return;
+        }
+        pending[position & (PENDING - 1)] = now;
+        head.store(position + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Enregistre les instants laissés par stamp(), en contexte de tâche
+     *
+     * Les instants reçus alarme désarmée sont ignorés.
+     * @return Nombre d'instants enregistrés
+     */
+    uint32_t collect() {
+        uint32_t position = tail.load(std::memory_order_relaxed);
+        uint32_t end = head.load(std::memory_order_acquire);
+        uint32_t recorded = 0;
+        while (position != end) {
+            if (record(pending[position & (PENDING - 1)])) recorded++;
+            position++;
+            tail.store(position, std::memory_order_release);
+        }
+        return recorded;
+    }
+
+    const char* name() const { return source_name; }
+    bool isArmed() const { return armed; }
+    uint64_t expectedTicks() const { return expected; }
+
+    uint32_t samples() const { return count; }
+    uint32_t missed() const { return missed_count; }
+    uint32_t early() const { return early_count; }
+    uint32_t dropped() const { return dropped_count; }
+    uint64_t lastLatency() const { return last_latency; }
+    uint64_t minLatency() const { return count ? min_latency : 0; }
+    uint64_t maxLatency() const { return max_latency; }
+    uint64_t meanLatency() const { return count ? total / count : 0; }
+
+    const Histogram& histogram() const { return latencies; }
+
+    /**
+     * @brief Une ligne, latences en nanosecondes :
+     *        "nom : N interruptions, latence moy X ns, min X, max X, p99 X,
+     *        dernière X, perdues N, en avance N"
+     *
+     * `out` est un Print& ou tout objet fournissant write(const uint8_t*, size_t).
+     * @return Octets écrits
+     */
+    template <class Output>
+    size_t report(Output& out) const {
+        char line[256];
+        size_t length = 0;
+        for (const char* c = source_name; *c != '\0' && length < 48; c++) line[length++] = *c;
+        length += appendText(line + length, " : ");
+        length += PreciseTimeFormatter::appendUnsigned(line + length, count);
+        length += appendText(line + length, " interruptions");
+        if (count > 0) {
+            length += appendText(line + length, ", latence moy ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, toNanos(meanLatency()));
+            length += appendText(line + length, " ns, min ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, toNanos(min_latency));
+            length += appendText(line + length, ", max ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, toNanos(max_latency));
+            length += appendText(line + length, ", p99 ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length,
+                toNanos(latencies.valueAtPercentile(99.0)));
+            length += appendText(line + length, ", dernière ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, toNanos(last_latency));
+        }
+        length += appendText(line + length, ", perdues ");
+        length += PreciseTimeFormatter::appendUnsigned(line + length, missed_count);
+        length += appendText(line + length, ", en avance ");
+        length += PreciseTimeFormatter::appendUnsigned(line + length, early_count);
+        line[length++] = '\n';
+        return out.write((const uint8_t*)line, length);
+    }
+};
+
+#if defined(PRECISE_TIME_HAS_IRQ_PROBE)
+/**
+ * @brief Alarme périodique de mesure, branchée sur une PreciseTimeIrqLatency
+ *
+ * ESP32 : timer matériel 1 du groupe 0 (1 MHz), ISR en IRAM ; mesure le
+ * retard dû aux sections critiques (timerMux, portMUX de l'application,
+ * autres ISR). Natif Linux : timer POSIX sur CLOCK_MONOTONIC qui envoie
+ * SIGRTMIN, le gestionnaire de signal jouant le rôle de l'ISR. Une seule
+ * sonde active à la fois. L'ISR n'appelle que Latency::stamp() :
+ * appeler latence.collect() dans loop() pendant la mesure ; stop()
+ * collecte les derniers instants avant de désarmer.
+ */
+template <class Time = PreciseTime, class Latency = PreciseTimeIrqLatency<Time> >
+class PreciseTimeIrqProbe {
+private:
+    static PRECISE_TIME_FORCE_INLINE Latency*& target() {
+        static Latency* instance = nullptr;
+        return instance;
+    }
+
+#if defined(ESP32)
+    static hw_timer_t*& timer() {
+        static hw_timer_t* instance = nullptr;
+        return instance;
+    }
+
+    static void IRAM_ATTR onAlarm() {
+        Latency* latency = target();
+        if (latency != nullptr) latency->stamp();
+    }
+#else
+    static timer_t& timer() {
+        static timer_t instance;
+        return instance;
+    }
+
+    static bool& running() {
+        static bool value = false;
+        return value;
+    }
+
+    static void onSignal(int) {
+        Latency* latency = target();
+        if (latency != nullptr) latency->stamp();
+    }
+#endif
+
+    static uint64_t toTicks(uint32_t micros) {
+        return PreciseTimeConvert<1000000ULL, Time::TICKS_PER_SECOND>::apply(micros);
+    }
+
+public:
+    /**
+     * @brief Démarre l'alarme toutes les `period_us` microsecondes
+     * @return false si l'alarme n'a pas pu être créée
+     */
+    static bool start(Latency& latency, uint32_t period_us) {
+        stop();
+        target() = &latency;
+#if defined(ESP32)
+        timer() = timerBegin(1, 80, true);
+        if (timer() == nullptr) return false;
+        timerAttachInterrupt(timer(), &onAlarm, true);
+        timerAlarmWrite(timer(), period_us, true);
+        latency.armPeriodic(Time::getTicks() + toTicks(period_us), toTicks(period_us));
+        timerAlarmEnable(timer());
+        return true;
+#else
+        struct sigaction action = {};
+        action.sa_handler = onSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        if (sigaction(SIGRTMIN, &action, nullptr) != 0) return false;
+
+        struct sigevent event = {};
+        event.sigev_notify = SIGEV_SIGNAL;
+        event.sigev_signo = SIGRTMIN;
+        if (timer_create(CLOCK_MONOTONIC, &event, &timer()) != 0) return false;
+
+        struct itimerspec spec = {};
+        spec.it_interval.tv_sec = period_us / 1000000UL;
+        spec.it_interval.tv_nsec = (long)(period_us % 1000000UL) * 1000L;
+        spec.it_value = spec.it_interval;
+        latency.armPeriodic(Time::getTicks() + toTicks(period_us), toTicks(period_us));
+        if (timer_settime(timer(), 0, &spec, nullptr) != 0) {
+            timer_delete(timer());
+            return false;
+        }
+        running() = true;
+        return true;
+#endif
+    }
+
+    static void stop() {
+#if defined(ESP32)
+        if (timer() != nullptr) {
+            timerAlarmDisable(timer());
+            timerEnd(timer());
+            timer() = nullptr;
+        }
+#else
+        if (running()) {
+            timer_delete(timer());
+            running() = false;
+        }
+#endif
+        if (target() != nullptr) {
+            target()->collect();
+            target()->disarm();
+        }
+        target() = nullptr;
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_IRQ_LATENCY_H
@@ -0,0 +1,242 @@
+/**
+ * @file PreciseTimeLightSleep.h
+ * @brief Veille légère (ESP32, ESP8266) et mesure du temps passé en veille
+ *        par une horloge qui continue de compter
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_LIGHT_SLEEP_H
+#define PRECISE_TIME_LIGHT_SLEEP_H
+
+#include <stdint.h>
+#include "PreciseTimeBackendSim.h"
+
+#if defined(ESP32)
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#elif defined(ESP8266)
+extern "C" {
+#include "user_interface.h"
+}
+#elif !defined(ARDUINO)
+#include <time.h>
+#include "PreciseTimeBackendNative.h"
+#endif
+
+/*
+ * Une primitive de veille fournit :
+ *   MIN_SLEEP_US    durée en dessous de laquelle la veille ne vaut pas
+ *                   son coût d'entrée et de sortie
+ *   WAKE_MARGIN_US  avance initiale du réveil sur l'échéance
+ *   sleep(us)       dort environ `us` µs ; renvoie la durée mesurée par
+ *                   une horloge qui compte pendant la veille (µs), ou 0
+ *                   sans telle horloge
+ * PreciseTimeT::lightSleep() compare cette durée à celle comptée par le
+ * backend et ajoute la différence au compteur (Backend::skip()).
+ */
+
+#if defined(ESP32)
+/**
+ * @brief esp_light_sleep_start() réveillé par le timer RTC
+ *
+ * Le timer group (et timerISR() en mode ISR) s'arrête avec l'horloge APB ;
+ * esp_timer_get_time() est recalé sur le timer RTC au réveil. Les autres
+ * sources de réveil activées par l'application (GPIO, UART) restent
+ * actives : la veille peut finir plus tôt. Vider Serial avant.
+ */
+struct PreciseTimeEsp32LightSleep {
+    static const uint32_t MIN_SLEEP_US = 2000;
+    static const uint32_t WAKE_MARGIN_US = 1000;
+
+    static uint64_t sleep(uint64_t micros) {
+        int64_t before = esp_timer_get_time();
+        esp_sleep_enable_timer_wakeup(micros);
+        esp_light_sleep_start();
+        return (uint64_t)(esp_timer_get_time() - before);
+    }
+};
+
+typedef PreciseTimeEsp32LightSleep PreciseTimePlatformLightSleep;
+#elif defined(ESP8266)
+/**
+ * @brief Veille légère forcée (wifi_fpm_do_sleep()), mesurée sur l'horloge RTC
+ *
+ * Exige le Wi-Fi en NULL_MODE (WiFi.mode(WIFI_OFF)) ; sinon, simple
+ * delay() sans compensation. micros() et CCOUNT ne comptent pas pendant
+ * la veille. L'horloge RTC (~150 kHz) est convertie par sa calibration
+ * system_rtc_clock_cali_proc() (µs par tick en virgule fixe Q12), précise
+ * à quelques pour mille près.
+ */
+struct PreciseTimeEsp8266LightSleep {
+    static const uint32_t MIN_SLEEP_US = 10000;
+    static const uint32_t WAKE_MARGIN_US = 2000;
+
+    static void woke() {
+    }
+
+    static uint64_t sleep(uint64_t micros) {
+        if (micros > 0xFFFFFFFUL) micros = 0xFFFFFFFUL;
+        if (wifi_get_opmode() != NULL_MODE) {
+            delay((unsigned long)(micros / 1000));
+            return 0;
+        }
+        uint32_t calibration = system_rtc_clock_cali_proc();
+        uint32_t before = system_get_rtc_time();
+        wifi_fpm_set_sleep_type(LIGHT_SLEEP_T);
+        wifi_fpm_open();
+        wifi_fpm_set_wakeup_cb(woke);
+        // La veille commence pendant le delay() qui suit
+        wifi_fpm_do_sleep((uint32_t)micros);
+        delay((unsigned long)(micros / 1000) + 1);
+        wifi_fpm_close();
+        uint32_t ticks = system_get_rtc_time() - before;
+        return ((uint64_t)ticks * calibration) >> 12;
+    }
+};
+
+typedef PreciseTimeEsp8266LightSleep PreciseTimePlatformLightSleep;
+#elif defined(ARDUINO)
+/**
+ * @brief Arduino générique : pas de veille, delay() sans compensation
+ */
+struct PreciseTimeDelayLightSleep {
+    static const uint32_t MIN_SLEEP_US = 1000;
+    static const uint32_t WAKE_MARGIN_US = 1000;
+
+    static uint64_t sleep(uint64_t micros) {
+        delay((unsigned long)(micros / 1000));
+        return 0;
+    }
+};
+
+typedef PreciseTimeDelayLightSleep PreciseTimePlatformLightSleep;
+#else
+/**
+ * @brief Natif : nanosleep() ; une suspension du système pendant l'attente
+ *        est mesurée par l'écart CLOCK_BOOTTIME - CLOCK_MONOTONIC
+ *
+ * La durée de base est lue sur l'horloge du backend natif
+ * (CLOCK_MONOTONIC_RAW), qui ne compte pas la suspension : hors
+ * suspension, la différence avec le backend est nulle, sans l'ajustement
+ * NTP que CLOCK_MONOTONIC y ajouterait à chaque veille. Seule la
+ * suspension passe par l'écart BOOTTIME - MONOTONIC, où NTP s'annule.
+ */
+struct PreciseTimeNativeLightSleep {
+    static const uint32_t MIN_SLEEP_US = 1000;
+    static const uint32_t WAKE_MARGIN_US = 100;
+
+    static uint64_t clockMicros(clockid_t id) {
+        struct timespec ts;
+        clock_gettime(id, &ts);
+        return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+    }
+
+    static uint64_t suspendedMicros() {
+#if defined(CLOCK_BOOTTIME)
+        return clockMicros(CLOCK_BOOTTIME) - clockMicros(CLOCK_MONOTONIC);
+#else
+        return 0;
+#endif
+    }
+
+    static uint64_t sleep(uint64_t micros) {
+        uint64_t start = clockMicros(PRECISE_TIME_NATIVE_CLOCK);
+        uint64_t suspended = suspendedMicros();
+        struct timespec pause;
+        pause.tv_sec = (time_t)(micros / 1000000ULL);
+        pause.tv_nsec = (long)(micros % 1000000ULL) * 1000L;
+        nanosleep(&pause, nullptr);
+        uint64_t resumed = suspendedMicros();
+        return clockMicros(PRECISE_TIME_NATIVE_CLOCK) - start + (resumed > suspended ? resumed - suspended : 0);
+    }
+};
+
+typedef PreciseTimeNativeLightSleep PreciseTimePlatformLightSleep;
+#endif
+
+/**
+ * @brief Veille simulée sur l'horloge virtuelle, pour tester la
+ *        compensation et la ponctualité du réveil
+ *
+ * Par défaut le compteur est figé pendant la veille, comme le timer
+ * group de l'ESP32 : seule la compensation (Backend::skip()) fait
+ * avancer le temps virtuel et déclenche les timers échus. Le réveil
+ * arrive wake_error_us après la durée demandée (négatif : en avance),
+ * et l'horloge de référence mesure la veille avec reference_error_us
+ * d'erreur. Avec counter_runs, le compteur avance lui-même pendant la
+ * veille : la compensation ne doit alors rien ajouter.
+ */
+struct PreciseTimeSimLightSleep {
+    static const uint32_t MIN_SLEEP_US = 1;
+    static const uint32_t WAKE_MARGIN_US = 0;
+
+    struct State {
+        int32_t wake_error_us;
+        int32_t reference_error_us;
+        bool counter_runs;
+        uint32_t sleeps;
+        uint64_t requested_us;      // Dernière durée demandée
+        uint64_t slept_us;          // Cumul des durées réelles
+    };
+
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+
+    static uint64_t sleep(uint64_t micros) {
+        State& s = state();
+        int64_t actual = (int64_t)micros + s.wake_error_us;
+        if (actual < 0) actual = 0;
+        s.sleeps++;
+        s.requested_us = micros;
+        s.slept_us += (uint64_t)actual;
+        if (s.counter_runs) PreciseTimeSimBackend::advance((uint64_t)actual);
+        int64_t measured = actual + s.reference_error_us;
+        return measured > 0 ? (uint64_t)measured : 0;
+    }
+
+    static void configure(int32_t wake_error_us, bool counter_runs = false,
+                          int32_t reference_error_us = 0) {
+        State& s = state();
+        s.wake_error_us = wake_error_us;
+        s.reference_error_us = reference_error_us;
+        s.counter_runs = counter_runs;
+        s.sleeps = 0;
+        s.requested_us = 0;
+        s.slept_us = 0;
+    }
+};
+
+/**
+ * @brief Primitive de veille utilisée pour un backend donné
+ */
+template <class Backend>
+struct PreciseTimeLightSleepFor {
+    typedef PreciseTimePlatformLightSleep type;
+};
+
+template <>
+struct PreciseTimeLightSleepFor<PreciseTimeSimBackend> {
+    typedef PreciseTimeSimLightSleep type;
+};
+
+#endif // PRECISE_TIME_LIGHT_SLEEP_H
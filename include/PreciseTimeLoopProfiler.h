@@ -0,0 +1,282 @@
+/**
+ * @file PreciseTimeLoopProfiler.h
+ * @brief Profil de loop() : durée des itérations, gigue, histogramme et
+ *        dépassements de budget
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_LOOP_PROFILER_H
+#define PRECISE_TIME_LOOP_PROFILER_H
+
+#include "PreciseTime.h"
+#include "PreciseTimeHistogram.h"
+
+/**
+ * @brief Profil des itérations de loop()
+ *
+ * tick() est appelé une fois par itération, au même endroit (typiquement
+ * en tête de loop()) : la durée d'une itération est l'intervalle entre
+ * deux tick(), la gigue l'écart absolu entre deux durées successives.
+ * Une itération plus longue que le budget est un dépassement ; les WORST
+ * plus longues sont conservées avec leur date et l'étiquette posée par
+ * label() pendant l'itération (la tâche qui a pris du temps).
+ *
+ * tick() ne fait ni division ni allocation : une lecture d'horloge, une
+ * conversion en µs résolue à la compilation, un record() d'histogramme
+ * et quelques comparaisons. Les moyennes sont calculées à la lecture.
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam WORST Nombre de pires itérations conservées
+ * @tparam Histogram Histogramme des durées en µs
+ */
+template <class Time = PreciseTime, unsigned WORST = 4,
+          class Histogram = PreciseTimeLatencyHistogram<> >
+class PreciseTimeLoopProfiler {
+public:
+    /**
+     * @brief Une des pires itérations
+     */
+    struct Offender {
+        uint32_t duration;      ///< Durée en µs
+        uint64_t at;            ///< Fin de l'itération, en µs de Time
+        const char* label;      ///< Étiquette posée par label(), ou nullptr
+    };
+
+private:
+    uint64_t last_tick;
+    uint32_t budget;
+    uint32_t last_duration;
+    uint32_t iteration_count;
+    uint32_t overrun_count;
+    uint32_t min_duration;
+    uint32_t max_duration;
+    uint32_t max_jitter;
+    uint64_t duration_sum;
+    uint64_t jitter_sum;
+    const char* current_label;
+    bool started;
+    unsigned offender_count;
+    Offender offenders[WORST];
+    Histogram durations;
+
+    static uint64_t toMicros(uint64_t ticks) {
+        return PreciseTimeConvert<Time::TICKS_PER_SECOND, 1000000ULL>::apply(ticks);
+    }
+
+    // Insertion dans offenders[], triés du plus long au plus court
+    void keepWorst(uint32_t duration, uint64_t now) {
+        unsigned i = offender_count < WORST ? offender_count++ : WORST - 1;
+        while (i > 0 && offenders[i - 1].duration < duration) {
+            offenders[i] = offenders[i - 1];
+            i--;
+        }
+        offenders[i].duration = duration;
+        offenders[i].at = toMicros(now);
+        offenders[i].label = current_label;
+    }
+
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+    static size_t appendNumber(char* out, uint64_t value) {
+        return PreciseTimeFormatter::appendUnsigned(out, value);
+    }
+
+public:
+    static_assert(WORST >= 1, "WORST doit valoir au moins 1");
+
+    /**
+     * @param budget_us Durée d'itération tolérée en µs (0 : pas de budget)
+     */
+    explicit PreciseTimeLoopProfiler(uint32_t budget_us = 0) : budget(budget_us) {
+        reset();
+    }
+
+    /**
+     * @brief Oublie les mesures ; le prochain tick() redémarre la mesure
+     */
+    void reset() {
+        last_tick = 0;
+        last_duration = 0;
+        iteration_count = 0;
+        overrun_count = 0;
+        min_duration = UINT32_MAX;
+        max_duration = 0;
+        max_jitter = 0;
+        duration_sum = 0;
+        jitter_sum = 0;
+        current_label = nullptr;
+        started = false;
+        offender_count = 0;
+        for (unsigned i = 0; i < WORST; i++) {
+            offenders[i].duration = 0;
+            offenders[i].at = 0;
+            offenders[i].label = nullptr;
+        }
+        durations.reset();
+    }
+
+    void setBudget(uint32_t budget_us) { budget = budget_us; }
+    uint32_t getBudget() const { return budget; }
+
+    /**
+     * @brief Étiquette l'itération en cours (chaîne statique) ; la dernière
+     *        posée avant tick() est retenue
+     */
+    inline void label(const char* name) {
+        current_label = name;
+    }
+
+    /**
+     * @brief À appeler une fois par itération de loop()
+     */
+    inline void tick() {
+        uint64_t now = Time::getTicks();
+        if (!started) {
+            started = true;
+            last_tick = now;
+            current_label = nullptr;
+            return;
+        }
+        uint64_t elapsed = toMicros(now - last_tick);
+        uint32_t duration = elapsed < UINT32_MAX ? (uint32_t)elapsed : UINT32_MAX;
+        last_tick = now;
+
+        if (iteration_count > 0) {
+            uint32_t jitter = duration > last_duration ? duration - last_duration
+                                                       : last_duration - duration;
+            jitter_sum += jitter;
+            if (jitter > max_jitter) max_jitter = jitter;
+        }
+        last_duration = duration;
+        iteration_count++;
+        duration_sum += duration;
+        if (duration < min_duration) min_duration = duration;
+        if (duration > max_duration) max_duration = duration;
+        if (budget != 0 && duration > budget) overrun_count++;
+        if (offender_count < WORST || duration > offenders[WORST - 1].duration) {
+            keepWorst(duration, now);
+        }
+        durations.record(duration);
+        current_label = nullptr;
+    }
+
+    uint32_t iterations() const { return iteration_count; }
+    uint32_t overruns() const { return overrun_count; }
+    uint32_t lastDuration() const { return last_duration; }
+    uint32_t minDuration() const { return iteration_count ? min_duration : 0; }
+    uint32_t maxDuration() const { return max_duration; }
+    uint32_t meanDuration() const {
+        return iteration_count ? (uint32_t)(duration_sum / iteration_count) : 0;
+    }
+    uint32_t maxJitter() const { return max_jitter; }
+    uint32_t meanJitter() const {
+        return iteration_count > 1 ? (uint32_t)(jitter_sum / (iteration_count - 1)) : 0;
+    }
+
+    const Histogram& histogram() const { return durations; }
+
+    /**
+     * @brief Pires itérations retenues (au plus WORST)
+     */
+    unsigned worstCount() const { return offender_count; }
+
+    const Offender& worst(unsigned index) const { return offenders[index]; }
+
+    /**
+     * @brief Rapport texte, durées en microsecondes :
+     *        "loop : N itérations, moy X us, min X, max X, gigue moy X, max X"
+     *        "budget X us : N dépassements"
+     *        "p50 X us, p99 X, p99.9 X"
+     *        "pire 1 : X us à T us (étiquette)"...
+     *
+     * `out` est un Print& ou tout objet fournissant write(const uint8_t*, size_t).
+     * @return Octets écrits
+     */
+    template <class Output>
+    size_t report(Output& out) const {
+        char line[160];
+        size_t written = 0;
+        size_t length = appendText(line, "loop : ");
+        length += appendNumber(line + length, iteration_count);
+        length += appendText(line + length, " itérations");
+        if (iteration_count > 0) {
+            length += appendText(line + length, ", moy ");
+            length += appendNumber(line + length, meanDuration());
+            length += appendText(line + length, " us, min ");
+            length += appendNumber(line + length, minDuration());
+            length += appendText(line + length, ", max ");
+            length += appendNumber(line + length, max_duration);
+            length += appendText(line + length, ", gigue moy ");
+            length += appendNumber(line + length, meanJitter());
+            length += appendText(line + length, ", max ");
+            length += appendNumber(line + length, max_jitter);
+        }
+        line[length++] = '\n';
+        written += out.write((const uint8_t*)line, length);
+
+        if (budget != 0) {
+            length = appendText(line, "budget ");
+            length += appendNumber(line + length, budget);
+            length += appendText(line + length, " us : ");
+            length += appendNumber(line + length, overrun_count);
+            length += appendText(line + length, " dépassements\n");
+            written += out.write((const uint8_t*)line, length);
+        }
+        if (iteration_count == 0) return written;
+
+        length = appendText(line, "p50 ");
+        length += appendNumber(line + length, durations.valueAtPercentile(50.0));
+        length += appendText(line + length, " us, p99 ");
+        length += appendNumber(line + length, durations.valueAtPercentile(99.0));
+        length += appendText(line + length, ", p99.9 ");
+        length += appendNumber(line + length, durations.valueAtPercentile(99.9));
+        line[length++] = '\n';
+        written += out.write((const uint8_t*)line, length);
+
+        for (unsigned i = 0; i < offender_count; i++) {
+            length = appendText(line, "pire ");
+            length += appendNumber(line + length, i + 1);
+            length += appendText(line + length, " : ");
+            length += appendNumber(line + length, offenders[i].duration);
+            length += appendText(line + length, " us à ");
+            length += appendNumber(line + length, offenders[i].at);
+            length += appendText(line + length, " us");
+            if (offenders[i].label != nullptr) {
+                length += appendText(line + length, " (");
+                const char* name = offenders[i].label;
+                for (size_t k = 0; name[k] != '\0' && k < 48; k++) line[length++] = name[k];
+                line[length++] = ')';
+            }
+            line[length++] = '\n';
+            written += out.write((const uint8_t*)line, length);
+        }
+        return written;
+    }
+};
+
+#endif // PRECISE_TIME_LOOP_PROFILER_H
@@ -0,0 +1,268 @@
+/**
+ * @file PreciseTimeScheduler.h
+ * @brief Ordonnanceur coopératif : tâches périodiques sans dérive et tâches
+ *        uniques, appelées depuis loop()
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_SCHEDULER_H
+#define PRECISE_TIME_SCHEDULER_H
+
+#include "PreciseTime.h"
+
+/**
+ * @brief Conduite d'une tâche périodique en retard d'une période ou plus
+ */
+enum PreciseTimeOverrunPolicy {
+    PRECISE_TIME_CATCH_UP,      ///< Exécute chaque période manquée, une par run()
+    PRECISE_TIME_SKIP           ///< Saute les périodes manquées (comptées dans skipped())
+};
+
+/**
+ * @brief Ordonnanceur coopératif à table fixe
+ *
+ * Chaque tâche a une échéance absolue en µs de Time. Une tâche périodique
+ * est replanifiée à échéance + période, et non à l'instant d'exécution :
+ * le retard d'une exécution ne se reporte pas sur les suivantes, il n'y a
+ * pas de dérive cumulée (contrairement à `last = now`). Avec
+ * PRECISE_TIME_SKIP, les périodes manquées sont sautées mais l'échéance
+ * reste sur la même grille.
+ *
+ * run() exécute chaque tâche échue au plus une fois, dans l'ordre de la
+ * table : une tâche en retard de plusieurs périodes (PRECISE_TIME_CATCH_UP)
+ * rattrape sur les appels suivants sans affamer les autres. Un rappel peut
+ * ajouter ou annuler des tâches, y compris la sienne.
+ *
+ * Un TaskId porte l'indice de l'emplacement et sa génération, incrémentée
+ * à chaque réutilisation : l'identifiant d'une tâche terminée ou annulée
+ * ne désigne jamais la tâche qui a repris son emplacement.
+ *
+ * Coût : O(MAX_TASKS) par run(), sans allocation ni division hors
+ * rattrapage. Non synchronisé : tout depuis un seul contexte.
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam MAX_TASKS Nombre de tâches simultanées
+ */
+template <class Time = PreciseTime, unsigned MAX_TASKS = 16>
+class PreciseTimeScheduler {
+public:
+    typedef void (*Callback)(void* context);
+    typedef int TaskId;                     ///< Génération × MAX_TASKS + indice, -1 si invalide
+
+    static const TaskId INVALID_TASK = -1;
+
+private:
+    // Générations possibles d'un emplacement sans rendre le TaskId négatif
+    static const uint32_t GENERATIONS = (uint32_t)INT32_MAX / MAX_TASKS;
+
+    struct Task {
+        uint64_t deadline;
+        uint64_t period;                    // 0 : tâche unique
+        Callback callback;
+        void* context;
+        uint32_t run_count;
+        uint32_t skipped_count;
+        uint32_t max_lateness;
+        uint32_t generation;
+        PreciseTimeOverrunPolicy policy;
+        bool active;
+    };
+
+    Task tasks[MAX_TASKS];
+
+    // Emplacement désigné par `id`, nullptr s'il a été réutilisé depuis
+    const Task* slot(TaskId id) const {
+        if (id < 0) return nullptr;
+        const Task& task = tasks[(uint32_t)id % MAX_TASKS];
+        return task.generation == (uint32_t)id / MAX_TASKS ? &task : nullptr;
+    }
+
+    bool valid(TaskId id) const {
+        const Task* task = slot(id);
+        return task != nullptr && task->active;
+    }
+
+public:
+    static_assert(MAX_TASKS >= 1, "MAX_TASKS doit valoir au moins 1");
+
+    PreciseTimeScheduler() {
+        // Les générations survivent à clear() : les anciens TaskId restent périmés
+        for (unsigned i = 0; i < MAX_TASKS; i++) tasks[i].generation = 0;
+        clear();
+    }
+
+    /**
+     * @brief Tâche périodique de première échéance `first_us` (µs de Time)
+     * @param period_us Période en µs ; 0 pour une tâche unique
+     * @return Identifiant, ou INVALID_TASK si la table est pleine
+     */
+    TaskId schedule(uint64_t first_us, uint64_t period_us, Callback callback,
+                    void* context = nullptr,
+                    PreciseTimeOverrunPolicy policy = PRECISE_TIME_CATCH_UP) {
+        for (unsigned i = 0; i < MAX_TASKS; i++) {
+            Task& task = tasks[i];
+            if (task.active) continue;
+            task.deadline = first_us;
+            task.period = period_us;
+            task.callback = callback;
+            task.context = context;
+            task.run_count = 0;
+            task.skipped_count = 0;
+            task.max_lateness = 0;
+            task.generation = task.generation + 1 < GENERATIONS ? task.generation + 1 : 0;
+            task.policy = policy;
+            task.active = true;
+            return (TaskId)(task.generation * MAX_TASKS + i);
+        }
+        return INVALID_TASK;
+    }
+
+    /**
+     * @brief Tâche périodique, première exécution une période après maintenant
+     */
+    TaskId every(uint64_t period_us, Callback callback, void* context = nullptr,
+                 PreciseTimeOverrunPolicy policy = PRECISE_TIME_CATCH_UP) {
+        return schedule(Time::getMicroseconds() + period_us, period_us, callback, context, policy);
+    }
+
+    /**
+     * @brief Tâche unique dans `delay_us` microsecondes
+     */
+    TaskId after(uint64_t delay_us, Callback callback, void* context = nullptr) {
+        return schedule(Time::getMicroseconds() + delay_us, 0, callback, context);
+    }
+
+    /**
+     * @brief Tâche unique à l'instant absolu `deadline_us` (µs de Time)
+     */
+    TaskId at(uint64_t deadline_us, Callback callback, void* context = nullptr) {
+        return schedule(deadline_us, 0, callback, context);
+    }
+
+    bool cancel(TaskId id) {
+        if (!valid(id)) return false;
+        tasks[(uint32_t)id % MAX_TASKS].active = false;
+        return true;
+    }
+
+    /**
+     * @brief Exécute les tâches échues à `now_us` (µs de Time)
+     * @return Nombre de tâches exécutées
+     */
+    uint32_t run(uint64_t now_us) {
+        uint32_t executed = 0;
+        for (unsigned i = 0; i < MAX_TASKS; i++) {
+            Task& task = tasks[i];
+            if (!task.active || task.deadline > now_us) continue;
+
+            uint64_t lateness = now_us - task.deadline;
+            if (task.period == 0) {
+                task.active = false;
+            } else {
+                task.deadline += task.period;
+                if (task.policy == PRECISE_TIME_SKIP && task.deadline <= now_us) {
+                    uint64_t missed = (now_us - task.deadline) / task.period + 1;
+                    task.deadline += missed * task.period;
+                    task.skipped_count += (uint32_t)missed;
+                }
+            }
+            task.run_count++;
+            if (lateness > task.max_lateness) {
+                task.max_lateness = lateness < UINT32_MAX ? (uint32_t)lateness : UINT32_MAX;
+            }
+            // État mis à jour avant l'appel : le rappel peut se replanifier
+            task.callback(task.context);
+            executed++;
+        }
+        return executed;
+    }
+
+    /**
+     * @brief run() à l'instant présent de Time, à appeler dans loop()
+     */
+    uint32_t run() {
+        return run(Time::getMicroseconds());
+    }
+
+    /**
+     * @brief Prochaine échéance en µs de Time, UINT64_MAX sans tâche
+     */
+    uint64_t nextDeadline() const {
+        uint64_t best = UINT64_MAX;
+        for (unsigned i = 0; i < MAX_TASKS; i++) {
+            if (tasks[i].active && tasks[i].deadline < best) best = tasks[i].deadline;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Décale toutes les échéances quand l'horloge saute de `from_us`
+     *        à `to_us` (Time::reset()) ; les phases relatives sont conservées
+     *
+     *     uint64_t before = PreciseTime::getMicroseconds();
+     *     PreciseTime::reset();
+     *     scheduler.rebase(before, PreciseTime::getMicroseconds());
+     */
+    void rebase(uint64_t from_us, uint64_t to_us) {
+        for (unsigned i = 0; i < MAX_TASKS; i++) {
+            Task& task = tasks[i];
+            if (!task.active) continue;
+            task.deadline = task.deadline > from_us ? task.deadline - from_us + to_us : to_us;
+        }
+    }
+
+    void clear() {
+        for (unsigned i = 0; i < MAX_TASKS; i++) {
+            tasks[i].active = false;
+            tasks[i].run_count = 0;
+            tasks[i].skipped_count = 0;
+            tasks[i].max_lateness = 0;
+        }
+    }
+
+    bool isActive(TaskId id) const { return valid(id); }
+    uint64_t deadline(TaskId id) const { return valid(id) ? slot(id)->deadline : UINT64_MAX; }
+
+    /**
+     * @brief Exécutions, périodes sautées et plus grand retard (µs) d'une
+     *        tâche ; conservés pour une tâche unique jusqu'à réutilisation
+     *        de son emplacement
+     */
+    uint32_t runs(TaskId id) const { return slot(id) ? slot(id)->run_count : 0; }
+    uint32_t skipped(TaskId id) const { return slot(id) ? slot(id)->skipped_count : 0; }
+    uint32_t maxLateness(TaskId id) const { return slot(id) ? slot(id)->max_lateness : 0; }
+
+    unsigned activeCount() const {
+        unsigned count = 0;
+        for (unsigned i = 0; i < MAX_TASKS; i++) count += tasks[i].active ? 1 : 0;
+        return count;
+    }
+};
+
+template <class Time, unsigned MAX_TASKS>
+const typename PreciseTimeScheduler<Time, MAX_TASKS>::TaskId PreciseTimeScheduler<Time, MAX_TASKS>::INVALID_TASK;
+
+/**
+ * @brief Ordonnanceur sur PreciseTime, 16 tâches
+ */
+typedef PreciseTimeScheduler<> PreciseScheduler;
+
+#endif // PRECISE_TIME_SCHEDULER_H
@@ -0,0 +1,276 @@
+/**
+ * @file PreciseTimeScope.h
+ * @brief Chronométrage de portée (RAII) avec statistiques par site d'appel
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_SCOPE_H
+#define PRECISE_TIME_SCOPE_H
+
+#include "PreciseTime.h"
+
+#if !defined(ARDUINO) || defined(ESP32) || defined(ESP8266)
+#include <atomic>
+#define PRECISE_TIME_SCOPE_ATOMIC_REGISTRY
+#endif
+
+// Nombre maximal de sites enregistrés par horloge
+#ifndef PRECISE_TIME_SCOPE_MAX_SITES
+#define PRECISE_TIME_SCOPE_MAX_SITES  32
+#endif
+
+template <class Time> class PreciseTimeScopeRegistry;
+
+/**
+ * @brief Statistiques d'un site PRECISE_SCOPE, en ticks de l'horloge Time
+ *
+ * Créé une seule fois (variable statique locale) et inscrit dans le
+ * registre à sa construction. Les mises à jour ne sont pas synchronisées :
+ * un site ne doit être traversé que depuis un seul contexte à la fois.
+ */
+template <class Time>
+struct PreciseTimeScopeSite {
+    const char* name;
+    uint32_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+    uint64_t last;
+
+    explicit PreciseTimeScopeSite(const char* site_name)
+        : name(site_name), count(0), total(0), min(UINT64_MAX), max(0), last(0) {
+        PreciseTimeScopeRegistry<Time>::add(this);
+    }
+
+    inline void record(uint64_t elapsed) {
+        count++;
+        total += elapsed;
+        last = elapsed;
+        if (elapsed < min) min = elapsed;
+        if (elapsed > max) max = elapsed;
+    }
+
+    void clear() {
+        count = 0;
+        total = 0;
+        min = UINT64_MAX;
+        max = 0;
+        last = 0;
+    }
+};
+
+/**
+ * @brief Mesure la durée de sa portée et l'ajoute à un site
+ */
+template <class Time>
+class PreciseTimeScopedTimer {
+private:
+    PreciseTimeScopeSite<Time>& site;
+    uint64_t start;
+
+public:
+    explicit PreciseTimeScopedTimer(PreciseTimeScopeSite<Time>& target)
+        : site(target), start(Time::getTicks()) {}
+
+    ~PreciseTimeScopedTimer() {
+        site.record(Time::getTicks() - start);
+    }
+
+    PreciseTimeScopedTimer(const PreciseTimeScopedTimer&) = delete;
+    PreciseTimeScopedTimer& operator=(const PreciseTimeScopedTimer&) = delete;
+};
+
+/**
+ * @brief Table fixe des sites d'une horloge, sans allocation
+ *
+ * Au-delà de PRECISE_TIME_SCOPE_MAX_SITES, les sites mesurent toujours
+ * mais ne sont plus listés ; dropped() les compte.
+ *
+ * add() réserve un emplacement (claimed), y range le site, puis avance
+ * published au-delà de tous les emplacements remplis sans trou. Les
+ * lecteurs ne parcourent que [0, size()) = [0, published) : un site
+ * inscrit en même temps depuis un autre cœur ou une ISR n'y apparaît
+ * qu'une fois son pointeur écrit.
+ */
+template <class Time>
+class PreciseTimeScopeRegistry {
+private:
+    typedef PreciseTimeScopeSite<Time> Site;
+
+#if defined(PRECISE_TIME_SCOPE_ATOMIC_REGISTRY)
+    typedef std::atomic<Site*> Entry;
+    typedef std::atomic<uint32_t> Counter;
+#else
+    typedef Site* Entry;
+    typedef uint32_t Counter;
+#endif
+
+    static Entry* table() {
+        static Entry sites[PRECISE_TIME_SCOPE_MAX_SITES];
+        return sites;
+    }
+
+    // Emplacement publié : size() a déjà ordonné sa lecture
+    static Site* entry(uint32_t index) {
+#if defined(PRECISE_TIME_SCOPE_ATOMIC_REGISTRY)
+        return table()[index].load(std::memory_order_relaxed);
+#else
+        return table()[index];
+#endif
+    }
+
+    static Counter& claimed() {
+        static Counter slots(0);
+        return slots;
+    }
+
+    static Counter& published() {
+        static Counter slots(0);
+        return slots;
+    }
+
+    static uint64_t toMicros(uint64_t ticks) {
+        return PreciseTimeConvert<Time::TICKS_PER_SECOND, 1000000ULL>::apply(ticks);
+    }
+
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+public:
+    static void add(Site* site) {
+#if defined(PRECISE_TIME_SCOPE_ATOMIC_REGISTRY)
+        uint32_t slot = claimed().fetch_add(1, std::memory_order_relaxed);
+        if (slot >= PRECISE_TIME_SCOPE_MAX_SITES) return;
+        table()[slot].store(site, std::memory_order_release);
+        // Publie les emplacements remplis dans l'ordre ; celui qui remplit
+        // le premier trou publie aussi ceux des add() déjà terminés derrière
+        uint32_t ready = published().load(std::memory_order_acquire);
+        while (ready < PRECISE_TIME_SCOPE_MAX_SITES
+               && table()[ready].load(std::memory_order_acquire) != nullptr) {
+            if (published().compare_exchange_weak(ready, ready + 1, std::memory_order_release,
+                                                  std::memory_order_acquire)) {
+                ready++;
+            }
+        }
+#else
+        uint32_t slot = claimed()++;
+        if (slot >= PRECISE_TIME_SCOPE_MAX_SITES) return;
+        table()[slot] = site;
+        published() = slot + 1;
+#endif
+    }
+
+    static uint32_t size() {
+#if defined(PRECISE_TIME_SCOPE_ATOMIC_REGISTRY)
+        return published().load(std::memory_order_acquire);
+#else
+        return published();
+#endif
+    }
+
+    static uint32_t dropped() {
+        uint32_t used = claimed();
+        return used > PRECISE_TIME_SCOPE_MAX_SITES ? used - PRECISE_TIME_SCOPE_MAX_SITES : 0;
+    }
+
+    static const Site& site(uint32_t index) {
+        return *entry(index);
+    }
+
+    /**
+     * @brief Site nommé `name` (comparaison de chaînes), nullptr sinon
+     */
+    static const Site* find(const char* name) {
+        for (uint32_t i = 0; i < size(); i++) {
+            const char* a = entry(i)->name;
+            const char* b = name;
+            while (*a != '\0' && *a == *b) { a++; b++; }
+            if (*a == *b) return entry(i);
+        }
+        return nullptr;
+    }
+
+    static void clearAll() {
+        for (uint32_t i = 0; i < size(); i++) entry(i)->clear();
+    }
+
+    /**
+     * @brief Une ligne par site, durées en microsecondes :
+     *        "nom : N appels, moy X us, min X, max X, dernier X"
+     *
+     * `out` est un Print& ou tout objet fournissant write(const uint8_t*, size_t).
+     * @return Octets écrits
+     */
+    template <class Output>
+    static size_t dump(Output& out) {
+        size_t written = 0;
+        for (uint32_t i = 0; i < size(); i++) {
+            const Site& s = *entry(i);
+            char line[256];
+            size_t length = 0;
+            const char* name = s.name;
+            while (*name != '\0' && length < 64) line[length++] = *name++;
+            length += appendText(line + length, " : ");
+            length += PreciseTimeFormatter::appendUnsigned(line + length, s.count);
+            length += appendText(line + length, " appels");
+            if (s.count > 0) {
+                length += appendText(line + length, ", moy ");
+                length += PreciseTimeFormatter::appendUnsigned(line + length, toMicros(s.total / s.count));
+                length += appendText(line + length, " us, min ");
+                length += PreciseTimeFormatter::appendUnsigned(line + length, toMicros(s.min));
+                length += appendText(line + length, ", max ");
+                length += PreciseTimeFormatter::appendUnsigned(line + length, toMicros(s.max));
+                length += appendText(line + length, ", dernier ");
+                length += PreciseTimeFormatter::appendUnsigned(line + length, toMicros(s.last));
+            }
+            line[length++] = '\n';
+            written += out.write((const uint8_t*)line, length);
+        }
+        return written;
+    }
+};
+
+#define PRECISE_SCOPE_CONCAT_(a, b) a##b
+#define PRECISE_SCOPE_CONCAT(a, b) PRECISE_SCOPE_CONCAT_(a, b)
+
+#define PRECISE_SCOPE_SITE_(Time, name, id)                                      \
+    static PreciseTimeScopeSite<Time> PRECISE_SCOPE_CONCAT(precise_scope_site_, id)(name); \
+    PreciseTimeScopedTimer<Time> PRECISE_SCOPE_CONCAT(precise_scope_timer_, id)( \
+        PRECISE_SCOPE_CONCAT(precise_scope_site_, id))
+
+/**
+ * @brief Chronomètre la fin de la portée courante sous le nom `name`
+ *        (chaîne littérale), sur l'horloge Time
+ */
+#define PRECISE_SCOPE_CLOCK(Time, name) PRECISE_SCOPE_SITE_(Time, name, __COUNTER__)
+
+/**
+ * @brief Chronomètre la fin de la portée courante sur PreciseTime
+ */
+#define PRECISE_SCOPE(name) PRECISE_SCOPE_CLOCK(PreciseTime, name)
+
+#endif // PRECISE_TIME_SCOPE_H
@@ -0,0 +1,84 @@
+/**
+ * @file PreciseTimeSeqlock.h
+ * @brief Compteur 64 bits lisible sans verrou (seqlock) sur cible 32 bits
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_SEQLOCK_H
+#define PRECISE_TIME_SEQLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+#include "PreciseTimeInline.h"
+
+/**
+ * @brief Valeur 64 bits protégée par un numéro de séquence
+ *
+ * Les 64 bits sont rangés en deux mots de 32 bits : sur Xtensa un
+ * std::atomic<uint64_t> passerait par les verrous de libatomic. L'écrivain
+ * rend la séquence impaire, écrit les deux mots puis la rend paire ; un
+ * lecteur recommence tant que la séquence est impaire ou a changé pendant
+ * sa lecture. Les lecteurs ne bloquent donc ni l'écrivain ni les autres
+ * lecteurs.
+ *
+ * Les écrivains doivent être sérialisés par l'appelant (l'ISR et reset()
+ * partagent timerMux) ; seule la lecture est sans verrou. Les méthodes
+ * sont inlinées de force : timerISR() (IRAM) appelle increment().
+ */
+class PreciseTimeSeqlock64 {
+private:
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> low;
+    std::atomic<uint32_t> high;
+
+public:
+    constexpr PreciseTimeSeqlock64() : sequence(0), low(0), high(0) {}
+
+    PRECISE_TIME_FORCE_INLINE uint64_t load() const {
+        uint32_t seq_begin, seq_end, lo, hi;
+        do {
+            seq_begin = sequence.load(std::memory_order_acquire);
+            lo = low.load(std::memory_order_relaxed);
+            hi = high.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq_end = sequence.load(std::memory_order_relaxed);
+        } while ((seq_begin & 1) || seq_begin != seq_end);
+        return ((uint64_t)hi << 32) | lo;
+    }
+
+    PRECISE_TIME_FORCE_INLINE void store(uint64_t value) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        low.store((uint32_t)value, std::memory_order_relaxed);
+        high.store((uint32_t)(value >> 32), std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // L'écrivain connaît déjà la valeur courante : pas besoin de boucler.
+    PRECISE_TIME_FORCE_INLINE void increment() {
+        uint64_t value = ((uint64_t)high.load(std::memory_order_relaxed) << 32)
+                         | low.load(std::memory_order_relaxed);
+        store(value + 1);
+    }
+};
+
+#endif // PRECISE_TIME_SEQLOCK_H
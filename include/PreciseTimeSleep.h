@@ -0,0 +1,202 @@
+/**
+ * @file PreciseTimeSleep.h
+ * @brief Attente précise hybride : phase grossière qui rend la main, puis
+ *        fin en attente active, marge ajustée sur les réveils observés
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_SLEEP_H
+#define PRECISE_TIME_SLEEP_H
+
+#include <stdint.h>
+#include "PreciseTimeBackendSim.h"
+
+#if !defined(ARDUINO)
+#include <time.h>
+#endif
+
+// Marge initiale avant l'échéance où l'attente passe en boucle active (µs)
+#ifndef PRECISE_TIME_SLEEP_MARGIN_US
+#define PRECISE_TIME_SLEEP_MARGIN_US  100
+#endif
+
+// Bornes de la marge ajustée (µs)
+#ifndef PRECISE_TIME_SLEEP_MIN_MARGIN_US
+#define PRECISE_TIME_SLEEP_MIN_MARGIN_US  2
+#endif
+
+#ifndef PRECISE_TIME_SLEEP_MAX_MARGIN_US
+#define PRECISE_TIME_SLEEP_MAX_MARGIN_US  5000
+#endif
+
+/**
+ * @brief Primitive qui rend la main pendant la phase grossière
+ *
+ * ESP32 : vTaskDelay() (tick FreeRTOS, 1 ms par défaut) ; ESP8266 et
+ * Arduino générique : delay() en millisecondes, qui appelle yield() ;
+ * natif : nanosleep(). sleep() peut réveiller plus tôt ou plus tard que
+ * demandé : l'appelant relit l'horloge.
+ */
+struct PreciseTimeYield {
+#if defined(ESP32)
+    static const uint32_t GRANULARITY_US = 1000000UL / configTICK_RATE_HZ;
+
+    static void sleep(uint64_t micros) {
+        vTaskDelay((TickType_t)(micros / GRANULARITY_US));
+    }
+#elif defined(ARDUINO)
+    static const uint32_t GRANULARITY_US = 1000;
+
+    static void sleep(uint64_t micros) {
+        delay((unsigned long)(micros / 1000));
+    }
+#else
+    static const uint32_t GRANULARITY_US = 1;
+
+    static void sleep(uint64_t micros) {
+        struct timespec pause;
+        pause.tv_sec = (time_t)(micros / 1000000ULL);
+        pause.tv_nsec = (long)(micros % 1000000ULL) * 1000L;
+        nanosleep(&pause, nullptr);
+    }
+#endif
+
+    static inline void spin() {}
+};
+
+/**
+ * @brief Sur l'horloge virtuelle, attendre fait avancer le temps
+ */
+struct PreciseTimeSimYield {
+    static const uint32_t GRANULARITY_US = 1;
+
+    static void sleep(uint64_t micros) {
+        PreciseTimeSimBackend::advance(micros);
+    }
+
+    static void spin() {
+        PreciseTimeSimBackend::advance(1);
+    }
+};
+
+/**
+ * @brief Primitive d'attente utilisée pour un backend donné
+ */
+template <class Backend>
+struct PreciseTimeYieldFor {
+    typedef PreciseTimeYield type;
+};
+
+template <>
+struct PreciseTimeYieldFor<PreciseTimeSimBackend> {
+    typedef PreciseTimeSimYield type;
+};
+
+/**
+ * @brief Ajuste une marge d'anticipation sur le retard `late` d'un réveil
+ *
+ * La marge monte aussitôt à 1,25 × un retard qui la dépasse, et redescend
+ * de 1/16 de l'écart à chaque réveil plus ponctuel ; bornée à [lo, hi].
+ */
+inline void preciseTimeTrackMargin(uint32_t& margin, uint64_t late, uint32_t lo, uint32_t hi) {
+    uint64_t wanted = late + late / 4;
+    if (wanted < lo) wanted = lo;
+    if (wanted > hi) wanted = hi;
+    if (wanted > margin) {
+        margin = (uint32_t)wanted;
+    } else {
+        margin -= (uint32_t)((margin - wanted) >> 4);
+    }
+}
+
+/**
+ * @brief Attente jusqu'à une échéance en µs de Time
+ *
+ * Tant que l'échéance est à plus de margin() µs, Yield::sleep() rend la
+ * main pour (reste - marge), arrondi à sa granularité ; ensuite la fin se
+ * fait en boucle active sur Time::getMicroseconds(). Le retard de chaque
+ * réveil de Yield::sleep() sur la durée demandée ajuste la marge
+ * (preciseTimeTrackMargin()). La marge est partagée par tous les
+ * appelants d'un même couple (Time, Yield).
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam Yield Primitive d'attente (sleep(), spin(), GRANULARITY_US)
+ */
+template <class Time, class Yield>
+class PreciseTimeSleeper {
+private:
+    static uint32_t& margin_us() {
+        static uint32_t margin = PRECISE_TIME_SLEEP_MARGIN_US;
+        return margin;
+    }
+
+public:
+    /**
+     * @brief Attend jusqu'à `deadline_us` (µs de Time)
+     * @return Retard du réveil en µs (0 si à l'heure ou déjà passée)
+     */
+    static uint64_t until(uint64_t deadline_us) {
+        uint64_t now = Time::getMicroseconds();
+        bool yielded = false;
+        while (now < deadline_us) {
+            uint64_t remaining = deadline_us - now;
+            uint32_t margin = margin_us();
+            if (remaining <= margin || remaining - margin < Yield::GRANULARITY_US) {
+                // Seule la marge a empêché de rendre la main : elle décroît,
+                // sans quoi un unique réveil très tardif la figerait
+                if (!yielded && remaining >= Yield::GRANULARITY_US) {
+                    preciseTimeTrackMargin(margin_us(), 0, PRECISE_TIME_SLEEP_MIN_MARGIN_US,
+                                           PRECISE_TIME_SLEEP_MAX_MARGIN_US);
+                }
+                while (Time::getMicroseconds() < deadline_us) Yield::spin();
+                break;
+            }
+            uint64_t requested = remaining - margin;
+            requested -= requested % Yield::GRANULARITY_US;
+            Yield::sleep(requested);
+            yielded = true;
+            uint64_t woke = Time::getMicroseconds();
+            uint64_t late = woke - now > requested ? woke - now - requested : 0;
+            preciseTimeTrackMargin(margin_us(), late, PRECISE_TIME_SLEEP_MIN_MARGIN_US,
+                                   PRECISE_TIME_SLEEP_MAX_MARGIN_US);
+            now = woke;
+        }
+        now = Time::getMicroseconds();
+        return now > deadline_us ? now - deadline_us : 0;
+    }
+
+    static uint64_t forDuration(uint64_t duration_us) {
+        return until(Time::getMicroseconds() + duration_us);
+    }
+
+    /**
+     * @brief Marge courante en µs
+     */
+    static uint32_t margin() {
+        return margin_us();
+    }
+
+    static void setMargin(uint32_t micros) {
+        margin_us() = micros;
+    }
+};
+
+#endif // PRECISE_TIME_SLEEP_H
@@ -0,0 +1,544 @@
+/**
+ * @file PreciseTimeStats.h
+ * @brief Statistiques glissantes en mémoire constante : Welford et P²
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_STATS_H
+#define PRECISE_TIME_STATS_H
+
+#include <stdint.h>
+#include <math.h>
+#include "PreciseTimeDivide.h"
+
+/**
+ * @brief Estimateur P² d'un quantile (Jain & Chlamtac, 1985)
+ *
+ * Cinq marqueurs dont les hauteurs suivent le minimum, p/2, p, (1+p)/2 et
+ * le maximum ; chaque échantillon déplace les positions, et les marqueurs
+ * intérieurs sont corrigés par interpolation parabolique. Aucune valeur
+ * n'est conservée au-delà des cinq premières.
+ */
+class PreciseTimeP2Quantile {
+private:
+    double p;
+    double q[5];        // Hauteurs des marqueurs
+    double np[5];       // Positions désirées
+    double dn[5];       // Incréments des positions désirées
+    int64_t n[5];       // Positions réelles
+    uint64_t count;
+
+    double parabolic(int i, int d) const {
+        return q[i] + (double)d / (double)(n[i + 1] - n[i - 1])
+               * ((double)(n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (double)(n[i + 1] - n[i])
+                  + (double)(n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (double)(n[i] - n[i - 1]));
+    }
+
+    double linear(int i, int d) const {
+        return q[i] + (double)d * (q[i + d] - q[i]) / (double)(n[i + d] - n[i]);
+    }
+
+public:
+    explicit PreciseTimeP2Quantile(double quantile = 0.5) : p(quantile) {
+        reset();
+    }
+
+    void reset() {
+        count = 0;
+        for (int i = 0; i < 5; i++) {
+            q[i] = 0.0;
+            n[i] = i;
+        }
+        np[0] = 0.0;     np[1] = 2.0 * p;  np[2] = 4.0 * p;
+        np[3] = 2.0 + 2.0 * p;             np[4] = 4.0;
+        dn[0] = 0.0;     dn[1] = p / 2.0;  dn[2] = p;
+        dn[3] = (1.0 + p) / 2.0;           dn[4] = 1.0;
+    }
+
+    void add(double x) {
+        if (count < 5) {
+            // Insertion triée des cinq premiers échantillons
+            int i = (int)count++;
+            while (i > 0 && q[i - 1] > x) {
+                q[i] = q[i - 1];
+                i--;
+            }
+            q[i] = x;
+            return;
+        }
+        count++;
+
+        int k;
+        if (x < q[0]) {
+            q[0] = x;
+            k = 0;
+        } else if (x >= q[4]) {
+            q[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= q[k + 1]) k++;
+        }
+        for (int i = k + 1; i < 5; i++) n[i]++;
+        for (int i = 0; i < 5; i++) np[i] += dn[i];
+
+        for (int i = 1; i <= 3; i++) {
+            double d = np[i] - (double)n[i];
+            if ((d >= 1.0 && n[i + 1] - n[i] > 1) || (d <= -1.0 && n[i - 1] - n[i] < -1)) {
+                int step = d > 0 ? 1 : -1;
+                double candidate = parabolic(i, step);
+                q[i] = (q[i - 1] < candidate && candidate < q[i + 1]) ? candidate : linear(i, step);
+                n[i] += step;
+            }
+        }
+    }
+
+    /**
+     * @brief Estimation courante ; exacte (plus proche rang) sous 5 échantillons
+     */
+    double value() const {
+        if (count == 0) return 0.0;
+        if (count < 5) {
+            int index = (int)(p * (double)(count - 1) + 0.5);
+            return q[index];
+        }
+        return q[2];
+    }
+
+    uint64_t samples() const { return count; }
+};
+
+/**
+ * @brief Moyenne, variance et min/max par l'algorithme de Welford
+ *
+ * Mise à jour incrémentale de la moyenne et de M2 = somme des carrés des
+ * écarts : pas de cancellation catastrophique, contrairement à
+ * somme(x²) - somme(x)²/n, même avec une grande composante continue.
+ */
+class PreciseTimeWelford {
+private:
+    uint64_t count;
+    double mean_value;
+    double m2;
+    double min_value;
+    double max_value;
+
+public:
+    PreciseTimeWelford() {
+        reset();
+    }
+
+    void reset() {
+        count = 0;
+        mean_value = 0.0;
+        m2 = 0.0;
+        min_value = 0.0;
+        max_value = 0.0;
+    }
+
+    inline void add(double x) {
+        count++;
+        double delta = x - mean_value;
+        mean_value += delta / (double)count;
+        m2 += delta * (x - mean_value);
+        if (count == 1 || x < min_value) min_value = x;
+        if (count == 1 || x > max_value) max_value = x;
+    }
+
+    uint64_t samples() const { return count; }
+    double mean() const { return mean_value; }
+    double min() const { return min_value; }
+    double max() const { return max_value; }
+
+    // Variance de l'échantillon (n - 1) et de la population (n)
+    double variance() const { return count > 1 ? m2 / (double)(count - 1) : 0.0; }
+    double populationVariance() const { return count > 0 ? m2 / (double)count : 0.0; }
+    double stddev() const { return sqrt(variance()); }
+};
+
+/**
+ * @brief Moyenne, écart type, min/max (Welford), médiane et p95 (P²)
+ *        d'une suite de mesures, sans stocker les échantillons
+ *
+ * Environ 200 octets quel que soit le nombre d'échantillons.
+ */
+class PreciseTimeRunningStats {
+private:
+    PreciseTimeWelford moments;
+    PreciseTimeP2Quantile median_estimator;
+    PreciseTimeP2Quantile p95_estimator;
+
+public:
+    PreciseTimeRunningStats() : median_estimator(0.5), p95_estimator(0.95) {}
+
+    void reset() {
+        moments.reset();
+        median_estimator.reset();
+        p95_estimator.reset();
+    }
+
+    void add(double x) {
+        moments.add(x);
+        median_estimator.add(x);
+        p95_estimator.add(x);
+    }
+
+    uint64_t samples() const { return moments.samples(); }
+    double mean() const { return moments.mean(); }
+    double min() const { return moments.min(); }
+    double max() const { return moments.max(); }
+    double variance() const { return moments.variance(); }
+    double stddev() const { return moments.stddev(); }
+    double median() const { return median_estimator.value(); }
+    double p95() const { return p95_estimator.value(); }
+};
+
+/**
+ * @brief P² en entiers : hauteurs en virgule fixe 24.8, positions en 16.16
+ *
+ * Même algorithme que PreciseTimeP2Quantile, sans aucune opération
+ * flottante (ESP8266 : pas de FPU). Valeurs < 2^24 ; les positions restent
+ * sous MAX_SAMPLES = 2^30 pour que les produits de l'interpolation tiennent
+ * sur 64 bits : à ce seuil, add() appelle decay(), qui divise les positions
+ * par deux. L'estimateur tourne ainsi indéfiniment (12 jours à 1 kHz par
+ * demi-vie), l'historique ancien pesant de moins en moins.
+ */
+class PreciseTimeP2QuantileInt {
+public:
+    static const uint32_t MAX_SAMPLES = 1UL << 30;
+
+private:
+    int64_t q[5];       // Hauteurs, virgule fixe 8 bits
+    int64_t np[5];      // Positions désirées, virgule fixe 16 bits
+    int64_t dn[5];
+    int64_t n[5];
+    uint32_t permille;
+    uint32_t count;
+
+    // Les hauteurs sont croissantes et les écarts de positions >= 1 : les
+    // interpolations divisent des grandeurs positives, le sens vient de d.
+    // Troncature vers zéro comme en signé, sans __divdi3.
+    int64_t parabolic(int i, int d) const {
+        uint64_t above = (uint64_t)(q[i + 1] - q[i]);
+        uint64_t below = (uint64_t)(q[i] - q[i - 1]);
+        uint32_t gap_above = (uint32_t)(n[i + 1] - n[i]);
+        uint32_t gap_below = (uint32_t)(n[i] - n[i - 1]);
+        uint64_t left = PreciseTimeReciprocal::divide((uint64_t)(gap_below + d) * above, gap_above);
+        uint64_t right = PreciseTimeReciprocal::divide((uint64_t)(gap_above - d) * below, gap_below);
+        int64_t shift = (int64_t)PreciseTimeReciprocal::divide(left + right, gap_above + gap_below);
+        return d > 0 ? q[i] + shift : q[i] - shift;
+    }
+
+    int64_t linear(int i, int d) const {
+        uint64_t height = (uint64_t)(d > 0 ? q[i + 1] - q[i] : q[i] - q[i - 1]);
+        uint32_t gap = (uint32_t)(d > 0 ? n[i + 1] - n[i] : n[i] - n[i - 1]);
+        int64_t shift = (int64_t)PreciseTimeReciprocal::divide(height, gap);
+        return d > 0 ? q[i] + shift : q[i] - shift;
+    }
+
+public:
+    /**
+     * @param quantile_permille Quantile en pour mille (500 : médiane, 950 : p95)
+     */
+    explicit PreciseTimeP2QuantileInt(uint32_t quantile_permille = 500)
+        : permille(quantile_permille) {
+        reset();
+    }
+
+    void reset() {
+        count = 0;
+        int64_t p = PreciseTimeDivide<1000>::quotient32(permille << 16);
+        for (int i = 0; i < 5; i++) {
+            q[i] = 0;
+            n[i] = i;
+        }
+        np[0] = 0;          np[1] = 2 * p;     np[2] = 4 * p;
+        np[3] = (2LL << 16) + 2 * p;           np[4] = 4LL << 16;
+        dn[0] = 0;          dn[1] = p / 2;     dn[2] = p;
+        dn[3] = ((1LL << 16) + p) / 2;         dn[4] = 1LL << 16;
+    }
+
+    void add(uint32_t value) {
+        int64_t x = (int64_t)value << 8;
+        if (count < 5) {
+            int i = (int)count++;
+            while (i > 0 && q[i - 1] > x) {
+                q[i] = q[i - 1];
+                i--;
+            }
+            q[i] = x;
+            return;
+        }
+        if (count >= MAX_SAMPLES) decay();
+        count++;
+
+        int k;
+        if (x < q[0]) {
+            q[0] = x;
+            k = 0;
+        } else if (x >= q[4]) {
+            q[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= q[k + 1]) k++;
+        }
+        for (int i = k + 1; i < 5; i++) n[i]++;
+        for (int i = 0; i < 5; i++) np[i] += dn[i];
+
+        for (int i = 1; i <= 3; i++) {
+            int64_t d = np[i] - (n[i] << 16);
+            if ((d >= (1LL << 16) && n[i + 1] - n[i] > 1)
+                || (d <= -(1LL << 16) && n[i - 1] - n[i] < -1)) {
+                int step = d > 0 ? 1 : -1;
+                int64_t candidate = parabolic(i, step);
+                q[i] = (q[i - 1] < candidate && candidate < q[i + 1]) ? candidate : linear(i, step);
+                n[i] += step;
+            }
+        }
+    }
+
+    /**
+     * @brief Divise par deux le poids de l'historique
+     *
+     * Positions réelles et désirées divisées par deux, hauteurs inchangées :
+     * l'estimation ne bouge pas, les échantillons suivants pèsent double.
+     * Sans effet pendant le démarrage (5 premiers échantillons).
+     */
+    void decay() {
+        if (count <= 5) return;
+        for (int i = 1; i < 5; i++) {
+            n[i] >>= 1;
+            if (n[i] <= n[i - 1]) n[i] = n[i - 1] + 1;
+            np[i] >>= 1;
+        }
+        np[4] = n[4] << 16;
+        count = (uint32_t)n[4] + 1;
+    }
+
+    // Estimation courante, arrondie à l'entier
+    uint32_t value() const {
+        if (count == 0) return 0;
+        int64_t height = q[2];
+        if (count < 5) {
+            height = q[(permille * (count - 1) + 500) / 1000];
+        }
+        return (uint32_t)((height + 128) >> 8);
+    }
+
+    // Poids de l'historique : échantillons ajoutés, divisés par deux à chaque decay()
+    uint32_t samples() const { return count; }
+};
+
+/**
+ * @brief PreciseTimeWelford en entiers, pour l'ESP8266
+ *
+ * En entiers, les sommes exactes Σx et Σx² remplacent la récurrence de
+ * Welford : rien ne s'arrondit, et add() n'a ni division ni __divdi3
+ * (un produit 32 x 32 -> 64 et deux additions). Les divisions sont
+ * reportées sur la lecture : moyenne en virgule fixe 24.8 et variance de
+ * population (n·Σx² - (Σx)²) / n², calculée sur 128 bits en mots de 32.
+ * Valeurs < 2^24 (16,7 s en µs). Le compte ne reboucle pas : à
+ * MAX_SAMPLES (49 jours à 1 kHz), add() appelle decay(), qui divise n, Σx
+ * et Σx² par deux ; moyenne et variance sont conservées (variance à
+ * 2^-7 unité² près).
+ */
+class PreciseTimeWelfordInt {
+public:
+    static const uint32_t MAX_SAMPLES = 0xFFFFFFFEUL;   // Pair : decay() exact sur n
+
+private:
+    uint32_t count;
+    uint64_t sum;                 // Σx < 2^56
+    uint64_t sum_squares_low;     // Σx² < 2^80, 64 bits de poids faible
+    uint32_t sum_squares_high;    // et 32 bits de poids fort
+    uint32_t min_value;
+    uint32_t max_value;
+
+    // word += a·b·2^(32·at), sur 4 mots de 32 bits de poids faible d'abord
+    static void multiplyAdd(uint32_t word[4], uint32_t a, uint32_t b, int at) {
+        uint64_t carry = (uint64_t)a * b;
+        for (int i = at; i < 4 && carry != 0; i++) {
+            carry += word[i];
+            word[i] = (uint32_t)carry;
+            carry >>= 32;
+        }
+    }
+
+    // word /= d, sur 4 mots de 32 bits
+    static void divideWords(uint32_t word[4], uint32_t d) {
+        uint64_t rest = 0;
+        for (int i = 3; i >= 0; i--) {
+            uint64_t current = (rest << 32) | word[i];
+            word[i] = (uint32_t)(current / d);
+            rest = current % d;
+        }
+    }
+
+    static uint32_t isqrt(uint64_t value) {
+        uint64_t result = 0;
+        uint64_t bit = 1ULL << 62;
+        while (bit > value) bit >>= 2;
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return (uint32_t)result;
+    }
+
+public:
+    PreciseTimeWelfordInt() {
+        reset();
+    }
+
+    void reset() {
+        count = 0;
+        sum = 0;
+        sum_squares_low = 0;
+        sum_squares_high = 0;
+        min_value = UINT32_MAX;
+        max_value = 0;
+    }
+
+    inline void add(uint32_t value) {
+        if (count >= MAX_SAMPLES) decay();
+        count++;
+        sum += value;
+        uint64_t square = (uint64_t)value * value;
+        sum_squares_low += square;
+        if (sum_squares_low < square) sum_squares_high++;
+        if (value < min_value) min_value = value;
+        if (value > max_value) max_value = value;
+    }
+
+    /**
+     * @brief Divise par deux le poids de l'historique
+     *
+     * n, Σx et Σx² divisés par deux : moyenne et variance ne bougent pas
+     * (aux arrondis de Σ près), les échantillons suivants pèsent double.
+     * Si n est impair, la moyenne courante est d'abord ajoutée une fois pour
+     * que n se divise exactement. min() et max() restent ceux de tout
+     * l'historique.
+     */
+    void decay() {
+        if (count < 2) return;
+        if (count & 1) {
+            uint32_t lowest = min_value, highest = max_value;
+            add(mean());
+            min_value = lowest;
+            max_value = highest;
+        }
+        count >>= 1;
+        sum >>= 1;
+        sum_squares_low = (sum_squares_low >> 1) | ((uint64_t)sum_squares_high << 63);
+        sum_squares_high >>= 1;
+    }
+
+    // Poids de l'historique : échantillons ajoutés, divisés par deux à chaque decay()
+    uint32_t samples() const { return count; }
+    uint32_t min() const { return count ? min_value : 0; }
+    uint32_t max() const { return max_value; }
+
+    // Moyenne arrondie, et en virgule fixe 24.8 (tronquée)
+    uint32_t mean() const { return (uint32_t)((meanQ8() + 128) >> 8); }
+    int64_t meanQ8() const { return count ? (int64_t)((sum << 8) / count) : 0; }
+
+    // Variance de population, virgule fixe 8 bits (tronquée)
+    uint64_t varianceQ8() const {
+        if (count == 0) return 0;
+        // n·Σx² - (Σx)², exact sur 128 bits
+        uint32_t spread[4] = {0, 0, 0, 0};
+        multiplyAdd(spread, (uint32_t)sum_squares_low, count, 0);
+        multiplyAdd(spread, (uint32_t)(sum_squares_low >> 32), count, 1);
+        multiplyAdd(spread, sum_squares_high, count, 2);
+        uint32_t square[4] = {0, 0, 0, 0};
+        uint32_t sum_low = (uint32_t)sum, sum_high = (uint32_t)(sum >> 32);
+        multiplyAdd(square, sum_low, sum_low, 0);
+        multiplyAdd(square, sum_low, sum_high, 1);
+        multiplyAdd(square, sum_low, sum_high, 1);
+        multiplyAdd(square, sum_high, sum_high, 2);
+        int64_t borrow = 0;
+        for (int i = 0; i < 4; i++) {
+            borrow += (int64_t)spread[i] - square[i];
+            spread[i] = (uint32_t)borrow;
+            borrow >>= 32;
+        }
+        // Négatif seulement par les arrondis de decay(), variance nulle
+        if (borrow < 0) return 0;
+        // < 2^112 : ·2^8 tient sur 128 bits
+        for (int i = 3; i > 0; i--) spread[i] = (spread[i] << 8) | (spread[i - 1] >> 24);
+        spread[0] <<= 8;
+        divideWords(spread, count);
+        divideWords(spread, count);
+        return ((uint64_t)spread[1] << 32) | spread[0];
+    }
+
+    // Écart type arrondi : sqrt(var·2^8) = 16·sigma
+    uint32_t stddev() const { return (isqrt(varianceQ8()) + 8) >> 4; }
+};
+
+/**
+ * @brief PreciseTimeRunningStats en entiers : aucune opération flottante
+ */
+class PreciseTimeRunningStatsInt {
+private:
+    PreciseTimeWelfordInt moments;
+    PreciseTimeP2QuantileInt median_estimator;
+    PreciseTimeP2QuantileInt p95_estimator;
+
+public:
+    PreciseTimeRunningStatsInt() : median_estimator(500), p95_estimator(950) {}
+
+    void reset() {
+        moments.reset();
+        median_estimator.reset();
+        p95_estimator.reset();
+    }
+
+    // Divise par deux le poids de l'historique (voir PreciseTimeWelfordInt::decay())
+    void decay() {
+        moments.decay();
+        median_estimator.decay();
+        p95_estimator.decay();
+    }
+
+    void add(uint32_t value) {
+        moments.add(value);
+        median_estimator.add(value);
+        p95_estimator.add(value);
+    }
+
+    uint32_t samples() const { return moments.samples(); }
+    uint32_t mean() const { return moments.mean(); }
+    uint32_t min() const { return moments.min(); }
+    uint32_t max() const { return moments.max(); }
+    uint32_t stddev() const { return moments.stddev(); }
+    uint64_t varianceQ8() const { return moments.varianceQ8(); }
+    uint32_t median() const { return median_estimator.value(); }
+    uint32_t p95() const { return p95_estimator.value(); }
+};
+
+#endif // PRECISE_TIME_STATS_H
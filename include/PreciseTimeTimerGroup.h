@@ -0,0 +1,105 @@
+/**
+ * @file PreciseTimeTimerGroup.h
+ * @brief Lecture sans interruption du compteur 64 bits d'un timer matériel ESP32
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_TIMER_GROUP_H
+#define PRECISE_TIME_TIMER_GROUP_H
+
+#include <stdint.h>
+#include "PreciseTimeInline.h"
+
+#if defined(ESP32)
+#include "soc/soc.h"
+#include "soc/timer_group_reg.h"
+#endif
+
+/**
+ * @brief Registres du timer 0 d'un groupe de timers (TRM ESP32, chap. 18)
+ */
+enum PreciseTimeTimerGroupReg {
+    PRECISE_TIMG_T0LO,      ///< Mot bas de la valeur capturée
+    PRECISE_TIMG_T0HI,      ///< Mot haut de la valeur capturée
+    PRECISE_TIMG_T0UPDATE,  ///< Écriture : capture le compteur dans LO/HI
+    PRECISE_TIMG_T0LOADLO,  ///< Mot bas de la valeur à recharger
+    PRECISE_TIMG_T0LOADHI,  ///< Mot haut de la valeur à recharger
+    PRECISE_TIMG_T0LOAD     ///< Écriture : recharge le compteur depuis LOADLO/HI
+};
+
+/**
+ * @brief Accès au compteur 64 bits libre d'un timer matériel
+ *
+ * Le compteur tourne sans alarme ni interruption ; la lecture capture
+ * sa valeur dans LO/HI puis lit les deux mots. Si un autre contexte
+ * (ISR, second cœur) recapture entre nos deux lectures, LO change :
+ * on relit alors, ce qui évite tout verrou.
+ *
+ * @tparam Regs Fournit read(reg) et write(reg, value). Sur cible, les
+ *         registres du groupe 0 ; sur l'hôte, une maquette de test.
+ */
+template <class Regs>
+class PreciseTimeTimerGroup {
+public:
+    static PRECISE_TIME_FORCE_INLINE uint64_t read() {
+        uint32_t lo, hi;
+        do {
+            Regs::write(PRECISE_TIMG_T0UPDATE, 1);
+            lo = Regs::read(PRECISE_TIMG_T0LO);
+            hi = Regs::read(PRECISE_TIMG_T0HI);
+        } while (Regs::read(PRECISE_TIMG_T0LO) != lo);
+        return ((uint64_t)hi << 32) | lo;
+    }
+
+    static PRECISE_TIME_FORCE_INLINE void write(uint64_t value) {
+        Regs::write(PRECISE_TIMG_T0LOADLO, (uint32_t)value);
+        Regs::write(PRECISE_TIMG_T0LOADHI, (uint32_t)(value >> 32));
+        Regs::write(PRECISE_TIMG_T0LOAD, 1);
+    }
+};
+
+#if defined(ESP32)
+/**
+ * @brief Registres réels du timer 0, groupe 0 (celui de timerBegin(0, ...))
+ */
+struct PreciseTimeTimerGroup0Regs {
+    static PRECISE_TIME_FORCE_INLINE uint32_t address(PreciseTimeTimerGroupReg reg) {
+        switch (reg) {
+            case PRECISE_TIMG_T0LO:     return TIMG_T0LO_REG(0);
+            case PRECISE_TIMG_T0HI:     return TIMG_T0HI_REG(0);
+            case PRECISE_TIMG_T0UPDATE: return TIMG_T0UPDATE_REG(0);
+            case PRECISE_TIMG_T0LOADLO: return TIMG_T0LOADLO_REG(0);
+            case PRECISE_TIMG_T0LOADHI: return TIMG_T0LOADHI_REG(0);
+            default:                    return TIMG_T0LOAD_REG(0);
+        }
+    }
+
+    static PRECISE_TIME_FORCE_INLINE uint32_t read(PreciseTimeTimerGroupReg reg) {
+        return REG_READ(address(reg));
+    }
+
+    static PRECISE_TIME_FORCE_INLINE void write(PreciseTimeTimerGroupReg reg, uint32_t value) {
+        REG_WRITE(address(reg), value);
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_TIMER_GROUP_H
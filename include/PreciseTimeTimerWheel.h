@@ -0,0 +1,335 @@
+/**
+ * @file PreciseTimeTimerWheel.h
+ * @brief Roue de temporisation hiérarchique : minuteries logicielles à
+ *        nœuds intrusifs, insertion et annulation en O(1)
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_TIMER_WHEEL_H
+#define PRECISE_TIME_TIMER_WHEEL_H
+
+#include "PreciseTime.h"
+
+/**
+ * @brief Minuterie d'une PreciseTimeTimerWheel, à intégrer dans l'objet
+ *        qu'elle concerne (connexion, requête...) : la roue n'alloue rien
+ *
+ * Le rappel reçoit la minuterie et son contexte ; il peut relancer la
+ * minuterie (périodique) ou en annuler d'autres.
+ */
+struct PreciseTimeWheelTimer {
+    typedef void (*Callback)(PreciseTimeWheelTimer& timer, void* context);
+
+    PreciseTimeWheelTimer* next;
+    PreciseTimeWheelTimer** pprev;  ///< Lien qui pointe sur ce nœud ; nullptr si inactive
+    uint64_t expires;               ///< Échéance en ticks de la roue
+    Callback callback;
+    void* context;
+    uint16_t slot;                  ///< Case occupée dans la roue
+
+    PreciseTimeWheelTimer()
+        : next(nullptr), pprev(nullptr), expires(0), callback(nullptr), context(nullptr), slot(0) {}
+
+    bool isPending() const { return pprev != nullptr; }
+};
+
+/**
+ * @brief Roue de temporisation hiérarchique (Varghese & Lauck)
+ *
+ * LEVELS niveaux de 2^SLOT_BITS cases ; une case du niveau L couvre
+ * 2^(L × SLOT_BITS) ticks de RESOLUTION_US microsecondes. Une minuterie
+ * est rangée au niveau le plus bas dont le bloc englobant contient à la
+ * fois le tick courant et son échéance ; quand le tick courant entre dans
+ * le bloc de sa case, elle redescend d'un niveau (cascade), jusqu'au
+ * niveau 0 où elle expire au tick exact. Au-delà de
+ * 2^(LEVELS × SLOT_BITS) ticks (4,6 h avec les valeurs par défaut), elle
+ * attend dans une liste de débordement, redistribuée à chaque tour complet.
+ *
+ * start() et cancel() sont en O(1) : chaînage intrusif (next/pprev), pas
+ * d'allocation, pas de parcours. advance() saute directement au prochain
+ * tick utile grâce à un masque des cases occupées par niveau, puis traite
+ * chaque case en lot : elle est détachée, et ses minuteries sont
+ * redistribuées ou expirées une à une. Les minuteries d'un même tick
+ * expirent dans un ordre quelconque. Une échéance n'est jamais avancée :
+ * elle est arrondie au tick supérieur.
+ *
+ * La roue n'est pas synchronisée : start(), cancel() et advance() depuis
+ * un seul contexte (loop() ou une tâche). advance() ne doit pas être
+ * rappelé depuis un rappel. Une horloge qui recule (reset()) est ignorée :
+ * les minuteries en cours gardent leur échéance absolue.
+ *
+ * Mémoire : (LEVELS × 2^SLOT_BITS + 1) pointeurs et LEVELS masques de
+ * 64 bits, soit ~1 Ko sur ESP32 avec les valeurs par défaut.
+ *
+ * @tparam Time Horloge (PreciseTime, PreciseTimeT<...>)
+ * @tparam RESOLUTION_US Durée d'un tick de la roue, en µs
+ * @tparam LEVELS Nombre de niveaux
+ * @tparam SLOT_BITS log2 du nombre de cases par niveau (6 au plus)
+ */
+template <class Time = PreciseTime, uint32_t RESOLUTION_US = 1000,
+          unsigned LEVELS = 4, unsigned SLOT_BITS = 6>
+class PreciseTimeTimerWheel {
+public:
+    typedef PreciseTimeWheelTimer Timer;
+
+    static const uint32_t SLOTS = 1UL << SLOT_BITS;
+    static const uint64_t RANGE_TICKS = 1ULL << (LEVELS * SLOT_BITS);
+
+    static_assert(RESOLUTION_US >= 1, "RESOLUTION_US doit valoir au moins 1");
+    static_assert(SLOT_BITS >= 1 && SLOT_BITS <= 6, "SLOT_BITS : 1 à 6 (masque de 64 bits)");
+    static_assert(LEVELS >= 1 && LEVELS * SLOT_BITS < 64, "LEVELS × SLOT_BITS doit rester sous 64");
+
+private:
+    static const uint32_t MASK = SLOTS - 1;
+    static const uint16_t OVERFLOW_SLOT = LEVELS * SLOTS;
+    static const uint16_t DETACHED_SLOT = 0xFFFF;
+
+    Timer* heads[LEVELS * SLOTS + 1];
+    uint64_t occupied[LEVELS];
+    uint64_t current;           // Dernier tick traité
+    uint32_t pending_count;
+
+    static uint64_t toTicks(uint64_t micros) {
+        return PreciseTimeDivide<RESOLUTION_US>::quotient(micros);
+    }
+
+    // Tick de l'échéance, arrondi au-dessus
+    static uint64_t toTicksCeil(uint64_t micros) {
+        uint64_t ticks = toTicks(micros);
+        return ticks * RESOLUTION_US < micros ? ticks + 1 : ticks;
+    }
+
+    static unsigned msb(uint64_t value) {
+        return 63 - __builtin_clzll(value | 1);
+    }
+
+    static void link(Timer*& head, Timer& timer) {
+        timer.next = head;
+        if (head != nullptr) head->pprev = &timer.next;
+        head = &timer;
+        timer.pprev = &head;
+    }
+
+    static void unlink(Timer& timer) {
+        *timer.pprev = timer.next;
+        if (timer.next != nullptr) timer.next->pprev = timer.pprev;
+        timer.next = nullptr;
+        timer.pprev = nullptr;
+    }
+
+    // Range une minuterie d'échéance >= current
+    void place(Timer& timer) {
+        uint64_t expires = timer.expires;
+        unsigned level = msb(expires ^ current) / SLOT_BITS;
+        uint16_t slot;
+        if (level >= LEVELS) {
+            slot = OVERFLOW_SLOT;
+        } else {
+            uint32_t index = (uint32_t)(expires >> (level * SLOT_BITS)) & MASK;
+            slot = (uint16_t)(level * SLOTS + index);
+            occupied[level] |= 1ULL << index;
+        }
+        timer.slot = slot;
+        link(heads[slot], timer);
+    }
+
+    // Détache la case `slot` dans `batch`, pour la traiter en lot
+    void detach(uint16_t slot, Timer*& batch) {
+        batch = heads[slot];
+        heads[slot] = nullptr;
+        if (slot < OVERFLOW_SLOT) occupied[slot / SLOTS] &= ~(1ULL << (slot % SLOTS));
+        if (batch != nullptr) batch->pprev = &batch;
+        for (Timer* timer = batch; timer != nullptr; timer = timer->next) {
+            timer->slot = DETACHED_SLOT;
+        }
+    }
+
+    void cascade(uint16_t slot) {
+        Timer* batch;
+        detach(slot, batch);
+        while (batch != nullptr) {
+            Timer& timer = *batch;
+            unlink(timer);
+            place(timer);
+        }
+    }
+
+    uint32_t expire(uint16_t slot) {
+        Timer* batch;
+        detach(slot, batch);
+        uint32_t count = 0;
+        // Un rappel peut annuler une minuterie du lot : on la retire avant
+        // chaque appel plutôt que de parcourir une liste figée
+        while (batch != nullptr) {
+            Timer& timer = *batch;
+            unlink(timer);
+            pending_count--;
+            count++;
+            if (timer.callback != nullptr) timer.callback(timer, timer.context);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Prochain tick où une case occupée est redistribuée ou expire,
+     *        UINT64_MAX si la roue est vide
+     */
+    uint64_t nextEventTick() const {
+        uint64_t best = UINT64_MAX;
+        for (unsigned level = 0; level < LEVELS; level++) {
+            unsigned shift = level * SLOT_BITS;
+            uint32_t index = (uint32_t)(current >> shift) & MASK;
+            // Les minuteries d'un niveau sont toujours après la case courante
+            uint64_t map = index + 1 < SLOTS ? occupied[level] & (~0ULL << (index + 1)) : 0;
+            if (map == 0) continue;
+            uint64_t block = (current >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            uint64_t tick = block | ((uint64_t)__builtin_ctzll(map) << shift);
+            if (tick < best) best = tick;
+        }
+        if (heads[OVERFLOW_SLOT] != nullptr) {
+            uint64_t tick = ((current >> (LEVELS * SLOT_BITS)) + 1) << (LEVELS * SLOT_BITS);
+            if (tick < best) best = tick;
+        }
+        return best;
+    }
+
+public:
+    PreciseTimeTimerWheel() : current(toTicks(Time::getMicroseconds())), pending_count(0) {
+        for (uint32_t i = 0; i <= LEVELS * SLOTS; i++) heads[i] = nullptr;
+        for (unsigned level = 0; level < LEVELS; level++) occupied[level] = 0;
+    }
+
+    /**
+     * @brief Arme `timer` pour expirer `delay_us` microsecondes après
+     *        l'instant présent de Time ; relance une minuterie déjà armée
+     */
+    void start(Timer& timer, uint64_t delay_us,
+               Timer::Callback callback, void* context = nullptr) {
+        startAt(timer, Time::getMicroseconds() + delay_us, callback, context);
+    }
+
+    /**
+     * @brief Arme `timer` pour l'échéance absolue `deadline_us` (µs de Time)
+     *
+     * Une échéance déjà passée expire au prochain advance().
+     */
+    void startAt(Timer& timer, uint64_t deadline_us,
+                 Timer::Callback callback, void* context = nullptr) {
+        cancel(timer);
+        uint64_t expires = toTicksCeil(deadline_us);
+        timer.expires = expires > current ? expires : current + 1;
+        timer.callback = callback;
+        timer.context = context;
+        place(timer);
+        pending_count++;
+    }
+
+    /**
+     * @brief Désarme `timer`
+     * @return false si elle n'était pas armée
+     */
+    bool cancel(Timer& timer) {
+        if (!timer.isPending()) return false;
+        uint16_t slot = timer.slot;
+        unlink(timer);
+        if (slot < OVERFLOW_SLOT && heads[slot] == nullptr) {
+            occupied[slot / SLOTS] &= ~(1ULL << (slot % SLOTS));
+        }
+        pending_count--;
+        return true;
+    }
+
+    /**
+     * @brief Traite les échéances jusqu'à `now_us` (µs de Time) et appelle
+     *        les rappels des minuteries expirées
+     * @return Nombre de minuteries expirées
+     */
+    uint32_t advance(uint64_t now_us) {
+        uint64_t target = toTicks(now_us);
+        uint32_t expired = 0;
+        while (current < target) {
+            uint64_t tick = nextEventTick();
+            if (tick > target) {
+                current = target;
+                break;
+            }
+            current = tick;
+            // Du plus haut au plus bas : une cascade peut alimenter la suivante
+            if ((tick & (RANGE_TICKS - 1)) == 0 && heads[OVERFLOW_SLOT] != nullptr) {
+                cascade(OVERFLOW_SLOT);
+            }
+            for (unsigned level = LEVELS - 1; level > 0; level--) {
+                unsigned shift = level * SLOT_BITS;
+                if ((tick & ((1ULL << shift) - 1)) != 0) continue;
+                uint32_t index = (uint32_t)(tick >> shift) & MASK;
+                if (occupied[level] & (1ULL << index)) cascade((uint16_t)(level * SLOTS + index));
+            }
+            uint32_t index = (uint32_t)tick & MASK;
+            if (occupied[0] & (1ULL << index)) expired += expire((uint16_t)index);
+        }
+        return expired;
+    }
+
+    /**
+     * @brief advance() à l'instant présent de Time, à appeler dans loop()
+     */
+    uint32_t update() {
+        return advance(Time::getMicroseconds());
+    }
+
+    /**
+     * @brief Prochaine échéance en µs de Time, UINT64_MAX si aucune
+     *
+     * Exacte pour une minuterie à moins de 2^SLOT_BITS ticks ; au-delà,
+     * borne inférieure (instant de la prochaine cascade) : appeler
+     * advance() à cet instant puis redemander.
+     */
+    uint64_t nextDeadline() const {
+        uint64_t tick = nextEventTick();
+        return tick == UINT64_MAX ? UINT64_MAX : tick * RESOLUTION_US;
+    }
+
+    /**
+     * @brief Désarme toutes les minuteries, sans appeler les rappels
+     */
+    void clear() {
+        for (uint32_t slot = 0; slot <= LEVELS * SLOTS; slot++) {
+            while (heads[slot] != nullptr) unlink(*heads[slot]);
+        }
+        for (unsigned level = 0; level < LEVELS; level++) occupied[level] = 0;
+        pending_count = 0;
+    }
+
+    uint32_t pending() const { return pending_count; }
+
+    /**
+     * @brief Instant du dernier tick traité, en µs de Time
+     */
+    uint64_t now() const { return current * RESOLUTION_US; }
+};
+
+template <class Time, uint32_t RESOLUTION_US, unsigned LEVELS, unsigned SLOT_BITS>
+const uint32_t PreciseTimeTimerWheel<Time, RESOLUTION_US, LEVELS, SLOT_BITS>::SLOTS;
+
+template <class Time, uint32_t RESOLUTION_US, unsigned LEVELS, unsigned SLOT_BITS>
+const uint64_t PreciseTimeTimerWheel<Time, RESOLUTION_US, LEVELS, SLOT_BITS>::RANGE_TICKS;
+
+#endif // PRECISE_TIME_TIMER_WHEEL_H
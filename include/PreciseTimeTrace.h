@@ -0,0 +1,390 @@
+/**
+ * @file PreciseTimeTrace.h
+ * @brief Traces d'événements horodatés dans un anneau sans verrou, export
+ *        au format Chrome Trace Event (Perfetto, chrome://tracing)
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_TRACE_H
+#define PRECISE_TIME_TRACE_H
+
+#include "PreciseTime.h"
+#include "PreciseTimeInline.h"
+
+#if defined(ARDUINO) && !defined(ESP32) && !defined(ESP8266)
+// Arduino générique : pas de <atomic>, les événements ne sont enregistrés
+// que depuis loop(), dans le même contexte que drain().
+#define PRECISE_TIME_TRACE_LOOP_ONLY
+#else
+#include <atomic>
+#endif
+
+// Nombre d'événements de l'anneau par défaut (puissance de 2)
+#ifndef PRECISE_TIME_TRACE_CAPACITY
+#define PRECISE_TIME_TRACE_CAPACITY  256
+#endif
+
+// Nombre d'identifiants auxquels setName() peut associer un nom
+#ifndef PRECISE_TIME_TRACE_MAX_NAMES
+#define PRECISE_TIME_TRACE_MAX_NAMES  64
+#endif
+
+/**
+ * @brief Type d'événement, codé comme le champ "ph" du format Chrome
+ */
+enum PreciseTimeTracePhase {
+    PRECISE_TIME_TRACE_BEGIN = 'B',     ///< Début d'une tranche
+    PRECISE_TIME_TRACE_END = 'E',       ///< Fin de la dernière tranche ouverte
+    PRECISE_TIME_TRACE_INSTANT = 'i'    ///< Événement ponctuel
+};
+
+/**
+ * @brief Événement tel que relu par drain() (16 octets)
+ */
+struct PreciseTimeTraceEvent {
+    uint64_t timestamp;     ///< Ticks de l'horloge du tampon
+    uint32_t arg;           ///< Argument libre (taille, numéro de canal...)
+    uint16_t id;            ///< Identifiant de l'événement (voir setName())
+    uint8_t phase;          ///< PreciseTimeTracePhase
+    uint8_t track;          ///< Piste : cœur sur ESP32, thread en natif
+};
+
+/**
+ * @brief Compteur 32 bits partagé entre producteurs
+ */
+struct PreciseTimeTraceWord {
+#if defined(PRECISE_TIME_TRACE_LOOP_ONLY)
+    volatile uint32_t value;
+
+    PRECISE_TIME_FORCE_INLINE uint32_t load() const { return value; }
+    PRECISE_TIME_FORCE_INLINE uint32_t loadAcquire() const { return value; }
+    PRECISE_TIME_FORCE_INLINE void storeRelease(uint32_t v) { value = v; }
+    PRECISE_TIME_FORCE_INLINE void increment() { value = value + 1; }
+
+    PRECISE_TIME_FORCE_INLINE bool claim(uint32_t& expected, uint32_t desired) {
+        if (value != expected) {
+            expected = value;
+            return false;
+        }
+        value = desired;
+        return true;
+    }
+#else
+    std::atomic<uint32_t> value;
+
+    PRECISE_TIME_FORCE_INLINE uint32_t load() const { return value.load(std::memory_order_relaxed); }
+    PRECISE_TIME_FORCE_INLINE uint32_t loadAcquire() const { return value.load(std::memory_order_acquire); }
+    PRECISE_TIME_FORCE_INLINE void storeRelease(uint32_t v) { value.store(v, std::memory_order_release); }
+    PRECISE_TIME_FORCE_INLINE void increment() { value.fetch_add(1, std::memory_order_relaxed); }
+
+    PRECISE_TIME_FORCE_INLINE bool claim(uint32_t& expected, uint32_t desired) {
+        return value.compare_exchange_weak(expected, desired, std::memory_order_relaxed);
+    }
+#endif
+
+    constexpr PreciseTimeTraceWord() : value(0) {}
+};
+
+/**
+ * @brief Anneau borné multi-producteurs d'événements de trace
+ *
+ * File de Vyukov : chaque case porte un numéro de séquence qui dit si elle
+ * est libre pour la position `pos` (séquence == pos) ou publiée
+ * (séquence == pos + 1). Un producteur réserve une position par
+ * compare-exchange sur `head`, remplit la case puis la publie ; il ne
+ * prend aucun verrou et ne masque pas les interruptions, donc ISR, tâches
+ * et les deux cœurs de l'ESP32 peuvent enregistrer en même temps. Quand
+ * l'anneau est plein, l'événement est compté dans dropped() et perdu :
+ * un producteur ne bloque jamais.
+ *
+ * Les séquences sont rangées moins l'indice de la case, pour qu'un anneau
+ * mis à zéro (variable statique) soit déjà prêt, sans constructeur.
+ *
+ * drain() et les exports n'acceptent qu'un consommateur à la fois. Un
+ * producteur interrompu entre réservation et publication arrête la
+ * lecture à sa case ; l'appel suivant reprend à cet endroit.
+ *
+ * Sur ESP32, une ISR placée en IRAM (ESP_INTR_FLAG_IRAM) peut enregistrer :
+ * instance(), begin(), end(), instant(), record() et les accès aux
+ * compteurs sont inlinés de force dans son corps, et l'anneau, variable
+ * statique, est en DRAM. L'horloge Time doit elle aussi être lisible
+ * depuis l'IRAM (backends ESP32 de la bibliothèque).
+ *
+ * @tparam Time Horloge d'horodatage (PreciseTime, PreciseTimeT<...>)
+ * @tparam CAPACITY Nombre de cases, puissance de 2
+ */
+template <class Time, uint32_t CAPACITY = PRECISE_TIME_TRACE_CAPACITY>
+class PreciseTimeTraceBuffer {
+public:
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                  "CAPACITY doit être une puissance de 2");
+
+private:
+    static const uint32_t MASK = CAPACITY - 1;
+
+    struct Slot {
+        PreciseTimeTraceWord sequence;
+        PreciseTimeTraceEvent event;
+
+        constexpr Slot() : sequence(), event{0, 0, 0, 0, 0} {}
+    };
+
+    PreciseTimeTraceWord head;
+    PreciseTimeTraceWord tail;
+    PreciseTimeTraceWord dropped_count;
+    Slot slots[CAPACITY];
+    const char* names[PRECISE_TIME_TRACE_MAX_NAMES];
+
+    static size_t appendText(char* out, const char* text) {
+        size_t length = 0;
+        while (text[length] != '\0') {
+            out[length] = text[length];
+            length++;
+        }
+        return length;
+    }
+
+    // Nom entre guillemets, `"` et `\` échappés, tronqué à 48 caractères
+    size_t appendName(char* out, uint16_t id) const {
+        const char* name = id < PRECISE_TIME_TRACE_MAX_NAMES ? names[id] : nullptr;
+        size_t length = 0;
+        out[length++] = '"';
+        if (name == nullptr) {
+            length += appendText(out + length, "event ");
+            length += PreciseTimeFormatter::appendUnsigned(out + length, id);
+        } else {
+            for (size_t i = 0; name[i] != '\0' && i < 48; i++) {
+                char c = name[i];
+                if (c == '"' || c == '\\') out[length++] = '\\';
+                out[length++] = (c < ' ') ? ' ' : c;
+            }
+        }
+        out[length++] = '"';
+        return length;
+    }
+
+    // Microsecondes avec trois décimales (champ "ts" du format Chrome)
+    static size_t appendMicros(char* out, uint64_t ticks) {
+        uint64_t nanos = PreciseTimeConvert<Time::TICKS_PER_SECOND, 1000000000ULL>::apply(ticks);
+        uint64_t micros = PreciseTimeDivide<1000ULL>::quotient(nanos);
+        size_t length = PreciseTimeFormatter::appendUnsigned(out, micros);
+        out[length++] = '.';
+        return length + PreciseTimeFormatter::appendPadded(out + length, (uint32_t)(nanos - micros * 1000ULL), 3);
+    }
+
+public:
+    constexpr PreciseTimeTraceBuffer() : head(), tail(), dropped_count(), slots(), names() {}
+
+    /**
+     * @brief Tampon partagé par les macros PRECISE_TRACE_* pour cette
+     *        horloge ; initialisé à la compilation, utilisable depuis une ISR
+     */
+    static PRECISE_TIME_FORCE_INLINE PreciseTimeTraceBuffer& instance() {
+        static PreciseTimeTraceBuffer buffer;
+        return buffer;
+    }
+
+    /**
+     * @brief Vide l'anneau et le compteur de pertes (ni producteur ni
+     *        consommateur actif) ; les noms sont conservés
+     */
+    void clear() {
+        for (uint32_t i = 0; i < CAPACITY; i++) slots[i].sequence.storeRelease(0);
+        head.storeRelease(0);
+        tail.storeRelease(0);
+        dropped_count.storeRelease(0);
+    }
+
+    /**
+     * @brief Associe un nom (chaîne statique) à un identifiant pour l'export
+     */
+    void setName(uint16_t id, const char* name) {
+        if (id < PRECISE_TIME_TRACE_MAX_NAMES) names[id] = name;
+    }
+
+    const char* name(uint16_t id) const {
+        return id < PRECISE_TIME_TRACE_MAX_NAMES ? names[id] : nullptr;
+    }
+
+    /**
+     * @brief Piste de l'appelant : cœur sur ESP32, numéro attribué au
+     *        premier appel de chaque thread en natif, 0 ailleurs
+     */
+    static PRECISE_TIME_FORCE_INLINE uint8_t currentTrack() {
+#if defined(ESP32)
+        return (uint8_t)xPortGetCoreID();
+#elif !defined(ARDUINO)
+        static std::atomic<uint32_t> next_track(0);
+        static thread_local uint8_t track = (uint8_t)next_track.fetch_add(1, std::memory_order_relaxed);
+        return track;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Enregistre un événement horodaté maintenant
+     * @return false si l'anneau était plein (événement perdu)
+     */
+    PRECISE_TIME_FORCE_INLINE bool record(uint8_t phase, uint16_t id, uint32_t arg, uint8_t track) {
+        uint32_t pos = head.load();
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & MASK];
+            int32_t lag = (int32_t)(slot->sequence.loadAcquire() + (pos & MASK) - pos);
+            if (lag == 0) {
+                if (head.claim(pos, pos + 1)) break;
+            } else if (lag < 0) {
+                dropped_count.increment();
+                return false;
+            } else {
+                pos = head.load();
+            }
+        }
+        slot->event.timestamp = Time::getTicks();
+        slot->event.arg = arg;
+        slot->event.id = id;
+        slot->event.phase = phase;
+        slot->event.track = track;
+        slot->sequence.storeRelease(pos + 1 - (pos & MASK));
+        return true;
+    }
+
+    PRECISE_TIME_FORCE_INLINE bool begin(uint16_t id, uint32_t arg = 0) {
+        return record(PRECISE_TIME_TRACE_BEGIN, id, arg, currentTrack());
+    }
+
+    PRECISE_TIME_FORCE_INLINE bool end(uint16_t id, uint32_t arg = 0) {
+        return record(PRECISE_TIME_TRACE_END, id, arg, currentTrack());
+    }
+
+    PRECISE_TIME_FORCE_INLINE bool instant(uint16_t id, uint32_t arg = 0) {
+        return record(PRECISE_TIME_TRACE_INSTANT, id, arg, currentTrack());
+    }
+
+    /**
+     * @brief Retire l'événement le plus ancien publié
+     * @return false si l'anneau est vide (ou la case suivante pas encore publiée)
+     */
+    bool pop(PreciseTimeTraceEvent& event) {
+        uint32_t pos = tail.load();
+        Slot& slot = slots[pos & MASK];
+        if (slot.sequence.loadAcquire() + (pos & MASK) != pos + 1) return false;
+        event = slot.event;
+        slot.sequence.storeRelease(pos + CAPACITY - (pos & MASK));
+        tail.storeRelease(pos + 1);
+        return true;
+    }
+
+    /**
+     * @brief Retire jusqu'à `max` événements dans `out`
+     * @return Nombre d'événements copiés
+     */
+    uint32_t drain(PreciseTimeTraceEvent* out, uint32_t max) {
+        uint32_t count = 0;
+        while (count < max && pop(out[count])) count++;
+        return count;
+    }
+
+    /**
+     * @brief Événements réservés et pas encore retirés (approximatif si des
+     *        producteurs sont actifs)
+     */
+    uint32_t size() const {
+        uint32_t used = head.load() - tail.load();
+        return used < CAPACITY ? used : CAPACITY;
+    }
+
+    uint32_t capacity() const { return CAPACITY; }
+
+    uint32_t dropped() const { return dropped_count.load(); }
+
+    /**
+     * @brief Écrit un événement en objet JSON Chrome, sans virgule ni
+     *        retour à la ligne ; `out` doit offrir 224 octets
+     * @return Octets écrits
+     */
+    size_t formatChromeEvent(char* out, const PreciseTimeTraceEvent& event) const {
+        size_t length = appendText(out, "{\"name\":");
+        length += appendName(out + length, event.id);
+        length += appendText(out + length, ",\"ph\":\"");
+        out[length++] = (char)event.phase;
+        length += appendText(out + length, "\",\"ts\":");
+        length += appendMicros(out + length, event.timestamp);
+        length += appendText(out + length, ",\"pid\":1,\"tid\":");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, event.track);
+        if (event.phase == PRECISE_TIME_TRACE_INSTANT) {
+            length += appendText(out + length, ",\"s\":\"t\"");
+        }
+        length += appendText(out + length, ",\"args\":{\"arg\":");
+        length += PreciseTimeFormatter::appendUnsigned(out + length, event.arg);
+        length += appendText(out + length, "}}");
+        return length;
+    }
+
+    /**
+     * @brief Vide l'anneau en JSON Chrome Trace Event, un événement par
+     *        ligne, lisible par Perfetto (ui.perfetto.dev) et chrome://tracing
+     *
+     * `out` est un Print& ou tout objet fournissant write(const uint8_t*, size_t).
+     * Le nombre d'événements perdus est reporté dans "otherData".
+     * @return Octets écrits
+     */
+    template <class Output>
+    size_t exportChromeJson(Output& out) {
+        char line[256];
+        size_t written = 0;
+        size_t length = appendText(line, "{\"traceEvents\":[\n");
+        written += out.write((const uint8_t*)line, length);
+
+        PreciseTimeTraceEvent event;
+        bool first = true;
+        while (pop(event)) {
+            length = 0;
+            if (!first) line[length++] = ',';
+            first = false;
+            length += formatChromeEvent(line + length, event);
+            line[length++] = '\n';
+            written += out.write((const uint8_t*)line, length);
+        }
+
+        length = appendText(line, "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":");
+        length += PreciseTimeFormatter::appendUnsigned(line + length, dropped());
+        length += appendText(line + length, "}}\n");
+        written += out.write((const uint8_t*)line, length);
+        return written;
+    }
+};
+
+/**
+ * @brief Tampon de trace de l'horloge par défaut
+ */
+typedef PreciseTimeTraceBuffer<PreciseTime> PreciseTimeTrace;
+
+/**
+ * @brief Événements sur PreciseTimeTrace::instance() ; `id` est un entier
+ *        (nommé par PreciseTimeTrace::instance().setName())
+ */
+#define PRECISE_TRACE_BEGIN(id)         PreciseTimeTrace::instance().begin(id)
+#define PRECISE_TRACE_END(id)           PreciseTimeTrace::instance().end(id)
+#define PRECISE_TRACE_INSTANT(id, arg)  PreciseTimeTrace::instance().instant(id, arg)
+
+#endif // PRECISE_TIME_TRACE_H
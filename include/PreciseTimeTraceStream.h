@@ -0,0 +1,372 @@
+/**
+ * @file PreciseTimeTraceStream.h
+ * @brief Flux binaire compact d'événements de trace : horodatages en
+ *        deltas varint (LEB128), trames de synchronisation absolues
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_TRACE_STREAM_H
+#define PRECISE_TIME_TRACE_STREAM_H
+
+#include "PreciseTimeTrace.h"
+
+/*
+ * Format (version 1), une suite de trames dont le premier octet est l'étiquette :
+ *
+ *   Événement  0x00..0xEF  étiquette = piste << 3 | arg présent << 2 | phase
+ *                          (phase 0 = début, 1 = fin, 2 = ponctuel)
+ *                          varint zigzag : horodatage - horodatage précédent
+ *                          varint : identifiant
+ *                          varint : argument, si présent (non nul)
+ *   Sync       0xF0 'P' 'T' 0x01
+ *                          varint : ticks par seconde
+ *                          varint : horodatage absolu
+ *                          varint : événements perdus (cumul côté producteur)
+ *   Nom        0xF1        varint : identifiant, varint : longueur (<= 48),
+ *                          octets du nom
+ *
+ * Les varints sont en LEB128 non signé (7 bits par octet, poids faibles
+ * d'abord). Les deltas sont signés (zigzag) car des producteurs concurrents
+ * peuvent publier dans le désordre à quelques ticks près. Après une perte
+ * d'octets, le décodeur cherche la prochaine séquence 0xF0 'P' 'T' et
+ * reprend ; les événements reçus avant la première synchronisation sont
+ * ignorés.
+ */
+
+// Événements entre deux trames de synchronisation
+#ifndef PRECISE_TIME_TRACE_SYNC_INTERVAL
+#define PRECISE_TIME_TRACE_SYNC_INTERVAL  64
+#endif
+
+// Taille maximale produite par un appel à encode() (sync + événement)
+#define PRECISE_TIME_TRACE_FRAME_MAX  48
+
+// Longueur maximale d'un nom transmis
+#define PRECISE_TIME_TRACE_NAME_MAX  48
+
+// Piste la plus haute codable dans l'étiquette (au-delà : ramenée à 29)
+#define PRECISE_TIME_TRACE_STREAM_MAX_TRACK  29
+
+/**
+ * @brief Entiers LEB128 et zigzag
+ */
+struct PreciseTimeVarint {
+    static size_t put(uint8_t* out, uint64_t value) {
+        size_t length = 0;
+        while (value >= 0x80) {
+            out[length++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        out[length++] = (uint8_t)value;
+        return length;
+    }
+
+    /**
+     * @return Octets lus, 0 si `size` ne suffit pas, -1 si plus de 10 octets
+     */
+    static int get(const uint8_t* data, size_t size, uint64_t& value) {
+        value = 0;
+        for (size_t i = 0; i < 10; i++) {
+            if (i >= size) return 0;
+            value |= (uint64_t)(data[i] & 0x7F) << (7 * i);
+            if ((data[i] & 0x80) == 0) return (int)(i + 1);
+        }
+        return -1;
+    }
+
+    static uint64_t zigzag(int64_t value) {
+        return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    }
+
+    static int64_t unzigzag(uint64_t value) {
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+};
+
+/**
+ * @brief Encodeur côté cible : un état de quelques octets, pas d'allocation
+ */
+class PreciseTimeTraceEncoder {
+public:
+    static const uint8_t TAG_SYNC = 0xF0;
+    static const uint8_t TAG_NAME = 0xF1;
+    static const uint8_t VERSION = 1;
+
+private:
+    uint64_t ticks_per_second;
+    uint64_t last_timestamp;
+    uint32_t interval;
+    uint32_t since_sync;
+    uint32_t dropped_total;
+    bool names_sent;
+
+public:
+    /**
+     * @param tps Fréquence de l'horloge des horodatages (Time::TICKS_PER_SECOND)
+     * @param sync_interval Événements entre deux synchronisations
+     */
+    explicit PreciseTimeTraceEncoder(uint64_t tps,
+                                     uint32_t sync_interval = PRECISE_TIME_TRACE_SYNC_INTERVAL)
+        : ticks_per_second(tps), last_timestamp(0),
+          interval(sync_interval ? sync_interval : 1), since_sync(0),
+          dropped_total(0), names_sent(false) {
+        reset();
+    }
+
+    /**
+     * @brief Le prochain événement sera précédé d'une synchronisation et
+     *        drainTo() renverra les noms (nouveau récepteur)
+     */
+    void reset() {
+        since_sync = interval;
+        names_sent = false;
+    }
+
+    /**
+     * @brief Cumul des pertes reporté dans les synchronisations suivantes
+     */
+    void setDropped(uint32_t total) {
+        dropped_total = total;
+    }
+
+    /**
+     * @brief Trame de synchronisation ; l'horodatage devient la référence
+     * @return Octets écrits (au plus 29)
+     */
+    size_t sync(uint8_t* out, uint64_t timestamp) {
+        size_t length = 0;
+        out[length++] = TAG_SYNC;
+        out[length++] = 'P';
+        out[length++] = 'T';
+        out[length++] = VERSION;
+        length += PreciseTimeVarint::put(out + length, ticks_per_second);
+        length += PreciseTimeVarint::put(out + length, timestamp);
+        length += PreciseTimeVarint::put(out + length, dropped_total);
+        last_timestamp = timestamp;
+        since_sync = 0;
+        return length;
+    }
+
+    /**
+     * @brief Trame associant un nom à un identifiant (tronqué à 48 octets)
+     * @return Octets écrits (au plus 55)
+     */
+    static size_t name(uint8_t* out, uint16_t id, const char* text) {
+        size_t count = 0;
+        while (text[count] != '\0' && count < PRECISE_TIME_TRACE_NAME_MAX) count++;
+        size_t length = 0;
+        out[length++] = TAG_NAME;
+        length += PreciseTimeVarint::put(out + length, id);
+        length += PreciseTimeVarint::put(out + length, count);
+        for (size_t i = 0; i < count; i++) out[length++] = (uint8_t)text[i];
+        return length;
+    }
+
+    /**
+     * @brief Encode un événement, précédé d'une synchronisation si besoin
+     * @param out Au moins PRECISE_TIME_TRACE_FRAME_MAX octets
+     * @return Octets écrits
+     */
+    size_t encode(uint8_t* out, const PreciseTimeTraceEvent& event) {
+        size_t length = 0;
+        if (since_sync >= interval) length = sync(out, event.timestamp);
+        since_sync++;
+
+        uint8_t phase = event.phase == PRECISE_TIME_TRACE_BEGIN ? 0
+                      : event.phase == PRECISE_TIME_TRACE_END ? 1 : 2;
+        uint8_t track = event.track < PRECISE_TIME_TRACE_STREAM_MAX_TRACK
+                      ? event.track : PRECISE_TIME_TRACE_STREAM_MAX_TRACK;
+        out[length++] = (uint8_t)((track << 3) | (event.arg != 0 ? 4 : 0) | phase);
+        length += PreciseTimeVarint::put(out + length,
+            PreciseTimeVarint::zigzag((int64_t)(event.timestamp - last_timestamp)));
+        length += PreciseTimeVarint::put(out + length, event.id);
+        if (event.arg != 0) length += PreciseTimeVarint::put(out + length, event.arg);
+        last_timestamp = event.timestamp;
+        return length;
+    }
+
+    /**
+     * @brief Écrit un événement sur `out` (Print& ou write(const uint8_t*, size_t))
+     */
+    template <class Output>
+    size_t write(Output& out, const PreciseTimeTraceEvent& event) {
+        uint8_t frame[PRECISE_TIME_TRACE_FRAME_MAX];
+        return out.write(frame, encode(frame, event));
+    }
+
+    /**
+     * @brief Vide un PreciseTimeTraceBuffer sur `out` ; au premier appel
+     *        (ou après reset()), envoie d'abord les noms enregistrés
+     * @return Octets écrits
+     */
+    template <class Buffer, class Output>
+    size_t drainTo(Buffer& buffer, Output& out) {
+        size_t written = 0;
+        uint8_t frame[PRECISE_TIME_TRACE_NAME_MAX + 8];
+        if (!names_sent) {
+            for (uint16_t id = 0; id < PRECISE_TIME_TRACE_MAX_NAMES; id++) {
+                if (buffer.name(id) != nullptr) {
+                    written += out.write(frame, name(frame, id, buffer.name(id)));
+                }
+            }
+            names_sent = true;
+        }
+        setDropped(buffer.dropped());
+        PreciseTimeTraceEvent event;
+        while (buffer.pop(event)) written += write(out, event);
+        return written;
+    }
+};
+
+/**
+ * @brief Trame décodée
+ */
+enum PreciseTimeTraceFrameKind {
+    PRECISE_TIME_TRACE_FRAME_EVENT,     ///< `event` valide, horodatage absolu
+    PRECISE_TIME_TRACE_FRAME_SYNC,      ///< `event.timestamp`, `ticks_per_second`, `dropped`
+    PRECISE_TIME_TRACE_FRAME_NAME,      ///< `event.id`, `name`
+    PRECISE_TIME_TRACE_FRAME_SKIPPED    ///< Octets ignorés (corruption, pas encore synchronisé)
+};
+
+struct PreciseTimeTraceFrame {
+    PreciseTimeTraceFrameKind kind;
+    PreciseTimeTraceEvent event;
+    uint64_t ticks_per_second;
+    uint32_t dropped;
+    char name[PRECISE_TIME_TRACE_NAME_MAX + 1];
+};
+
+/**
+ * @brief Décodeur incrémental (outil hôte, tests)
+ *
+ * next() lit une trame au début de `data` ; l'appelant avance de la valeur
+ * renvoyée et rappelle next(). Une trame coupée en fin de tampon renvoie
+ * 0 : compléter le tampon et recommencer au même endroit.
+ */
+class PreciseTimeTraceDecoder {
+private:
+    uint64_t last_timestamp;
+    uint64_t ticks_per_second;
+    bool synced;
+
+    static bool isSyncAt(const uint8_t* data, size_t size, size_t pos) {
+        return pos + 3 <= size && data[pos] == PreciseTimeTraceEncoder::TAG_SYNC
+            && data[pos + 1] == 'P' && data[pos + 2] == 'T';
+    }
+
+    // Perte de synchronisation : sauter jusqu'au prochain marqueur possible
+    size_t resync(const uint8_t* data, size_t size, PreciseTimeTraceFrame& frame) {
+        synced = false;
+        frame.kind = PRECISE_TIME_TRACE_FRAME_SKIPPED;
+        for (size_t pos = 1; pos < size; pos++) {
+            if (isSyncAt(data, size, pos)) return pos;
+            if (pos + 3 > size && data[pos] == PreciseTimeTraceEncoder::TAG_SYNC) return pos;
+        }
+        return size;
+    }
+
+    // Lit un varint à `pos` ; 0 si incomplet, -1 si invalide ou > `max`
+    static int field(const uint8_t* data, size_t size, size_t& pos, uint64_t max, uint64_t& value) {
+        int read = PreciseTimeVarint::get(data + pos, size - pos, value);
+        if (read > 0 && value > max) return -1;
+        if (read > 0) pos += (size_t)read;
+        return read;
+    }
+
+public:
+    PreciseTimeTraceDecoder() : last_timestamp(0), ticks_per_second(0), synced(false) {}
+
+    bool isSynced() const { return synced; }
+    uint64_t ticksPerSecond() const { return ticks_per_second; }
+
+    /**
+     * @return Octets consommés, 0 si la trame est incomplète
+     */
+    size_t next(const uint8_t* data, size_t size, PreciseTimeTraceFrame& frame) {
+        if (size == 0) return 0;
+        uint8_t tag = data[0];
+        size_t pos = 1;
+        uint64_t a, b, c;
+        int read;
+
+        if (tag == PreciseTimeTraceEncoder::TAG_SYNC) {
+            if (size < 4) return 0;
+            if (data[1] != 'P' || data[2] != 'T' || data[3] != PreciseTimeTraceEncoder::VERSION) {
+                return resync(data, size, frame);
+            }
+            pos = 4;
+            if ((read = field(data, size, pos, UINT64_MAX, a)) <= 0
+                || (read = field(data, size, pos, UINT64_MAX, b)) <= 0
+                || (read = field(data, size, pos, UINT32_MAX, c)) <= 0) {
+                return read == 0 ? 0 : resync(data, size, frame);
+            }
+            if (a == 0) return resync(data, size, frame);
+            ticks_per_second = a;
+            last_timestamp = b;
+            synced = true;
+            frame.kind = PRECISE_TIME_TRACE_FRAME_SYNC;
+            frame.event.timestamp = b;
+            frame.ticks_per_second = a;
+            frame.dropped = (uint32_t)c;
+            return pos;
+        }
+
+        if (tag == PreciseTimeTraceEncoder::TAG_NAME) {
+            if ((read = field(data, size, pos, UINT16_MAX, a)) <= 0
+                || (read = field(data, size, pos, PRECISE_TIME_TRACE_NAME_MAX, b)) <= 0) {
+                return read == 0 ? 0 : resync(data, size, frame);
+            }
+            if (size - pos < b) return 0;
+            frame.kind = PRECISE_TIME_TRACE_FRAME_NAME;
+            frame.event.id = (uint16_t)a;
+            for (size_t i = 0; i < b; i++) frame.name[i] = (char)data[pos + i];
+            frame.name[b] = '\0';
+            return pos + (size_t)b;
+        }
+
+        if (tag > 0xEF || (tag & 3) == 3) return resync(data, size, frame);
+        if ((read = field(data, size, pos, UINT64_MAX, a)) <= 0
+            || (read = field(data, size, pos, UINT16_MAX, b)) <= 0) {
+            return read == 0 ? 0 : resync(data, size, frame);
+        }
+        c = 0;
+        if ((tag & 4) != 0 && (read = field(data, size, pos, UINT32_MAX, c)) <= 0) {
+            return read == 0 ? 0 : resync(data, size, frame);
+        }
+        if (!synced) {
+            frame.kind = PRECISE_TIME_TRACE_FRAME_SKIPPED;
+            return pos;
+        }
+        static const uint8_t phases[3] = {
+            PRECISE_TIME_TRACE_BEGIN, PRECISE_TIME_TRACE_END, PRECISE_TIME_TRACE_INSTANT
+        };
+        last_timestamp += (uint64_t)PreciseTimeVarint::unzigzag(a);
+        frame.kind = PRECISE_TIME_TRACE_FRAME_EVENT;
+        frame.event.timestamp = last_timestamp;
+        frame.event.arg = (uint32_t)c;
+        frame.event.id = (uint16_t)b;
+        frame.event.phase = phases[tag & 3];
+        frame.event.track = (uint8_t)(tag >> 3);
+        return pos;
+    }
+};
+
+#endif // PRECISE_TIME_TRACE_STREAM_H
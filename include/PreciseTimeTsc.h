@@ -0,0 +1,137 @@
+/**
+ * @file PreciseTimeTsc.h
+ * @brief Horloge native x86-64 sur le TSC invariant, calibrée au démarrage
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_TSC_H
+#define PRECISE_TIME_TSC_H
+
+#include <stdint.h>
+
+#if defined(__x86_64__) && !defined(ARDUINO)
+#define PRECISE_TIME_HAS_TSC
+#include <time.h>
+#include <cpuid.h>
+#include <x86intrin.h>
+
+/**
+ * @brief Conversion ticks TSC → nanosecondes par multiplication-décalage
+ *
+ * calibrate() mesure la fréquence du TSC contre CLOCK_MONOTONIC sur une
+ * courte fenêtre, puis fixe ns = base_ns + (ticks - base_ticks) * mult >> 32.
+ * Le produit est fait sur 128 bits : aucun débordement, aucune division
+ * par appel.
+ *
+ * Sans TSC invariant (fréquence variable, arrêt en veille profonde) ou
+ * sans RDTSCP, calibrate() renvoie false et l'appelant garde son horloge.
+ */
+class PreciseTimeTsc {
+private:
+    uint64_t base_ticks;
+    uint64_t base_ns;
+    uint64_t mult;          // ns par tick en virgule fixe 32.32
+    uint64_t hz;
+
+    static uint64_t monotonicNanos() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    }
+
+    // Encadre la lecture du TSC par deux lectures de l'horloge de
+    // référence et garde le point milieu de l'encadrement le plus serré.
+    static void sample(uint64_t& ticks, uint64_t& ns) {
+        uint64_t best_window = UINT64_MAX;
+        for (int i = 0; i < 8; i++) {
+            uint64_t before = monotonicNanos();
+            uint64_t t = read();
+            uint64_t after = monotonicNanos();
+            if (after - before < best_window) {
+                best_window = after - before;
+                ticks = t;
+                ns = before + (after - before) / 2;
+            }
+        }
+    }
+
+public:
+    constexpr PreciseTimeTsc() : base_ticks(0), base_ns(0), mult(0), hz(0) {}
+
+    /**
+     * @brief TSC à fréquence constante et RDTSCP disponibles
+     */
+    static bool supported() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+            return false;
+        }
+        __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx);
+        bool rdtscp = (edx & (1U << 27)) != 0;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        bool invariant = (edx & (1U << 8)) != 0;
+        return rdtscp && invariant;
+    }
+
+    static inline uint64_t read() {
+        unsigned int aux;
+        return __rdtscp(&aux);
+    }
+
+    /**
+     * @brief Mesure la fréquence du TSC
+     * @param window_ns Durée de la mesure (10 ms donnent ~1 ppm)
+     * @return false si le TSC n'est pas utilisable
+     */
+    bool calibrate(uint64_t window_ns = 10000000ULL) {
+        if (!supported()) return false;
+        uint64_t t0 = 0, ns0 = 0, t1 = 0, ns1 = 0;
+        sample(t0, ns0);
+        while (monotonicNanos() - ns0 < window_ns) {
+        }
+        sample(t1, ns1);
+        if (t1 <= t0 || ns1 <= ns0) return false;
+
+        hz = (uint64_t)((unsigned __int128)(t1 - t0) * 1000000000ULL / (ns1 - ns0));
+        mult = (uint64_t)(((unsigned __int128)(ns1 - ns0) << 32) / (t1 - t0));
+        base_ticks = t1;
+        base_ns = ns1;
+        return mult != 0;
+    }
+
+    inline uint64_t toNanoseconds(uint64_t ticks) const {
+        return base_ns + (uint64_t)(((unsigned __int128)(ticks - base_ticks) * mult) >> 32);
+    }
+
+    /**
+     * @brief Nanosecondes sur la même origine que CLOCK_MONOTONIC
+     */
+    inline uint64_t nanoseconds() const {
+        return toNanoseconds(read());
+    }
+
+    uint64_t frequencyHz() const {
+        return hz;
+    }
+};
+#endif
+
+#endif // PRECISE_TIME_TSC_H
@@ -0,0 +1,71 @@
+/**
+ * @file PreciseTimeWrapExtender.h
+ * @brief Extension sans verrou d'un compteur 32 bits en compteur 63 bits
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRECISE_TIME_WRAP_EXTENDER_H
+#define PRECISE_TIME_WRAP_EXTENDER_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Déduit le mot haut d'un compteur 32 bits de ses seuls débordements
+ *
+ * L'état tient dans un unique mot de 32 bits : les bits 30..0 comptent
+ * les débordements observés, le bit 31 mémorise le bit de poids fort du
+ * compteur lors de la dernière mise à jour. L'état est lu avant le
+ * compteur ; si leurs bits de poids fort diffèrent, le compteur a franchi
+ * une demi-période et l'état est avancé (le compte de débordements
+ * augmente quand le bit repasse de 1 à 0).
+ *
+ * Deux contextes (boucle et ISR) qui détectent la même transition
+ * calculent et écrivent la même valeur : aucun verrou n'est nécessaire.
+ * Seule contrainte : read() doit être appelé au moins une fois par
+ * demi-période du compteur (2^31 µs, soit ~35 minutes pour micros()).
+ *
+ * Le résultat couvre 63 bits, soit ~292 000 ans en microsecondes.
+ */
+class PreciseTimeWrapExtender {
+private:
+    std::atomic<uint32_t> high_state;
+
+public:
+    constexpr PreciseTimeWrapExtender() : high_state(0) {}
+
+    /**
+     * @brief Lit la source et renvoie sa valeur étendue à 63 bits
+     * @param source Fonction ou foncteur renvoyant le compteur 32 bits
+     */
+    template <class Source>
+    uint64_t read(Source source) {
+        uint32_t high = high_state.load(std::memory_order_acquire);
+        uint32_t low = source();
+        if ((int32_t)(high ^ low) < 0) {
+            high = (high ^ 0x80000000UL) + (high >> 31);
+            high_state.store(high, std::memory_order_release);
+        }
+        return ((uint64_t)(high & 0x7FFFFFFFUL) << 32) | low;
+    }
+};
+
+#endif // PRECISE_TIME_WRAP_EXTENDER_H
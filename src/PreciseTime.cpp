@@ -0,0 +1,35 @@
+/**
+ * @file PreciseTime.cpp
+ * @brief Définitions hors en-tête : ISR placées une seule fois en IRAM
+ * @version 1.1.0
+ * @date 2026-10-16
+ *
+ * @license GPL-3.0
+ *
+ * Copyright (C) 2025
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PreciseTime.h"
+
+#if defined(ESP32)
+// Tout le corps est en IRAM : timerMux(), time_fct_micros() et
+// PreciseTimeSeqlock64::increment() sont inlinés de force
+void IRAM_ATTR PreciseTimeEsp32IsrBackend::timerISR() {
+    portENTER_CRITICAL_ISR(&timerMux());
+    time_fct_micros().increment();
+    portEXIT_CRITICAL_ISR(&timerMux());
+}
+#endif
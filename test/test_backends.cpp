@@ -0,0 +1,109 @@
+/**
+ * @file test_backends.cpp
+ * @brief Tests de PreciseTimeT<Backend> avec des backends de test
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTime.h>
+
+/**
+ * @brief Backend piloté à la main, à fréquence de ticks quelconque
+ */
+template <uint64_t HZ>
+struct ManualBackend {
+    static const uint64_t TICKS_PER_SECOND = HZ;
+    static uint64_t ticks;
+    static int begins;
+
+    static void begin() { begins++; ticks = 0; }
+    static uint64_t now_ticks() { return ticks; }
+    static void reset() { ticks = 0; }
+    static void update() {}
+};
+
+template <uint64_t HZ> uint64_t ManualBackend<HZ>::ticks = 0;
+template <uint64_t HZ> int ManualBackend<HZ>::begins = 0;
+
+typedef ManualBackend<1000ULL> MillisLike;
+typedef ManualBackend<32768ULL> RtcLike;
+typedef PreciseTimeT<MillisLike> MillisTime;
+typedef PreciseTimeT<RtcLike> RtcTime;
+
+void test_backend_not_initialized_reads_zero() {
+    MillisLike::ticks = 1234;
+    TEST_ASSERT_FALSE(MillisTime::isInitialized());
+    TEST_ASSERT_EQUAL_UINT64(0, MillisTime::getMicroseconds());
+    MillisTime::begin();
+    MillisTime::begin();
+    TEST_ASSERT_EQUAL_INT(1, MillisLike::begins);
+}
+
+void test_backend_conversions_millisecond_ticks() {
+    MillisTime::begin();
+    MillisLike::ticks = 90061001ULL;    // 1 j 1 h 1 min 1 s 1 ms
+    TEST_ASSERT_EQUAL_UINT64(90061001000000ULL, MillisTime::getNanoseconds());
+    TEST_ASSERT_EQUAL_UINT64(90061001000ULL, MillisTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(90061001ULL, MillisTime::getMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(90061ULL, MillisTime::getSeconds());
+
+    uint64_t days;
+    uint32_t hours, minutes, seconds;
+    MillisTime::getFormattedTime(days, hours, minutes, seconds);
+    TEST_ASSERT_EQUAL_UINT64(1, days);
+    TEST_ASSERT_EQUAL_UINT32(1, hours);
+    TEST_ASSERT_EQUAL_UINT32(1, minutes);
+    TEST_ASSERT_EQUAL_UINT32(1, seconds);
+}
+
+void test_backend_conversions_non_decimal_ticks() {
+    RtcTime::begin();
+    RtcLike::ticks = 32768ULL * 3 + 16384;   // 3,5 s
+    TEST_ASSERT_EQUAL_UINT64(3500000000ULL, RtcTime::getNanoseconds());
+    TEST_ASSERT_EQUAL_UINT64(3500000ULL, RtcTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(3500ULL, RtcTime::getMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(3ULL, RtcTime::getSeconds());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 3.5, RtcTime::getSecondsPrecise());
+
+    // Pas de débordement intermédiaire pour de grandes valeurs
+    RtcLike::ticks = 32768ULL * 1000000000ULL;
+    TEST_ASSERT_EQUAL_UINT64(1000000000ULL * 1000000ULL, RtcTime::getMicroseconds());
+}
+
+void test_backend_reset_goes_through_policy() {
+    MillisTime::begin();
+    MillisLike::ticks = 5000;
+    MillisTime::reset();
+    TEST_ASSERT_EQUAL_UINT64(0, MillisTime::getMilliseconds());
+}
+
+void test_backends_coexist() {
+    // Deux backends indépendants dans le même programme
+    MillisLike::ticks = 7000;
+    RtcLike::ticks = 32768;
+    TEST_ASSERT_EQUAL_UINT64(7, MillisTime::getSeconds());
+    TEST_ASSERT_EQUAL_UINT64(1, RtcTime::getSeconds());
+#if !defined(ARDUINO)
+    PreciseTimeT<PreciseTimeNativeBackend>::begin();
+    PreciseTimeT<PreciseTimeTscBackend>::begin();
+    TEST_ASSERT_TRUE(PreciseTimeT<PreciseTimeNativeBackend>::isInitialized());
+    TEST_ASSERT_TRUE(PreciseTimeT<PreciseTimeTscBackend>::isInitialized());
+    TEST_ASSERT_LESS_THAN_UINT64(1000000000ULL, PreciseTimeT<PreciseTimeTscBackend>::getNanoseconds());
+#endif
+}
+
+void run_backend_tests() {
+    RUN_TEST(test_backend_not_initialized_reads_zero);
+    RUN_TEST(test_backend_conversions_millisecond_ticks);
+    RUN_TEST(test_backend_conversions_non_decimal_ticks);
+    RUN_TEST(test_backend_reset_goes_through_policy);
+    RUN_TEST(test_backends_coexist);
+}
@@ -13,10 +13,53 @@
  * de la Licence, soit (à votre choix) toute version ultérieure.
  */
 
+#if defined(ARDUINO)
 #include <Arduino.h>
+#else
+#include <time.h>
+#endif
 #include <unity.h>
 #include <PreciseTime.h>
 
+#if defined(PRECISE_TIME_SIMULATED)
+// Horloge virtuelle : attendre revient à avancer le temps simulé
+static void delay(uint32_t ms) {
+    PreciseTimeSimBackend::advance(ms * 1000ULL);
+}
+#elif !defined(ARDUINO)
+// Backend natif : vraie attente, sans couche Arduino
+static void delay(uint32_t ms) {
+    struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, nullptr);
+}
+#endif
+
+// Suites définies dans les autres fichiers de test/
+void run_timer_group_tests();
+void run_seqlock_tests();
+void run_wrap_extender_tests();
+void run_cycle_clock_tests();
+void run_tsc_tests();
+void run_backend_tests();
+void run_sim_tests();
+void run_chrono_tests();
+void run_divide_tests();
+void run_format_tests();
+void run_coarse_tests();
+void run_scope_tests();
+void run_histogram_tests();
+void run_stats_tests();
+void run_trace_tests();
+void run_trace_stream_tests();
+void run_loop_profiler_tests();
+void run_irq_latency_tests();
+void run_benchmark_tests();
+void run_timer_wheel_tests();
+void run_scheduler_tests();
+void run_edf_scheduler_tests();
+void run_sleep_tests();
+void run_idle_tests();
+
 void test_initialization() {
     TEST_ASSERT_FALSE(PreciseTime::isInitialized());
     PreciseTime::begin();
@@ -35,14 +78,18 @@ void test_reset_function() {
     delay(50);
     PreciseTime::reset();
     uint64_t t2 = PreciseTime::getMicroseconds();
-    TEST_ASSERT_LESS_THAN(t2, 1000); // Should be near 0 after reset
+    TEST_ASSERT_LESS_THAN(1000, t2); // Should be near 0 after reset
 }
 
 void test_formatted_string() {
-    String formatted = PreciseTime::getFormattedString();
+    PreciseTimeString formatted = PreciseTime::getFormattedString();
     TEST_ASSERT_TRUE(formatted.length() > 0);
     // Format should be HH:MM:SS or X days, HH:MM:SS
+#if defined(ARDUINO)
     TEST_ASSERT_TRUE(formatted.indexOf(':') > 0);
+#else
+    TEST_ASSERT_TRUE(formatted.find(':') != std::string::npos && formatted.find(':') > 0);
+#endif
 }
 
 void test_overflow_calculation() {
@@ -50,9 +97,30 @@ void test_overflow_calculation() {
     TEST_ASSERT_TRUE(years > 500000); // Should be around 584,942 years
 }
 
-void setup() {
-    delay(2000); // Give time for serial monitor
-    
+#if !defined(ARDUINO) && !defined(PRECISE_TIME_SIMULATED)
+void test_native_nanosecond_resolution() {
+    uint64_t t1 = PreciseTime::getNanoseconds();
+    uint64_t t2 = PreciseTime::getNanoseconds();
+    while (t2 == t1) t2 = PreciseTime::getNanoseconds();
+    TEST_ASSERT_LESS_THAN_UINT64(1000, t2 - t1);
+}
+
+void test_native_measures_real_sleep() {
+    uint64_t t1 = PreciseTime::getMicroseconds();
+    delay(20);
+    uint64_t elapsed = PreciseTime::getMicroseconds() - t1;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(20000, elapsed);
+    TEST_ASSERT_LESS_THAN_UINT64(200000, elapsed);
+}
+
+void test_native_no_update_needed() {
+    uint64_t t1 = PreciseTime::getMilliseconds();
+    delay(5);
+    TEST_ASSERT_GREATER_THAN_UINT64(t1, PreciseTime::getMilliseconds());
+}
+#endif
+
+int runUnityTests() {
     UNITY_BEGIN();
     
     RUN_TEST(test_initialization);
@@ -60,10 +128,51 @@ void setup() {
     RUN_TEST(test_reset_function);
     RUN_TEST(test_formatted_string);
     RUN_TEST(test_overflow_calculation);
+#if !defined(ARDUINO) && !defined(PRECISE_TIME_SIMULATED)
+    RUN_TEST(test_native_nanosecond_resolution);
+    RUN_TEST(test_native_measures_real_sleep);
+    RUN_TEST(test_native_no_update_needed);
+#endif
     
-    UNITY_END();
+    run_timer_group_tests();
+    run_seqlock_tests();
+    run_wrap_extender_tests();
+    run_cycle_clock_tests();
+    run_tsc_tests();
+    run_backend_tests();
+    run_sim_tests();
+    run_chrono_tests();
+    run_divide_tests();
+    run_format_tests();
+    run_coarse_tests();
+    run_scope_tests();
+    run_histogram_tests();
+    run_stats_tests();
+    run_trace_tests();
+    run_trace_stream_tests();
+    run_loop_profiler_tests();
+    run_irq_latency_tests();
+    run_benchmark_tests();
+    run_timer_wheel_tests();
+    run_scheduler_tests();
+    run_edf_scheduler_tests();
+    run_sleep_tests();
+    run_idle_tests();
+    
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+void setup() {
+    delay(2000); // Give time for serial monitor
+    runUnityTests();
 }
 
 void loop() {
     // Empty
-}
\ No newline at end of file
+}
+#else
+int main() {
+    return runUnityTests();
+}
+#endif
\ No newline at end of file
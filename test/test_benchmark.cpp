@@ -0,0 +1,159 @@
+/**
+ * @file test_benchmark.cpp
+ * @brief Tests du harnais PRECISE_BENCHMARK sur l'horloge virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeBenchmark.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeBenchmarkRunner<SimTime> SimRunner;
+
+struct BenchmarkCapture {
+    char text[1024];
+    size_t length;
+
+    BenchmarkCapture() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+// Chaque itération coûte exactement 3 µs virtuelles
+PRECISE_BENCHMARK_CLOCK(SimTime, sim_three_us) {
+    PreciseTimeSimBackend::advance(3);
+}
+
+PRECISE_BENCHMARK_CLOCK(SimTime, sim_one_us) {
+    PreciseTimeSimBackend::advance(1);
+}
+
+// Ne fait pas avancer l'horloge : aussi rapide que la boucle vide
+PRECISE_BENCHMARK_CLOCK(SimTime, sim_free) {
+}
+
+static void benchmark_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+}
+
+void test_benchmark_registry() {
+    TEST_ASSERT_EQUAL_UINT32(3, PreciseTimeBenchmarkRegistry<SimTime>::size());
+    TEST_ASSERT_EQUAL_UINT32(0, PreciseTimeBenchmarkRegistry<SimTime>::dropped());
+    TEST_ASSERT_EQUAL_STRING("sim_three_us", PreciseTimeBenchmarkRegistry<SimTime>::at(0).name);
+}
+
+void test_benchmark_summarize_rejects_outliers() {
+    double values[] = { 10, 12, 11, 9, 10, 13, 100, 11, 10 };
+    PreciseTimeBenchmarkResult result;
+    SimRunner::summarize(values, 9, result);
+    // Médiane 11, MAD 1 : seul 100 dépasse 3 × 1,4826
+    TEST_ASSERT_EQUAL_UINT32(9, result.samples);
+    TEST_ASSERT_EQUAL_UINT32(8, result.kept);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 10.5, result.median_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.5, result.mad_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 9.0, result.min_ns);
+
+    double flat[] = { 4, 4, 4 };
+    SimRunner::summarize(flat, 3, result);
+    TEST_ASSERT_EQUAL_UINT32(3, result.kept);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, result.mad_ns);
+}
+
+void test_benchmark_run_scales_and_subtracts() {
+    benchmark_setup();
+    PreciseTimeBenchmarkResult result = SimRunner::run(PreciseTimeBenchmarkRegistry<SimTime>::at(0));
+    // Un échantillon dure au moins PRECISE_TIME_BENCHMARK_SAMPLE_US
+    TEST_ASSERT_TRUE((uint64_t)result.iterations * 3 >= PRECISE_TIME_BENCHMARK_SAMPLE_US);
+    TEST_ASSERT_TRUE((uint64_t)result.iterations * 3 <= 4 * PRECISE_TIME_BENCHMARK_SAMPLE_US);
+    TEST_ASSERT_EQUAL_UINT32(PRECISE_TIME_BENCHMARK_SAMPLES, result.kept);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 3000.0, result.median_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, result.mad_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, result.overhead_ns);
+    TEST_ASSERT_FALSE(result.below_resolution);
+
+    result = SimRunner::run(PreciseTimeBenchmarkRegistry<SimTime>::at(1));
+    TEST_ASSERT_EQUAL_STRING("sim_one_us", result.name);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1000.0, result.median_ns);
+}
+
+void test_benchmark_summarize_keeps_negative_samples() {
+    // Durées nettes autour de 0 : les ramener à 0 donnerait médiane 0,5 et MAD 0,5
+    double values[] = { -2, -1, 1, 2, -1, 1, 0, -2 };
+    PreciseTimeBenchmarkResult result;
+    SimRunner::summarize(values, 8, result);
+    TEST_ASSERT_EQUAL_UINT32(8, result.kept);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -0.5, result.median_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.5, result.mad_ns);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -2.0, result.min_ns);
+}
+
+void test_benchmark_below_resolution() {
+    benchmark_setup();
+    PreciseTimeBenchmarkResult result = SimRunner::run(PreciseTimeBenchmarkRegistry<SimTime>::at(2));
+    TEST_ASSERT_EQUAL_STRING("sim_free", result.name);
+    TEST_ASSERT_TRUE(result.below_resolution);
+    // Un tick (1 µs) réparti sur les itérations d'un échantillon
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1000.0 / result.iterations, result.resolution_ns);
+
+    BenchmarkCapture text;
+    TEST_ASSERT_EQUAL_UINT32(1, SimRunner::runAll(text, false, "free"));
+    TEST_ASSERT_NOT_NULL(strstr(text.text, " ns, sous la résolution  n="));
+    TEST_ASSERT_NULL(strstr(text.text, "0.00 ns ±"));
+
+    BenchmarkCapture json;
+    TEST_ASSERT_EQUAL_UINT32(1, SimRunner::runAll(json, true, "free"));
+    TEST_ASSERT_NOT_NULL(strstr(json.text, "\"below_resolution\":true}"));
+    PreciseTimeSimBackend::clear();
+}
+
+void test_benchmark_text_and_json() {
+    benchmark_setup();
+    BenchmarkCapture text;
+    TEST_ASSERT_EQUAL_UINT32(1, SimRunner::runAll(text, false, "three"));
+    TEST_ASSERT_NOT_NULL(strstr(text.text, "  sim_three_us"));
+    TEST_ASSERT_NOT_NULL(strstr(text.text, "   3000.00 ns ±   0.00  n="));
+
+    SimRunner::setCpuMHz(160.0);
+    BenchmarkCapture json;
+    TEST_ASSERT_EQUAL_UINT32(1, SimRunner::runAll(json, true, "three"));
+    SimRunner::setCpuMHz(0.0);
+    TEST_ASSERT_EQUAL_UINT32(0, strncmp(json.text,
+        "{\"clock_ticks_per_second\":1000000,\"cpu_mhz\":160.000,\"benchmarks\":[\n"
+        "{\"name\":\"sim_three_us\",\"iterations\":",
+        strlen("{\"clock_ticks_per_second\":1000000,\"cpu_mhz\":160.000,\"benchmarks\":[\n"
+               "{\"name\":\"sim_three_us\",\"iterations\":")));
+    TEST_ASSERT_NOT_NULL(strstr(json.text, "\"median_ns\":3000.000,\"mad_ns\":0.000,"
+                                           "\"min_ns\":3000.000,\"overhead_ns\":0.000,"
+                                           "\"resolution_ns\":1.200,\"below_resolution\":false,"
+                                           "\"cycles\":480.0}\n]}\n"));
+
+    BenchmarkCapture none;
+    TEST_ASSERT_EQUAL_UINT32(0, SimRunner::runAll(none, false, "absent"));
+    PreciseTimeSimBackend::clear();
+}
+
+void run_benchmark_tests() {
+    RUN_TEST(test_benchmark_registry);
+    RUN_TEST(test_benchmark_summarize_rejects_outliers);
+    RUN_TEST(test_benchmark_run_scales_and_subtracts);
+    RUN_TEST(test_benchmark_summarize_keeps_negative_samples);
+    RUN_TEST(test_benchmark_below_resolution);
+    RUN_TEST(test_benchmark_text_and_json);
+}
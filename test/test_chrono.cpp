@@ -0,0 +1,107 @@
+/**
+ * @file test_chrono.cpp
+ * @brief Tests de PreciseTimeT<Backend>::clock (std::chrono)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTime.h>
+
+#if defined(PRECISE_TIME_HAS_CHRONO)
+#include <type_traits>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+/**
+ * Facteur appliqué par duration_cast<To>(From) : avec den == 1 la
+ * conversion est une multiplication par une constante (num == 1 :
+ * identité), jamais une division à l'exécution.
+ */
+template <class From, class To>
+struct CastIsMultiply {
+    typedef std::ratio_divide<typename From::period, typename To::period> factor;
+    static const bool value = (factor::den == 1);
+};
+
+template <class Clock>
+struct ClockChecks {
+    typedef typename Clock::duration duration;
+
+    // Exigences TrivialClock
+    static_assert(std::is_same<typename duration::rep, typename Clock::rep>::value, "rep");
+    static_assert(std::is_same<typename duration::period, typename Clock::period>::value, "period");
+    static_assert(std::is_same<typename Clock::time_point::clock, Clock>::value, "time_point");
+    static_assert(std::is_same<decltype(Clock::now()), typename Clock::time_point>::value, "now()");
+    static_assert(noexcept(Clock::now()), "now() noexcept");
+
+    // now() renvoie le tick natif : aucune conversion
+    static_assert(CastIsMultiply<duration, duration>::factor::num == 1
+                  && CastIsMultiply<duration, duration>::factor::den == 1, "tick natif");
+    static_assert(CastIsMultiply<duration, std::chrono::nanoseconds>::value,
+                  "vers ns : multiplication seule");
+};
+
+static_assert(sizeof(ClockChecks<SimTime::clock>) > 0, "");
+static_assert(sizeof(ClockChecks<PreciseTime::clock>) > 0, "");
+#if !defined(ARDUINO)
+static_assert(sizeof(ClockChecks<PreciseTimeT<PreciseTimeNativeBackend>::clock>) > 0, "");
+static_assert(sizeof(ClockChecks<PreciseTimeT<PreciseTimeTscBackend>::clock>) > 0, "");
+static_assert(std::is_same<PreciseTimeT<PreciseTimeNativeBackend>::clock::period, std::nano>::value,
+              "backend natif : période 1 ns");
+#endif
+
+static_assert(std::is_same<SimTime::clock::period, std::micro>::value, "sim : période 1 µs");
+static_assert(CastIsMultiply<SimTime::clock::duration, std::chrono::microseconds>::factor::num == 1,
+              "sim vers µs : identité");
+static_assert(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  SimTime::clock::duration(3)).count() == 3000,
+              "conversion évaluée à la compilation");
+
+void test_chrono_clock_follows_backend() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+
+    SimTime::clock::time_point t1 = SimTime::clock::now();
+    TEST_ASSERT_EQUAL_INT64(0, t1.time_since_epoch().count());
+    PreciseTimeSimBackend::advance(2500);
+    SimTime::clock::time_point t2 = SimTime::clock::now();
+
+    TEST_ASSERT_EQUAL_INT64(2500, (t2 - t1).count());
+    TEST_ASSERT_EQUAL_INT64(2500000,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count());
+    TEST_ASSERT_EQUAL_INT64(2,
+        std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count());
+    TEST_ASSERT_TRUE(t2 - t1 > std::chrono::milliseconds(2));
+    TEST_ASSERT_TRUE(t1 + std::chrono::microseconds(2500) == t2);
+    TEST_ASSERT_EQUAL_UINT64(SimTime::getMicroseconds(),
+                             (uint64_t)t2.time_since_epoch().count());
+    PreciseTimeSimBackend::clear();
+}
+
+void test_chrono_default_clock_monotonic() {
+    PreciseTime::begin();
+    PreciseTime::clock::time_point previous = PreciseTime::clock::now();
+    for (int i = 0; i < 1000; i++) {
+        PreciseTime::clock::time_point current = PreciseTime::clock::now();
+        TEST_ASSERT_TRUE(current >= previous);
+        previous = current;
+    }
+}
+
+void run_chrono_tests() {
+    RUN_TEST(test_chrono_clock_follows_backend);
+    RUN_TEST(test_chrono_default_clock_monotonic);
+}
+#else
+void run_chrono_tests() {
+}
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file test_coarse.cpp
+ * @brief Tests de l'horloge grossière (getCoarseMilliseconds)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTime.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+void test_coarse_published_each_period() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    TEST_ASSERT_EQUAL_UINT64(0, SimTime::getCoarseMilliseconds());
+
+    SimTime::beginCoarse(1);
+    PreciseTimeSimBackend::advance(5500);
+    TEST_ASSERT_EQUAL_UINT64(5, SimTime::getCoarseMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(5, SimTime::getMilliseconds());
+
+    // Entre deux publications la valeur ne bouge pas
+    PreciseTimeSimBackend::advance(499);
+    TEST_ASSERT_EQUAL_UINT64(5, SimTime::getCoarseMilliseconds());
+    PreciseTimeSimBackend::advance(400);
+    TEST_ASSERT_EQUAL_UINT64(6, SimTime::getCoarseMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(6, SimTime::getMilliseconds());
+
+    // Une heure : jamais en avance, en retard d'au plus une période
+    for (int i = 0; i < 3600000; i += 7) {
+        PreciseTimeSimBackend::advance(7000 + (i % 3));
+        uint64_t precise = SimTime::getMilliseconds();
+        uint64_t coarse = SimTime::getCoarseMilliseconds();
+        if (coarse > precise || precise - coarse > 1) {
+            TEST_ASSERT_EQUAL_UINT64(precise, coarse);
+        }
+    }
+}
+
+void test_coarse_follows_reset() {
+    PreciseTimeSimBackend::advance(10000);
+    TEST_ASSERT_TRUE(SimTime::getCoarseMilliseconds() > 0);
+    SimTime::reset();
+    TEST_ASSERT_EQUAL_UINT64(0, SimTime::getCoarseMilliseconds());
+    // Les publications restent sur la grille d'avant reset() : une de retard
+    PreciseTimeSimBackend::advance(3000);
+    TEST_ASSERT_EQUAL_UINT64(3, SimTime::getMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(2, SimTime::getCoarseMilliseconds());
+    PreciseTimeSimBackend::clear();
+}
+
+void test_coarse_restart_after_stop_and_clear() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    SimTime::beginCoarse(1);
+    PreciseTimeSimBackend::advance(2000);
+    TEST_ASSERT_EQUAL_UINT64(2, SimTime::getCoarseMilliseconds());
+
+    // Arrêté : la dernière valeur reste, puis beginCoarse() reprend
+    SimTime::endCoarse();
+    PreciseTimeSimBackend::advance(5000);
+    TEST_ASSERT_EQUAL_UINT64(2, SimTime::getCoarseMilliseconds());
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, PreciseTimeSimBackend::nextDeadline());
+    SimTime::beginCoarse(1);
+    TEST_ASSERT_EQUAL_UINT64(7, SimTime::getCoarseMilliseconds());
+    PreciseTimeSimBackend::advance(1000);
+    TEST_ASSERT_EQUAL_UINT64(8, SimTime::getCoarseMilliseconds());
+
+    // clear() supprime le timer du tick : beginCoarse() le réarme
+    PreciseTimeSimBackend::clear();
+    SimTime::reset();
+    SimTime::beginCoarse(1);
+    PreciseTimeSimBackend::advance(3500);
+    TEST_ASSERT_EQUAL_UINT64(3, SimTime::getCoarseMilliseconds());
+    SimTime::endCoarse();
+    PreciseTimeSimBackend::clear();
+}
+
+#if !defined(ARDUINO)
+void test_coarse_native_ticker() {
+    typedef PreciseTimeT<PreciseTimeNativeBackend> NativeTime;
+    NativeTime::beginCoarse(1);
+    struct timespec ts = { 0, 30 * 1000000L };
+    nanosleep(&ts, nullptr);
+    uint64_t coarse = NativeTime::getCoarseMilliseconds();
+    uint64_t precise = NativeTime::getMilliseconds();
+    TEST_ASSERT_TRUE(coarse >= 10);
+    TEST_ASSERT_TRUE(coarse <= precise);
+    TEST_ASSERT_TRUE(precise - coarse < 50);
+
+    // endCoarse() attend la fin du thread : plus aucune publication ensuite
+    NativeTime::endCoarse();
+    uint64_t frozen = NativeTime::getCoarseMilliseconds();
+    nanosleep(&ts, nullptr);
+    TEST_ASSERT_EQUAL_UINT64(frozen, NativeTime::getCoarseMilliseconds());
+    NativeTime::beginCoarse(1);
+    nanosleep(&ts, nullptr);
+    TEST_ASSERT_TRUE(NativeTime::getCoarseMilliseconds() >= frozen + 10);
+    NativeTime::endCoarse();
+}
+#endif
+
+void run_coarse_tests() {
+    RUN_TEST(test_coarse_published_each_period);
+    RUN_TEST(test_coarse_follows_reset);
+    RUN_TEST(test_coarse_restart_after_stop_and_clear);
+#if !defined(ARDUINO)
+    RUN_TEST(test_coarse_native_ticker);
+#endif
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_cycle_clock.cpp
+ * @brief Tests de l'horloge CCOUNT sur une maquette du compteur de cycles
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeCycleClock.h>
+
+/**
+ * @brief Maquette de CCOUNT : le temps vrai est tenu en cycles 64 bits
+ */
+struct MockCpu {
+    static uint64_t total_cycles;
+    static uint32_t frequency;
+
+    static uint32_t cycles() { return (uint32_t)total_cycles; }
+    static uint32_t mhz() { return frequency; }
+
+    // Avance le temps simulé de `ns` nanosecondes à la fréquence courante
+    static void run(uint64_t ns) { total_cycles += ns * frequency / 1000ULL; }
+};
+
+uint64_t MockCpu::total_cycles = 0;
+uint32_t MockCpu::frequency = 80;
+
+void test_cycle_clock_resolution() {
+    MockCpu::total_cycles = 1000;
+    MockCpu::frequency = 160;
+    PreciseTimeCycleClock<MockCpu> clock;
+    clock.begin();
+    MockCpu::total_cycles += 1;
+    TEST_ASSERT_EQUAL_UINT64(6, clock.nanoseconds());    // 6,25 ns tronqués
+    MockCpu::total_cycles += 3;
+    TEST_ASSERT_EQUAL_UINT64(25, clock.nanoseconds());
+}
+
+void test_cycle_clock_extends_over_wraps() {
+    MockCpu::total_cycles = 0xFFFFF000ULL;
+    MockCpu::frequency = 160;
+    PreciseTimeCycleClock<MockCpu> clock;
+    clock.begin();
+    // 1 heure à 160 MHz = 134 débordements de CCOUNT, lus toutes les 10 s
+    for (int i = 0; i < 360; i++) {
+        MockCpu::run(10000000000ULL);
+        TEST_ASSERT_EQUAL_UINT64((uint64_t)(i + 1) * 10000000000ULL, clock.nanoseconds());
+    }
+    TEST_ASSERT_EQUAL_UINT64(0xFFFFF000ULL + 3600ULL * 160000000ULL, clock.cycles());
+}
+
+void test_cycle_clock_rescales_on_frequency_change() {
+    MockCpu::total_cycles = 0;
+    MockCpu::frequency = 80;
+    PreciseTimeCycleClock<MockCpu> clock;
+    clock.begin();
+    MockCpu::run(1000000000ULL);
+    TEST_ASSERT_EQUAL_UINT64(1000000000ULL, clock.nanoseconds());
+
+    // Lecture juste avant le changement, comme PreciseTime::setCpuFrequencyMHz()
+    MockCpu::frequency = 160;
+    clock.nanoseconds();
+    MockCpu::run(1000000000ULL);
+    TEST_ASSERT_EQUAL_UINT64(2000000000ULL, clock.nanoseconds());
+    TEST_ASSERT_EQUAL_UINT32(160, clock.frequencyMHz());
+
+    MockCpu::frequency = 80;
+    clock.nanoseconds();
+    MockCpu::run(500000000ULL);
+    TEST_ASSERT_EQUAL_UINT64(2500000000ULL, clock.nanoseconds());
+    TEST_ASSERT_EQUAL_UINT64(80000000ULL + 160000000ULL + 40000000ULL, clock.cycles());
+}
+
+void test_cycle_clock_monotonic_across_switches() {
+    MockCpu::total_cycles = 0xF0000000ULL;
+    MockCpu::frequency = 80;
+    PreciseTimeCycleClock<MockCpu> clock;
+    clock.begin();
+    uint64_t previous = 0;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 7 == 0) {
+            MockCpu::frequency = (MockCpu::frequency == 80) ? 160 : 80;
+            clock.nanoseconds();
+        }
+        MockCpu::run(12345600ULL);
+        uint64_t now = clock.nanoseconds();
+        TEST_ASSERT_GREATER_THAN_UINT64(previous, now);
+        previous = now;
+    }
+    TEST_ASSERT_EQUAL_UINT64(1000ULL * 12345600ULL, previous);
+}
+
+void test_cycle_clock_late_detection_is_bounded() {
+    // Sans lecture au moment du changement, les cycles écoulés depuis la
+    // dernière lecture sont comptés à l'ancienne fréquence.
+    MockCpu::total_cycles = 0;
+    MockCpu::frequency = 80;
+    PreciseTimeCycleClock<MockCpu> clock;
+    clock.begin();
+    MockCpu::run(1000000ULL);
+    clock.nanoseconds();
+    MockCpu::frequency = 160;
+    MockCpu::run(1000ULL);
+    TEST_ASSERT_EQUAL_UINT64(1002000ULL, clock.nanoseconds());
+    MockCpu::run(1000ULL);
+    TEST_ASSERT_EQUAL_UINT64(1003000ULL, clock.nanoseconds());
+}
+
+void run_cycle_clock_tests() {
+    RUN_TEST(test_cycle_clock_resolution);
+    RUN_TEST(test_cycle_clock_extends_over_wraps);
+    RUN_TEST(test_cycle_clock_rescales_on_frequency_change);
+    RUN_TEST(test_cycle_clock_monotonic_across_switches);
+    RUN_TEST(test_cycle_clock_late_detection_is_bounded);
+}
@@ -0,0 +1,224 @@
+/**
+ * @file test_divide.cpp
+ * @brief Tests de PreciseTimeDivide contre la division matérielle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeDivide.h>
+#include <PreciseTime.h>
+
+// Diviseur opaque : la référence est une vraie division
+static volatile uint64_t divide_reference_divisor;
+
+template <uint64_t D>
+struct DivideChecker {
+    uint64_t first_bad;
+    uint64_t checked;
+    bool ok;
+
+    DivideChecker() : first_bad(0), checked(0), ok(true) {}
+
+    void check(uint64_t n) {
+        uint64_t d = divide_reference_divisor;
+        checked++;
+        if (PreciseTimeDivide<D>::quotient(n) != n / d
+            || PreciseTimeDivide<D>::remainder(n) != n % d) {
+            if (ok) first_bad = n;
+            ok = false;
+        }
+    }
+
+    void checkAround(uint64_t n) {
+        check(n - 1);
+        check(n);
+        check(n + 1);
+    }
+
+    void run() {
+        divide_reference_divisor = D;
+        // Domaine bas exhaustif
+        for (uint64_t n = 0; n < (1ULL << 20); n++) check(n);
+        // Frontières des multiples de D, en bas et en haut du domaine
+        for (uint64_t k = 1; k < (1ULL << 16); k++) {
+            checkAround(k * D);
+            checkAround((UINT64_MAX / D - k) * D);
+        }
+        checkAround((UINT64_MAX / D) * D);
+        // Autour de chaque puissance de 2 et de ses multiples de D voisins
+        for (int b = 1; b < 64; b++) {
+            uint64_t p = 1ULL << b;
+            checkAround(p);
+            checkAround((p / D) * D);
+            checkAround((p / D + 1) * D);
+        }
+        for (uint64_t j = 0; j < 4096; j++) check(UINT64_MAX - j);
+        // Valeurs quelconques
+        uint64_t x = 0x9E3779B97F4A7C15ULL;
+        for (int i = 0; i < 1000000; i++) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            check(x);
+            check(x >> (i & 63));
+        }
+    }
+};
+
+template <uint64_t D>
+static void check_divisor_64() {
+    DivideChecker<D> checker;
+    checker.run();
+    TEST_ASSERT_EQUAL_UINT64(0, checker.first_bad);
+    TEST_ASSERT_TRUE(checker.ok);
+}
+
+/**
+ * quotient32() : toutes les frontières k*D - 1, k*D du domaine 32 bits,
+ * plus le domaine bas et le haut du domaine
+ */
+template <uint64_t D>
+static void check_divisor_32() {
+    volatile uint32_t dv = (uint32_t)D;
+    uint32_t d = dv;
+    uint32_t first_bad = 0;
+    bool ok = true;
+    for (uint32_t n = 0; n < (1UL << 20); n++) {
+        if (PreciseTimeDivide<D>::quotient32(n) != n / d) { if (ok) first_bad = n; ok = false; }
+    }
+    for (uint64_t m = D; m <= UINT32_MAX; m += D) {
+        uint32_t n = (uint32_t)m;
+        if (PreciseTimeDivide<D>::quotient32(n) != n / d
+            || PreciseTimeDivide<D>::quotient32(n - 1) != (n - 1) / d) {
+            if (ok) first_bad = n;
+            ok = false;
+        }
+    }
+    for (uint32_t j = 0; j < 4096; j++) {
+        uint32_t n = UINT32_MAX - j;
+        if (PreciseTimeDivide<D>::quotient32(n) != n / d) { if (ok) first_bad = n; ok = false; }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, first_bad);
+    TEST_ASSERT_TRUE(ok);
+}
+
+void test_divide_time_divisors_64() {
+    check_divisor_64<60ULL>();
+    check_divisor_64<1000ULL>();
+    check_divisor_64<3600ULL>();
+    check_divisor_64<86400ULL>();
+    check_divisor_64<1000000ULL>();
+    check_divisor_64<1000000000ULL>();
+}
+
+void test_divide_other_divisors_64() {
+    check_divisor_64<2ULL>();
+    check_divisor_64<3ULL>();
+    check_divisor_64<7ULL>();
+    check_divisor_64<32768ULL>();
+    check_divisor_64<1000000007ULL>();
+    check_divisor_64<(1ULL << 63)>();
+    check_divisor_64<(1ULL << 63) - 1>();
+}
+
+void test_divide_time_divisors_32() {
+    check_divisor_32<60ULL>();
+    check_divisor_32<1000ULL>();
+    check_divisor_32<3600ULL>();
+    check_divisor_32<86400ULL>();
+    check_divisor_32<1000000ULL>();
+    check_divisor_32<7ULL>();
+}
+
+void test_divide_formatted_time_matches_division() {
+    // getFormattedTime() sur toutes les secondes de deux journées et
+    // autour de grandes durées
+    typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    uint64_t step_starts[] = { 0ULL, 86400ULL * 49710ULL, 86400ULL * 1000000ULL };
+    for (unsigned s = 0; s < sizeof(step_starts) / sizeof(step_starts[0]); s++) {
+        PreciseTimeSimBackend::clear();
+        PreciseTimeSimBackend::advance(step_starts[s] * 1000000ULL);
+        for (uint32_t i = 0; i < 2 * 86400UL; i++) {
+            uint64_t total = SimTime::getSeconds();
+            uint64_t days;
+            uint32_t hours, minutes, seconds;
+            SimTime::getFormattedTime(days, hours, minutes, seconds);
+            if (days != total / 86400ULL || hours != (total % 86400ULL) / 3600ULL
+                || minutes != (total % 3600ULL) / 60ULL || seconds != total % 60ULL) {
+                TEST_ASSERT_EQUAL_UINT64(total / 86400ULL, days);
+                TEST_ASSERT_EQUAL_UINT32((total % 86400ULL) / 3600ULL, hours);
+                TEST_ASSERT_EQUAL_UINT32((total % 3600ULL) / 60ULL, minutes);
+                TEST_ASSERT_EQUAL_UINT32(total % 60ULL, seconds);
+            }
+            PreciseTimeSimBackend::advance(1000000ULL);
+        }
+    }
+    PreciseTimeSimBackend::clear();
+}
+
+void test_divide_convert_general_ratio() {
+    // 32768 Hz -> µs et ms : cas sans rapport entier entre fréquences
+    uint64_t x = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < 100000; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        uint64_t ticks = x >> 24;
+        uint64_t us = (ticks / 32768ULL) * 1000000ULL + (ticks % 32768ULL) * 1000000ULL / 32768ULL;
+        uint64_t ms = (ticks / 32768ULL) * 1000ULL + (ticks % 32768ULL) * 1000ULL / 32768ULL;
+        TEST_ASSERT_EQUAL_UINT64(us, (PreciseTimeConvert<32768ULL, 1000000ULL>::apply(ticks)));
+        TEST_ASSERT_EQUAL_UINT64(ms, (PreciseTimeConvert<32768ULL, 1000ULL>::apply(ticks)));
+        uint64_t ticks_3k = x >> 20;
+        TEST_ASSERT_EQUAL_UINT64((ticks_3k / 3000ULL) * 1000ULL + (ticks_3k % 3000ULL) * 1000ULL / 3000ULL,
+                                 (PreciseTimeConvert<3000ULL, 1000ULL>::apply(ticks_3k)));
+    }
+}
+
+/**
+ * PreciseTimeReciprocal::divide() : diviseurs d'exécution quelconques,
+ * normalisés ou non, contre la division matérielle
+ */
+void test_divide_runtime_divisor() {
+    const uint32_t divisors[] = { 1, 2, 3, 7, 1000, 65535, 65536, 65537, 0x7FFFFFFFUL,
+                                  0x80000000UL, 0x80000001UL, 0xFFFFFFFEUL, 0xFFFFFFFFUL };
+    for (unsigned k = 0; k < sizeof(divisors) / sizeof(divisors[0]); k++) {
+        divide_reference_divisor = divisors[k];
+        uint64_t d = divide_reference_divisor;
+        for (uint64_t j = 0; j < 4096; j++) {
+            TEST_ASSERT_EQUAL_UINT64(j / d, PreciseTimeReciprocal::divide(j, (uint32_t)d));
+            TEST_ASSERT_EQUAL_UINT64((UINT64_MAX - j) / d,
+                                     PreciseTimeReciprocal::divide(UINT64_MAX - j, (uint32_t)d));
+        }
+    }
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    uint64_t first_bad = 0;
+    bool ok = true;
+    for (int i = 0; i < 1000000; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        divide_reference_divisor = (uint32_t)(x >> (32 + (i & 31))) | 1;
+        uint64_t d = divide_reference_divisor;
+        uint64_t n = x >> ((i >> 5) & 63);
+        if (PreciseTimeReciprocal::divide(n, (uint32_t)d) != n / d) {
+            if (ok) first_bad = n;
+            ok = false;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT64(0, first_bad);
+    TEST_ASSERT_TRUE(ok);
+}
+
+void run_divide_tests() {
+    RUN_TEST(test_divide_time_divisors_64);
+    RUN_TEST(test_divide_other_divisors_64);
+    RUN_TEST(test_divide_time_divisors_32);
+    RUN_TEST(test_divide_formatted_time_matches_division);
+    RUN_TEST(test_divide_convert_general_ratio);
+    RUN_TEST(test_divide_runtime_divisor);
+}
@@ -0,0 +1,218 @@
+/**
+ * @file test_edf_scheduler.cpp
+ * @brief Tests de l'ordonnanceur EDF sur l'horloge virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeEdfScheduler.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeEdfScheduler<SimTime, 256, 2> SimEdf;
+
+struct EdfJob {
+    uint64_t deadline;
+    uint32_t duration;          // µs virtuelles consommées par le travail
+    uint32_t order;             // rang d'exécution, 0 si jamais exécuté
+};
+
+static uint32_t edf_executed;
+
+static void runJob(void* context) {
+    EdfJob* job = (EdfJob*)context;
+    job->order = ++edf_executed;
+    PreciseTimeSimBackend::advance(job->duration);
+}
+
+static void edf_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    edf_executed = 0;
+}
+
+void test_edf_runs_by_deadline() {
+    edf_setup();
+    static SimEdf edf;
+    edf.clear();
+    static EdfJob jobs[200];
+    uint32_t seed = 7;
+    for (int i = 0; i < 200; i++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        jobs[i].deadline = 1000 + (seed >> 12) % 100000;
+        jobs[i].duration = 0;
+        jobs[i].order = 0;
+        TEST_ASSERT_TRUE(edf.submit(jobs[i].deadline, runJob, &jobs[i]) != SimEdf::INVALID_HANDLE);
+    }
+    TEST_ASSERT_EQUAL_UINT32(200, edf.size());
+    TEST_ASSERT_EQUAL_UINT32(200, edf.run());
+    TEST_ASSERT_EQUAL_UINT32(0, edf.size());
+    for (int i = 0; i < 200; i++) {
+        for (int j = 0; j < 200; j++) {
+            if (jobs[i].deadline < jobs[j].deadline) TEST_ASSERT_TRUE(jobs[i].order < jobs[j].order);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(200, edf.classStats(0).completed);
+    TEST_ASSERT_EQUAL_UINT32(0, edf.classStats(0).missed);
+}
+
+void test_edf_decrease_key_and_cancel() {
+    edf_setup();
+    static SimEdf edf;
+    edf.clear();
+    EdfJob a = { 300, 0, 0 }, b = { 200, 0, 0 }, c = { 100, 0, 0 };
+    SimEdf::Handle ha = edf.submit(a.deadline, runJob, &a);
+    SimEdf::Handle hb = edf.submit(b.deadline, runJob, &b);
+    SimEdf::Handle hc = edf.submit(c.deadline, runJob, &c);
+    TEST_ASSERT_EQUAL_UINT64(100, edf.nextDeadline());
+
+    TEST_ASSERT_TRUE(edf.setDeadline(ha, 50));         // décroissance de clé
+    TEST_ASSERT_TRUE(edf.setDeadline(hc, 400));        // croissance
+    TEST_ASSERT_EQUAL_UINT64(50, edf.nextDeadline());
+    TEST_ASSERT_EQUAL_UINT64(400, edf.deadline(hc));
+    TEST_ASSERT_TRUE(edf.cancel(hb));
+    TEST_ASSERT_FALSE(edf.cancel(hb));
+    TEST_ASSERT_FALSE(edf.isPending(hb));
+
+    TEST_ASSERT_EQUAL_UINT32(2, edf.run());
+    TEST_ASSERT_EQUAL_UINT32(1, a.order);
+    TEST_ASSERT_EQUAL_UINT32(0, b.order);
+    TEST_ASSERT_EQUAL_UINT32(2, c.order);
+    TEST_ASSERT_FALSE(edf.setDeadline(ha, 10));        // déjà exécuté
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, edf.nextDeadline());
+}
+
+// Suite aléatoire d'insertions, changements de clé et annulations, comparée
+// à une recherche linéaire du minimum
+void test_edf_heap_matches_linear_scan() {
+    edf_setup();
+    static SimEdf edf;
+    edf.clear();
+    static uint64_t shadow[256];
+    static bool live[256];
+    static SimEdf::Handle handles[256];                 // dernier handle par emplacement
+    for (int i = 0; i < 256; i++) {
+        live[i] = false;
+        handles[i] = SimEdf::INVALID_HANDLE;
+    }
+    static EdfJob dummy = { 0, 0, 0 };
+    uint32_t seed = 99;
+    for (int step = 0; step < 20000; step++) {
+        seed = seed * 1664525UL + 1013904223UL;
+        uint32_t op = (seed >> 28) & 3;
+        uint32_t pick = (seed >> 8) & 255;
+        uint64_t key = (seed >> 4) & 0xFFFFF;
+        if (op <= 1) {
+            SimEdf::Handle h = edf.submit(key, runJob, &dummy);
+            if (h != SimEdf::INVALID_HANDLE) {
+                shadow[h % 256] = key;
+                live[h % 256] = true;
+                handles[h % 256] = h;
+            } else {
+                TEST_ASSERT_EQUAL_UINT32(256, edf.size());
+            }
+        } else if (op == 2) {
+            TEST_ASSERT_EQUAL(live[pick], edf.setDeadline(handles[pick], key));
+            if (live[pick]) shadow[pick] = key;
+        } else {
+            TEST_ASSERT_EQUAL(live[pick], edf.cancel(handles[pick]));
+            live[pick] = false;
+        }
+        uint64_t expected = UINT64_MAX;
+        uint32_t pending = 0;
+        for (int i = 0; i < 256; i++) {
+            if (!live[i]) continue;
+            pending++;
+            if (shadow[i] < expected) expected = shadow[i];
+        }
+        TEST_ASSERT_EQUAL_UINT64(expected, edf.nextDeadline());
+        TEST_ASSERT_EQUAL_UINT32(pending, edf.size());
+    }
+}
+
+// Un travail qui resoumet depuis son rappel reprend l'emplacement qu'il
+// vient de libérer : son ancien handle ne doit pas atteindre le nouveau.
+static SimEdf* resubmit_edf;
+static SimEdf::Handle resubmitted;
+
+static void resubmitJob(void* context) {
+    runJob(context);
+    resubmitted = resubmit_edf->submit(500, runJob, context);
+}
+
+void test_edf_stale_handle_after_resubmit() {
+    edf_setup();
+    static SimEdf edf;
+    edf.clear();
+    resubmit_edf = &edf;
+    EdfJob job = { 100, 0, 0 };
+    SimEdf::Handle first = edf.submit(job.deadline, resubmitJob, &job);
+    TEST_ASSERT_EQUAL_UINT32(1, edf.run(1));
+    TEST_ASSERT_TRUE(resubmitted != SimEdf::INVALID_HANDLE);
+    TEST_ASSERT_TRUE(resubmitted != first);
+    TEST_ASSERT_EQUAL_UINT32(first % SimEdf::capacity(), resubmitted % SimEdf::capacity());
+
+    TEST_ASSERT_FALSE(edf.isPending(first));
+    TEST_ASSERT_FALSE(edf.setDeadline(first, 10));
+    TEST_ASSERT_FALSE(edf.cancel(first));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, edf.deadline(first));
+    TEST_ASSERT_EQUAL_UINT64(500, edf.deadline(resubmitted));
+
+    // clear() ne remet pas les générations à zéro
+    edf.clear();
+    SimEdf::Handle after_clear = edf.submit(200, runJob, &job);
+    TEST_ASSERT_TRUE(after_clear != resubmitted);
+    TEST_ASSERT_FALSE(edf.cancel(resubmitted));
+    TEST_ASSERT_FALSE(edf.cancel(SimEdf::INVALID_HANDLE));
+    TEST_ASSERT_TRUE(edf.cancel(after_clear));
+}
+
+void test_edf_miss_accounting_per_class() {
+    edf_setup();
+    static SimEdf edf;
+    edf.clear();
+    edf.resetStats();
+    edf.setLatePolicy(1, PRECISE_TIME_EDF_DROP_LATE);
+    // Classe 0 (souple) : 3 travaux de 40 µs, échéances 50, 60, 200
+    EdfJob soft[3] = { { 50, 40, 0 }, { 60, 40, 0 }, { 200, 40, 0 } };
+    // Classe 1 (ferme) : échéance 70, déjà passée quand vient son tour
+    EdfJob firm = { 70, 10, 0 };
+    for (int i = 0; i < 3; i++) edf.submit(soft[i].deadline, runJob, &soft[i], 0);
+    edf.submit(firm.deadline, runJob, &firm, 1);
+
+    TEST_ASSERT_EQUAL_UINT32(4, edf.run());
+    // 50 : fini à 40 ; 60 : fini à 80 (manqué de 20) ; 70 : abandonné à 80 ;
+    // 200 : fini à 120
+    TEST_ASSERT_EQUAL_UINT32(3, edf.classStats(0).completed);
+    TEST_ASSERT_EQUAL_UINT32(1, edf.classStats(0).missed);
+    TEST_ASSERT_EQUAL_UINT32(20, edf.classStats(0).max_tardiness);
+    TEST_ASSERT_EQUAL_UINT32(0, edf.classStats(1).completed);
+    TEST_ASSERT_EQUAL_UINT32(1, edf.classStats(1).dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, firm.order);
+    TEST_ASSERT_EQUAL_UINT64(120, SimTime::getMicroseconds());
+
+    // Classe hors domaine : refusée, les comptes des classes ne bougent pas
+    EdfJob stray = { 130, 10, 0 };
+    TEST_ASSERT_EQUAL_UINT32(SimEdf::INVALID_HANDLE, edf.submit(stray.deadline, runJob, &stray, 2));
+    TEST_ASSERT_EQUAL_UINT32(0, edf.run());
+    TEST_ASSERT_EQUAL_UINT32(3, edf.classStats(0).completed);
+    TEST_ASSERT_EQUAL_UINT32(0, edf.classStats(1).completed);
+    TEST_ASSERT_EQUAL_UINT32(0, stray.order);
+    PreciseTimeSimBackend::clear();
+}
+
+void run_edf_scheduler_tests() {
+    RUN_TEST(test_edf_runs_by_deadline);
+    RUN_TEST(test_edf_decrease_key_and_cancel);
+    RUN_TEST(test_edf_heap_matches_linear_scan);
+    RUN_TEST(test_edf_stale_handle_after_resubmit);
+    RUN_TEST(test_edf_miss_accounting_per_class);
+}
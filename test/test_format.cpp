@@ -0,0 +1,132 @@
+/**
+ * @file test_format.cpp
+ * @brief Tests du formatage sans allocation (PreciseTimeFormatter)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <PreciseTime.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+/**
+ * @brief Sortie de test fournissant write(const uint8_t*, size_t), comme Print
+ */
+struct CaptureOutput {
+    char text[64];
+    size_t length;
+
+    CaptureOutput() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+static void expect_format(const char* expected, uint64_t micros, PreciseTimeLayout layout) {
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    size_t written = PreciseTimeFormatter::format(buffer, sizeof(buffer), micros, layout);
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), written);
+}
+
+void test_format_layouts() {
+    uint64_t t = ((26ULL * 3600ULL + 3ULL * 60ULL + 4ULL) * 1000000ULL) + 5006ULL;
+    expect_format("26:03:04", t, PRECISE_TIME_HMS);
+    expect_format("26:03:04.005", t, PRECISE_TIME_HMS_MILLIS);
+    expect_format("26:03:04.005006", t, PRECISE_TIME_HMS_MICROS);
+    expect_format("1d 02:03:04", t, PRECISE_TIME_DAYS_HMS);
+
+    expect_format("00:00:00", 0, PRECISE_TIME_HMS);
+    expect_format("00:00:00.000000", 0, PRECISE_TIME_HMS_MICROS);
+    expect_format("0d 00:00:00", 0, PRECISE_TIME_DAYS_HMS);
+    expect_format("00:00:59.999", 59999999ULL, PRECISE_TIME_HMS_MILLIS);
+}
+
+void test_format_extremes() {
+    expect_format("5124095576:01:49.551615", UINT64_MAX, PRECISE_TIME_HMS_MICROS);
+    expect_format("213503982d 08:01:49", UINT64_MAX, PRECISE_TIME_DAYS_HMS);
+
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    TEST_ASSERT_EQUAL_UINT32(31,
+        PreciseTimeFormatter::formatUptime(buffer, sizeof(buffer), UINT64_MAX / 86400ULL * 86400ULL));
+    TEST_ASSERT_EQUAL_STRING("213503982334601 jours, 00:00:00", buffer);
+}
+
+void test_format_buffer_too_small() {
+    char buffer[9];
+    memset(buffer, 'x', sizeof(buffer));
+    // "12:00:00" + zéro final : 9 octets exactement
+    TEST_ASSERT_EQUAL_UINT32(8, PreciseTimeFormatter::format(buffer, 9, 43200000000ULL, PRECISE_TIME_HMS));
+    TEST_ASSERT_EQUAL_STRING("12:00:00", buffer);
+    TEST_ASSERT_EQUAL_UINT32(0, PreciseTimeFormatter::format(buffer, 8, 43200000000ULL, PRECISE_TIME_HMS));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+    TEST_ASSERT_EQUAL_UINT32(0, PreciseTimeFormatter::format(buffer, 0, 0, PRECISE_TIME_HMS));
+}
+
+void test_format_matches_printf() {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 100000; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        uint64_t micros = x >> (i & 63);
+        uint64_t s = micros / 1000000ULL;
+        char expected[64];
+        char buffer[PRECISE_TIME_FORMAT_BUFFER];
+
+        snprintf(expected, sizeof(expected), "%02llu:%02u:%02u.%06u",
+                 (unsigned long long)(s / 3600ULL), (unsigned)(s % 3600ULL / 60ULL),
+                 (unsigned)(s % 60ULL), (unsigned)(micros % 1000000ULL));
+        PreciseTimeFormatter::format(buffer, sizeof(buffer), micros, PRECISE_TIME_HMS_MICROS);
+        TEST_ASSERT_EQUAL_STRING(expected, buffer);
+
+        snprintf(expected, sizeof(expected), "%llud %02u:%02u:%02u",
+                 (unsigned long long)(s / 86400ULL), (unsigned)(s % 86400ULL / 3600ULL),
+                 (unsigned)(s % 3600ULL / 60ULL), (unsigned)(s % 60ULL));
+        PreciseTimeFormatter::format(buffer, sizeof(buffer), micros, PRECISE_TIME_DAYS_HMS);
+        TEST_ASSERT_EQUAL_STRING(expected, buffer);
+    }
+}
+
+void test_format_from_precise_time() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    PreciseTimeSimBackend::advance((2ULL * 86400ULL + 3661ULL) * 1000000ULL + 250000ULL);
+
+    char buffer[PRECISE_TIME_FORMAT_BUFFER];
+    TEST_ASSERT_EQUAL_UINT32(11, SimTime::formatTo(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("2d 01:01:01", buffer);
+    SimTime::formatTo(buffer, sizeof(buffer), PRECISE_TIME_HMS_MILLIS);
+    TEST_ASSERT_EQUAL_STRING("49:01:01.250", buffer);
+
+    CaptureOutput out;
+    TEST_ASSERT_EQUAL_UINT32(15, SimTime::printTo(out, PRECISE_TIME_HMS_MICROS));
+    TEST_ASSERT_EQUAL_STRING("49:01:01.250000", out.text);
+
+    PreciseTimeString uptime = SimTime::getFormattedString();
+    TEST_ASSERT_EQUAL_STRING("2 jours, 01:01:01", uptime.c_str());
+    PreciseTimeSimBackend::clear();
+    TEST_ASSERT_EQUAL_STRING("00:00:00", SimTime::getFormattedString().c_str());
+}
+
+void run_format_tests() {
+    RUN_TEST(test_format_layouts);
+    RUN_TEST(test_format_extremes);
+    RUN_TEST(test_format_buffer_too_small);
+    RUN_TEST(test_format_matches_printf);
+    RUN_TEST(test_format_from_precise_time);
+}
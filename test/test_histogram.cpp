@@ -0,0 +1,179 @@
+/**
+ * @file test_histogram.cpp
+ * @brief Tests de PreciseTimeLatencyHistogram contre des percentiles exacts
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeHistogram.h>
+
+#if !defined(ARDUINO)
+#include <vector>
+#include <algorithm>
+#include <math.h>
+
+typedef PreciseTimeLatencyHistogram<1000000UL, 1, uint16_t> SmallHistogram;
+typedef PreciseTimeLatencyHistogram<1000000UL, 2> FineHistogram;
+typedef PreciseTimeLatencyHistogram<10000000UL, 3> PreciseHistogram;
+
+static_assert(SmallHistogram::BUCKETS == 271, "taille documentée");
+static_assert(FineHistogram::BUCKETS == 1781, "taille documentée");
+static_assert(sizeof(SmallHistogram) < 600, "quelques centaines d'octets");
+
+static uint64_t histogram_rng = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_random() {
+    histogram_rng ^= histogram_rng << 13;
+    histogram_rng ^= histogram_rng >> 7;
+    histogram_rng ^= histogram_rng << 17;
+    return (uint32_t)(histogram_rng >> 32);
+}
+
+// Latences à queue longue : log-uniformes entre 1 et ~2^20
+static uint32_t next_latency() {
+    uint32_t magnitude = next_random() % 20;
+    return (1UL << magnitude) + (next_random() & ((1UL << magnitude) - 1));
+}
+
+template <class Histogram>
+static void check_percentiles(const Histogram& histogram, std::vector<uint32_t> samples,
+                              uint32_t max_value) {
+    std::sort(samples.begin(), samples.end());
+    const double percents[] = { 0.0, 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 99.99, 100.0 };
+    for (unsigned i = 0; i < sizeof(percents) / sizeof(percents[0]); i++) {
+        uint64_t rank = (uint64_t)ceil(percents[i] * samples.size() / 100.0);
+        if (rank == 0) rank = 1;
+        uint32_t exact = samples[rank - 1];
+        if (exact > max_value) continue;
+        uint32_t estimate = histogram.valueAtPercentile(percents[i]);
+        // Jamais sous la valeur exacte, au plus une largeur de case au-dessus
+        uint32_t tolerance = exact >> (Histogram::SUB_BUCKET_BITS - 1);
+        if (estimate < exact || estimate - exact > tolerance) {
+            TEST_ASSERT_EQUAL_UINT32(exact, estimate);
+        }
+    }
+}
+
+template <class Histogram>
+static void check_random_distribution(uint32_t max_value) {
+    Histogram* histogram = new Histogram();
+    std::vector<uint32_t> samples;
+    for (int i = 0; i < 2000000; i++) {
+        uint32_t value = next_latency();
+        samples.push_back(value);
+        histogram->record(value);
+    }
+    TEST_ASSERT_EQUAL_UINT32(samples.size(), histogram->count());
+    TEST_ASSERT_EQUAL_UINT32(*std::min_element(samples.begin(), samples.end()), histogram->min());
+    TEST_ASSERT_EQUAL_UINT32(*std::max_element(samples.begin(), samples.end()), histogram->max());
+    check_percentiles(*histogram, samples, max_value);
+    delete histogram;
+}
+
+void test_histogram_percentiles_match_sorted() {
+    check_random_distribution<PreciseTimeLatencyHistogram<1000000UL, 1> >(1000000UL);
+    check_random_distribution<FineHistogram>(1000000UL);
+    check_random_distribution<PreciseHistogram>(10000000UL);
+}
+
+void test_histogram_exact_below_sub_buckets() {
+    FineHistogram histogram;
+    for (uint32_t v = 0; v < 256; v++) histogram.record(v);
+    TEST_ASSERT_EQUAL_UINT32(127, histogram.valueAtPercentile(50.0));
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.valueAtPercentile(0.0));
+    TEST_ASSERT_EQUAL_UINT32(255, histogram.valueAtPercentile(100.0));
+    TEST_ASSERT_EQUAL_UINT32(127, histogram.mean());
+}
+
+void test_histogram_every_value_lands_in_its_bucket() {
+    // La case de chaque valeur contient la valeur : highestIn(index(v)) >= v
+    FineHistogram histogram;
+    for (uint32_t v = 1; v <= 1000000UL; v += 1 + (v >> 9)) {
+        histogram.reset();
+        histogram.record(v);
+        TEST_ASSERT_EQUAL_UINT32(v, histogram.valueAtPercentile(50.0));
+    }
+}
+
+void test_histogram_merge_equals_combined() {
+    SmallHistogram a, b, combined;
+    std::vector<uint32_t> samples;
+    for (int i = 0; i < 100000; i++) {
+        uint32_t value = next_latency();
+        samples.push_back(value);
+        combined.record(value);
+        if (i & 1) a.record(value); else b.record(value);
+    }
+    a.merge(b);
+    TEST_ASSERT_EQUAL_UINT32(combined.count(), a.count());
+    TEST_ASSERT_EQUAL_UINT32(combined.min(), a.min());
+    TEST_ASSERT_EQUAL_UINT32(combined.max(), a.max());
+    for (uint32_t i = 0; i < SmallHistogram::BUCKETS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(combined.bucketCount(i), a.bucketCount(i));
+    }
+    check_percentiles(a, samples, 1000000UL);
+
+    SmallHistogram snapshot;
+    a.snapshotAndReset(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(100000, snapshot.count());
+    TEST_ASSERT_EQUAL_UINT32(0, a.count());
+    TEST_ASSERT_EQUAL_UINT32(0, a.valueAtPercentile(99.0));
+}
+
+void test_histogram_clamps_and_saturates() {
+    SmallHistogram histogram;
+    histogram.record(5000000UL);
+    TEST_ASSERT_EQUAL_UINT32(5000000UL, histogram.max());
+    TEST_ASSERT_TRUE(histogram.valueAtPercentile(100.0) <= 5000000UL);
+    TEST_ASSERT_TRUE(histogram.valueAtPercentile(100.0) >= 1000000UL - (1000000UL >> 4));
+
+    histogram.reset();
+    for (uint32_t i = 0; i < 70000; i++) histogram.record(3);
+    TEST_ASSERT_EQUAL_UINT32(65535, histogram.bucketCount(3));
+    TEST_ASSERT_EQUAL_UINT32(70000, histogram.count());
+    TEST_ASSERT_TRUE(histogram.saturated());
+}
+
+/**
+ * Case saturée : 200 000 échantillons dont 90 % à 100 ; les percentiles
+ * restent dans les cases comptées au lieu de renvoyer max()
+ */
+void test_histogram_percentile_after_saturation() {
+    SmallHistogram histogram;
+    for (uint32_t i = 0; i < 200000; i++) {
+        uint32_t k = i % 100;
+        histogram.record(k < 90 ? 100 : k < 99 ? 1000 : 50000);
+    }
+    TEST_ASSERT_TRUE(histogram.saturated());
+    TEST_ASSERT_EQUAL_UINT32(200000, histogram.count());
+    uint32_t p50 = histogram.valueAtPercentile(50.0);
+    TEST_ASSERT_TRUE(p50 >= 100 && p50 < 100 + (100 >> 4) + 1);
+    uint32_t p95 = histogram.valueAtPercentile(95.0);
+    TEST_ASSERT_TRUE(p95 >= 1000 && p95 < 1000 + (1000 >> 4));
+    TEST_ASSERT_TRUE(histogram.valueAtPercentile(100.0) >= 50000 - (50000 >> 4));
+
+    histogram.reset();
+    histogram.record(100);
+    TEST_ASSERT_FALSE(histogram.saturated());
+}
+
+void run_histogram_tests() {
+    RUN_TEST(test_histogram_percentiles_match_sorted);
+    RUN_TEST(test_histogram_exact_below_sub_buckets);
+    RUN_TEST(test_histogram_every_value_lands_in_its_bucket);
+    RUN_TEST(test_histogram_merge_equals_combined);
+    RUN_TEST(test_histogram_clamps_and_saturates);
+    RUN_TEST(test_histogram_percentile_after_saturation);
+}
+#else
+void run_histogram_tests() {
+}
+#endif
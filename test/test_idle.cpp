@@ -0,0 +1,156 @@
+/**
+ * @file test_idle.cpp
+ * @brief Tests de la veille légère compensée et de la veille sans tick,
+ *        sur l'horloge virtuelle et la veille simulée
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeIdle.h>
+#include <PreciseTimeScheduler.h>
+#include <PreciseTimeEdfScheduler.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeSimLightSleep SimSleep;
+
+static uint32_t idle_fired;
+
+static void countFired(void*) {
+    idle_fired++;
+}
+
+static void idle_setup(int32_t wake_error_us, bool counter_runs = false) {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    SimSleep::configure(wake_error_us, counter_runs);
+    idle_fired = 0;
+}
+
+// Compteur figé pendant la veille : la compensation le rattrape et
+// déclenche au passage les timers échus
+void test_light_sleep_compensates_frozen_counter() {
+    idle_setup(0);
+    SimTime::sleepFor(1234);
+    PreciseTimeSimBackend::addTimer(PreciseTimeSimBackend::now() + 3000, countFired);
+    TEST_ASSERT_EQUAL_UINT64(5000, SimTime::lightSleep(5000));
+    TEST_ASSERT_EQUAL_UINT64(6234, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT32(1, idle_fired);
+    TEST_ASSERT_EQUAL_UINT32(1, SimSleep::state().sleeps);
+
+    // Erreur de la référence (calibration RTC) : reportée telle quelle
+    SimSleep::configure(0, false, 7);
+    SimTime::lightSleep(5000);
+    TEST_ASSERT_EQUAL_UINT64(11241, SimTime::getMicroseconds());
+    PreciseTimeSimBackend::clear();
+}
+
+// Compteur qui tourne pendant la veille : rien à ajouter
+void test_light_sleep_no_double_count() {
+    idle_setup(40, true);
+    TEST_ASSERT_EQUAL_UINT64(5040, SimTime::lightSleep(5000));
+    TEST_ASSERT_EQUAL_UINT64(5040, SimTime::getMicroseconds());
+    PreciseTimeSimBackend::clear();
+}
+
+// Tâche périodique de 10 ms : chaque exécution à l'heure, la quasi-totalité
+// du temps en veille
+void test_idle_follows_scheduler() {
+    idle_setup(0);
+    static PreciseTimeScheduler<SimTime, 4> scheduler;
+    scheduler.clear();
+    PreciseTimeScheduler<SimTime, 4>::TaskId task = scheduler.every(10000, countFired);
+    PreciseTimeIdle<SimTime> idle;
+    TEST_ASSERT_TRUE(idle.watch(scheduler));
+    TEST_ASSERT_EQUAL_UINT64(10000, idle.nextDeadline());
+
+    for (int i = 0; i < 100; i++) {
+        scheduler.run();
+        TEST_ASSERT_EQUAL_UINT64(0, idle.idle());
+    }
+    scheduler.run();
+    TEST_ASSERT_EQUAL_UINT32(100, scheduler.runs(task));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.maxLateness(task));
+    TEST_ASSERT_EQUAL_UINT64(1000000, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT32(100, idle.sleepCount());
+    TEST_ASSERT_EQUAL_UINT64(1000000, idle.sleptMicros());
+    PreciseTimeSimBackend::clear();
+}
+
+// Sortie de veille 300 µs après la durée demandée : un réveil en retard,
+// puis la marge passe à 375 µs et sleepUntil() finit à l'heure
+void test_idle_wake_margin_tracks_late_wakeup() {
+    idle_setup(300);
+    static PreciseTimeEdfScheduler<SimTime, 4, 1> edf;
+    edf.clear();
+    PreciseTimeIdle<SimTime> idle;
+    idle.watch(edf);
+    idle.setWakeMargin(0);
+
+    edf.submit(10000, countFired);
+    TEST_ASSERT_EQUAL_UINT64(300, idle.idle());
+    TEST_ASSERT_EQUAL_UINT32(375, idle.wakeMargin());
+    edf.run();
+
+    for (int i = 2; i <= 10; i++) {
+        edf.submit(10000ULL * i, countFired);
+        TEST_ASSERT_EQUAL_UINT64(0, idle.idle());
+        TEST_ASSERT_EQUAL_UINT64(10000ULL * i, SimTime::getMicroseconds());
+        edf.run();
+    }
+    TEST_ASSERT_EQUAL_UINT32(375, idle.wakeMargin());
+    TEST_ASSERT_EQUAL_UINT32(10, edf.classStats(0).completed);
+    TEST_ASSERT_EQUAL_UINT32(1, edf.classStats(0).missed);
+    TEST_ASSERT_EQUAL_UINT32(300, idle.maxLateness());
+
+    // Marge plus longue que la période (réveil aberrant) : elle décroît
+    // jusqu'à permettre de nouveau la veille
+    idle.setWakeMargin(20000);
+    uint32_t sleeps = idle.sleepCount();
+    for (int i = 11; i <= 60; i++) {
+        edf.submit(10000ULL * i, countFired);
+        idle.idle();
+        edf.run();
+    }
+    TEST_ASSERT_TRUE(idle.sleepCount() > sleeps);
+    TEST_ASSERT_EQUAL_UINT32(1, edf.classStats(0).missed);
+    PreciseTimeSimBackend::clear();
+}
+
+// Réveil anticipé (GPIO...) ou échéance trop proche : on attend quand même
+// l'échéance ; échéance passée : retour immédiat
+void test_idle_early_wakeup_and_due_deadline() {
+    idle_setup(-2000);
+    PreciseTimeIdle<SimTime> idle;
+    static uint64_t target = 8000;
+    idle.watch([](const void* source) { return *(const uint64_t*)source; }, &target);
+    TEST_ASSERT_EQUAL_UINT64(0, idle.idle());
+    TEST_ASSERT_EQUAL_UINT64(8000, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT32(1, idle.sleepCount());
+
+    TEST_ASSERT_EQUAL_UINT64(0, idle.idle());
+    TEST_ASSERT_EQUAL_UINT64(8000, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT32(1, idle.sleepCount());
+
+    // Sans échéance : veille plafonnée
+    TEST_ASSERT_TRUE(idle.unwatch(&target));
+    idle.idle(50000);
+    TEST_ASSERT_EQUAL_UINT64(58000, SimTime::getMicroseconds());
+    PreciseTimeSimBackend::clear();
+}
+
+void run_idle_tests() {
+    RUN_TEST(test_light_sleep_compensates_frozen_counter);
+    RUN_TEST(test_light_sleep_no_double_count);
+    RUN_TEST(test_idle_follows_scheduler);
+    RUN_TEST(test_idle_wake_margin_tracks_late_wakeup);
+    RUN_TEST(test_idle_early_wakeup_and_due_deadline);
+}
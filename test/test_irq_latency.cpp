@@ -0,0 +1,168 @@
+/**
+ * @file test_irq_latency.cpp
+ * @brief Tests de la mesure de latence d'interruption
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeIrqLatency.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeIrqLatency<SimTime> SimIrqLatency;
+
+struct IrqCapture {
+    char text[512];
+    size_t length;
+
+    IrqCapture() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+static void irq_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+}
+
+template <class Latency>
+static void irq_stamp_at(Latency& latency, uint64_t when) {
+    PreciseTimeSimBackend::advance(when - SimTime::getTicks());
+    latency.stamp();
+    latency.collect();
+}
+
+void test_irq_latency_one_shot() {
+    irq_setup();
+    SimIrqLatency latency("gpio");
+    latency.stamp();
+    TEST_ASSERT_EQUAL_UINT32(0, latency.collect()); // non armée : ignorée
+    TEST_ASSERT_EQUAL_UINT32(0, latency.samples());
+
+    latency.arm(100);
+    irq_stamp_at(latency, 103);
+    TEST_ASSERT_EQUAL_UINT64(3, latency.lastLatency());
+    TEST_ASSERT_FALSE(latency.isArmed());
+    irq_stamp_at(latency, 110);                     // pas réarmée : ignorée
+    TEST_ASSERT_EQUAL_UINT32(1, latency.samples());
+
+    latency.arm(200);
+    irq_stamp_at(latency, 150);                     // horloges décalées
+    TEST_ASSERT_EQUAL_UINT32(1, latency.early());
+    TEST_ASSERT_EQUAL_UINT64(0, latency.lastLatency());
+    TEST_ASSERT_EQUAL_UINT32(2, latency.samples());
+    TEST_ASSERT_EQUAL_UINT64(0, latency.minLatency());
+    TEST_ASSERT_EQUAL_UINT64(3, latency.maxLatency());
+}
+
+void test_irq_latency_periodic_and_missed() {
+    irq_setup();
+    SimIrqLatency latency("timer1");
+    latency.armPeriodic(1000, 100);
+    irq_stamp_at(latency, 1002);
+    irq_stamp_at(latency, 1105);
+    irq_stamp_at(latency, 1201);
+    TEST_ASSERT_EQUAL_UINT64(1300, latency.expectedTicks());
+    // 1300 et 1400 perdues (section critique trop longue), 1500 servie à 1510
+    irq_stamp_at(latency, 1510);
+    TEST_ASSERT_EQUAL_UINT32(2, latency.missed());
+    TEST_ASSERT_EQUAL_UINT64(10, latency.lastLatency());
+    TEST_ASSERT_EQUAL_UINT64(1600, latency.expectedTicks());
+
+    TEST_ASSERT_EQUAL_UINT32(4, latency.samples());
+    TEST_ASSERT_EQUAL_UINT64(1, latency.minLatency());
+    TEST_ASSERT_EQUAL_UINT64(10, latency.maxLatency());
+    TEST_ASSERT_EQUAL_UINT64(4, latency.meanLatency());
+    TEST_ASSERT_EQUAL_UINT32(10, latency.histogram().valueAtPercentile(99.0));
+
+    IrqCapture out;
+    size_t written = latency.report(out);
+    TEST_ASSERT_EQUAL_UINT32(out.length, written);
+    TEST_ASSERT_EQUAL_STRING("timer1 : 4 interruptions, latence moy 4000 ns, min 1000, max 10000, "
+                             "p99 10000, dernière 10000, perdues 2, en avance 0\n", out.text);
+
+    latency.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, latency.samples());
+    TEST_ASSERT_TRUE(latency.isArmed());
+    PreciseTimeSimBackend::clear();
+}
+
+// Les instants s'accumulent entre deux collect() ; au delà de PENDING,
+// stamp() les jette et l'échéance sautée apparaît dans missed().
+void test_irq_latency_pending_stamps() {
+    irq_setup();
+    PreciseTimeIrqLatency<SimTime, PreciseTimeLatencyHistogram<100000UL, 1, uint16_t>, 4>
+        latency("burst");
+    latency.armPeriodic(100, 100);
+    for (uint64_t deadline = 100; deadline <= 600; deadline += 100) {
+        PreciseTimeSimBackend::advance(deadline + 2 - SimTime::getTicks());
+        latency.stamp();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, latency.samples());
+    TEST_ASSERT_EQUAL_UINT32(2, latency.dropped());
+    TEST_ASSERT_EQUAL_UINT32(4, latency.collect());
+    TEST_ASSERT_EQUAL_UINT32(0, latency.collect());
+    TEST_ASSERT_EQUAL_UINT64(2, latency.maxLatency());
+    TEST_ASSERT_EQUAL_UINT32(0, latency.missed());
+
+    irq_stamp_at(latency, 802);                     // 500 à 700 jetées ou perdues
+    TEST_ASSERT_EQUAL_UINT32(3, latency.missed());
+    TEST_ASSERT_EQUAL_UINT64(2, latency.lastLatency());
+
+    latency.stamp();                                // réarmement : instant écarté
+    latency.arm(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.collect());
+    PreciseTimeSimBackend::clear();
+}
+
+#if defined(PRECISE_TIME_HAS_IRQ_PROBE) && !defined(ARDUINO)
+typedef PreciseTimeT<PreciseTimeNativeBackend> IrqNativeTime;
+
+// Timer POSIX à 500 µs pendant 100 ms : le gestionnaire de SIGRTMIN fait
+// office d'ISR et la comptabilité tourne sur un vrai signal asynchrone.
+void test_irq_latency_posix_probe() {
+    IrqNativeTime::begin();
+    static PreciseTimeIrqLatency<IrqNativeTime> latency("sigrtmin");
+    latency.clear();
+    TEST_ASSERT_TRUE((PreciseTimeIrqProbe<IrqNativeTime>::start(latency, 500)));
+
+    uint64_t end = IrqNativeTime::getMilliseconds() + 100;
+    while (IrqNativeTime::getMilliseconds() < end) {
+        struct timespec pause = { 0, 1000000L };
+        nanosleep(&pause, nullptr);
+        latency.collect();
+    }
+    PreciseTimeIrqProbe<IrqNativeTime>::stop();
+    TEST_ASSERT_FALSE(latency.isArmed());
+
+    uint32_t fired = latency.samples() + latency.missed();
+    TEST_ASSERT_TRUE(fired >= 150 && fired <= 210);
+    TEST_ASSERT_EQUAL_UINT32(0, latency.dropped());
+    TEST_ASSERT_TRUE(latency.minLatency() < 500000ULL);        // < une période (ns)
+    TEST_ASSERT_TRUE(latency.maxLatency() >= latency.minLatency());
+}
+#endif
+
+void run_irq_latency_tests() {
+    RUN_TEST(test_irq_latency_one_shot);
+    RUN_TEST(test_irq_latency_periodic_and_missed);
+    RUN_TEST(test_irq_latency_pending_stamps);
+#if defined(PRECISE_TIME_HAS_IRQ_PROBE) && !defined(ARDUINO)
+    RUN_TEST(test_irq_latency_posix_probe);
+#endif
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_loop_profiler.cpp
+ * @brief Tests du profil de loop() sur l'horloge virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeLoopProfiler.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeLoopProfiler<SimTime, 3> SimLoopProfiler;
+
+struct LoopCapture {
+    char text[1024];
+    size_t length;
+
+    LoopCapture() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+static void loop_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+}
+
+void test_loop_profiler_durations_and_jitter() {
+    loop_setup();
+    SimLoopProfiler profiler(1000);
+    profiler.tick();                            // première itération : référence
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.iterations());
+
+    static const uint32_t periods[] = { 500, 700, 400, 1500, 500 };
+    for (size_t i = 0; i < 5; i++) {
+        PreciseTimeSimBackend::advance(periods[i]);
+        profiler.tick();
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, profiler.iterations());
+    TEST_ASSERT_EQUAL_UINT32(500, profiler.lastDuration());
+    TEST_ASSERT_EQUAL_UINT32(400, profiler.minDuration());
+    TEST_ASSERT_EQUAL_UINT32(1500, profiler.maxDuration());
+    TEST_ASSERT_EQUAL_UINT32(720, profiler.meanDuration());
+    // Gigues : 200, 300, 1100, 1000
+    TEST_ASSERT_EQUAL_UINT32(1100, profiler.maxJitter());
+    TEST_ASSERT_EQUAL_UINT32(650, profiler.meanJitter());
+    TEST_ASSERT_EQUAL_UINT32(1, profiler.overruns());
+    TEST_ASSERT_EQUAL_UINT32(5, profiler.histogram().count());
+}
+
+void test_loop_profiler_worst_offenders() {
+    loop_setup();
+    SimLoopProfiler profiler(2000);
+    profiler.tick();
+
+    // Une itération sur dix est longue et étiquetée par la tâche fautive
+    static const char* const labels[] = { "wifi", "mqtt", "affichage" };
+    for (uint32_t i = 1; i <= 100; i++) {
+        uint32_t period = 1000;
+        if (i % 10 == 0) {
+            period = 2000 + i * 10;
+            profiler.label(labels[i % 3]);
+        }
+        PreciseTimeSimBackend::advance(period);
+        profiler.tick();
+    }
+    TEST_ASSERT_EQUAL_UINT32(10, profiler.overruns());
+    TEST_ASSERT_EQUAL_UINT32(3, profiler.worstCount());
+    TEST_ASSERT_EQUAL_UINT32(3000, profiler.worst(0).duration);
+    TEST_ASSERT_EQUAL_STRING("mqtt", profiler.worst(0).label);       // i = 100
+    TEST_ASSERT_EQUAL_UINT32(2900, profiler.worst(1).duration);
+    TEST_ASSERT_EQUAL_STRING("wifi", profiler.worst(1).label);       // i = 90
+    TEST_ASSERT_EQUAL_UINT32(2800, profiler.worst(2).duration);
+    TEST_ASSERT_EQUAL_UINT64(SimTime::getMicroseconds() - 3000 - 9 * 1000 - 2900 - 9 * 1000,
+                             profiler.worst(2).at);
+
+    // L'étiquette ne survit pas à son itération
+    PreciseTimeSimBackend::advance(5000);
+    profiler.tick();
+    TEST_ASSERT_NULL(profiler.worst(0).label);
+    TEST_ASSERT_EQUAL_UINT32(5000, profiler.worst(0).duration);
+
+    // Percentiles : 90 % des itérations à 1000 µs
+    TEST_ASSERT_UINT32_WITHIN(100, 1000, profiler.histogram().valueAtPercentile(50.0));
+    TEST_ASSERT_TRUE(profiler.histogram().valueAtPercentile(99.0) >= 2900);
+}
+
+void test_loop_profiler_report() {
+    loop_setup();
+    SimLoopProfiler profiler(1000);
+    LoopCapture empty;
+    profiler.report(empty);
+    TEST_ASSERT_EQUAL_STRING("loop : 0 itérations\nbudget 1000 us : 0 dépassements\n", empty.text);
+
+    profiler.tick();
+    PreciseTimeSimBackend::advance(800);
+    profiler.tick();
+    profiler.label("capteur");
+    PreciseTimeSimBackend::advance(1200);
+    profiler.tick();
+
+    LoopCapture out;
+    size_t written = profiler.report(out);
+    TEST_ASSERT_EQUAL_UINT32(out.length, written);
+    TEST_ASSERT_NOT_NULL(strstr(out.text,
+        "loop : 2 itérations, moy 1000 us, min 800, max 1200, gigue moy 400, max 400\n"
+        "budget 1000 us : 1 dépassements\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out.text, "pire 1 : 1200 us à 2000 us (capteur)\n"
+                                          "pire 2 : 800 us à 800 us\n"));
+
+    profiler.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.iterations());
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.worstCount());
+    PreciseTimeSimBackend::clear();
+}
+
+void run_loop_profiler_tests() {
+    RUN_TEST(test_loop_profiler_durations_and_jitter);
+    RUN_TEST(test_loop_profiler_worst_offenders);
+    RUN_TEST(test_loop_profiler_report);
+}
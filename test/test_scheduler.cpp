@@ -0,0 +1,192 @@
+/**
+ * @file test_scheduler.cpp
+ * @brief Tests de l'ordonnanceur coopératif sur l'horloge virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeScheduler.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeScheduler<SimTime, 4> SimScheduler;
+
+static uint32_t sched_calls[4];
+static uint64_t sched_last_at[4];
+
+static void countCall(void* context) {
+    int index = (int)(intptr_t)context;
+    sched_calls[index]++;
+    sched_last_at[index] = SimTime::getMicroseconds();
+}
+
+static void scheduler_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    for (int i = 0; i < 4; i++) {
+        sched_calls[i] = 0;
+        sched_last_at[i] = 0;
+    }
+}
+
+// 10^7 périodes de 997 µs, loop() toutes les 613 µs : l'échéance reste
+// exactement sur la grille, alors que `last = now` perd une période à
+// chaque fois que loop() passe en retard.
+void test_scheduler_zero_drift_over_1e7_periods() {
+    scheduler_setup();
+    SimScheduler scheduler;
+    const uint64_t period = 997;
+    const uint32_t periods = 10000000UL;
+    SimScheduler::TaskId id = scheduler.every(period, countCall, (void*)0);
+
+    uint64_t naive_last = 0;
+    uint32_t naive_runs = 0;
+    while (scheduler.runs(id) < periods) {
+        PreciseTimeSimBackend::advance(613);
+        uint64_t now = SimTime::getMicroseconds();
+        scheduler.run(now);
+        if (now - naive_last >= period) {
+            naive_last = now;
+            naive_runs++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(periods, sched_calls[0]);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)(periods + 1) * period, scheduler.deadline(id));
+    TEST_ASSERT_TRUE(scheduler.maxLateness(id) < 613);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.skipped(id));
+    // La version naïve ne s'exécute qu'une loop() sur deux (1226 µs)
+    TEST_ASSERT_TRUE(naive_runs < periods / 10 * 9);
+}
+
+void test_scheduler_overrun_policies() {
+    scheduler_setup();
+    SimScheduler scheduler;
+    SimScheduler::TaskId catch_up = scheduler.every(100, countCall, (void*)0, PRECISE_TIME_CATCH_UP);
+    SimScheduler::TaskId skip = scheduler.every(100, countCall, (void*)1, PRECISE_TIME_SKIP);
+
+    // loop() bloquée 550 µs : échéances 100..500 manquées
+    PreciseTimeSimBackend::advance(550);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.run());
+    TEST_ASSERT_EQUAL_UINT64(200, scheduler.deadline(catch_up));
+    TEST_ASSERT_EQUAL_UINT64(600, scheduler.deadline(skip));
+    TEST_ASSERT_EQUAL_UINT32(4, scheduler.skipped(skip));
+    TEST_ASSERT_EQUAL_UINT32(450, scheduler.maxLateness(catch_up));
+
+    // Rattrapage : une période par run(), sans quitter la grille
+    for (int i = 0; i < 4; i++) scheduler.run();
+    TEST_ASSERT_EQUAL_UINT32(5, sched_calls[0]);
+    TEST_ASSERT_EQUAL_UINT64(600, scheduler.deadline(catch_up));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.run());          // à jour
+    PreciseTimeSimBackend::advance(50);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.run());
+    TEST_ASSERT_EQUAL_UINT32(6, sched_calls[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, sched_calls[1]);
+    TEST_ASSERT_EQUAL_UINT64(700, scheduler.deadline(catch_up));
+    TEST_ASSERT_EQUAL_UINT64(700, scheduler.deadline(skip));
+}
+
+void test_scheduler_one_shot_and_cancel() {
+    scheduler_setup();
+    SimScheduler scheduler;
+    SimScheduler::TaskId once = scheduler.after(250, countCall, (void*)2);
+    SimScheduler::TaskId dropped = scheduler.at(300, countCall, (void*)3);
+    TEST_ASSERT_EQUAL_UINT64(250, scheduler.nextDeadline());
+    TEST_ASSERT_TRUE(scheduler.cancel(dropped));
+    TEST_ASSERT_FALSE(scheduler.cancel(dropped));
+
+    PreciseTimeSimBackend::advance(260);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.run());
+    TEST_ASSERT_FALSE(scheduler.isActive(once));
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.runs(once));
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.maxLateness(once));
+    PreciseTimeSimBackend::advance(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.run());
+    TEST_ASSERT_EQUAL_UINT32(0, sched_calls[3]);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, scheduler.nextDeadline());
+
+    // Table pleine
+    for (int i = 0; i < 4; i++) TEST_ASSERT_TRUE(scheduler.every(10, countCall, (void*)0) >= 0);
+    TEST_ASSERT_EQUAL_INT(SimScheduler::INVALID_TASK, scheduler.every(10, countCall, (void*)0));
+    TEST_ASSERT_EQUAL_UINT32(4, scheduler.activeCount());
+}
+
+static SimScheduler* self_scheduler;
+static SimScheduler::TaskId self_id;
+
+static void stopAfterThree(void* context) {
+    countCall(context);
+    if (sched_calls[0] == 3) self_scheduler->cancel(self_id);
+}
+
+void test_scheduler_callback_cancels_itself_and_rebase() {
+    scheduler_setup();
+    SimScheduler scheduler;
+    self_scheduler = &scheduler;
+    self_id = scheduler.every(100, stopAfterThree, (void*)0);
+    SimScheduler::TaskId other = scheduler.every(1000, countCall, (void*)1);
+    for (int i = 0; i < 10; i++) {
+        PreciseTimeSimBackend::advance(100);
+        scheduler.run();
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, sched_calls[0]);
+    TEST_ASSERT_FALSE(scheduler.isActive(self_id));
+    TEST_ASSERT_EQUAL_UINT32(1, sched_calls[1]);
+
+    // reset() de l'horloge : la phase de la tâche restante est conservée
+    PreciseTimeSimBackend::advance(400);
+    uint64_t before = SimTime::getMicroseconds();
+    SimTime::reset();
+    scheduler.rebase(before, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(600, scheduler.deadline(other));
+    PreciseTimeSimBackend::clear();
+}
+
+// L'emplacement d'une tâche terminée est repris : son ancien identifiant
+// ne doit ni annuler ni décrire la nouvelle tâche.
+void test_scheduler_stale_id_after_reuse() {
+    scheduler_setup();
+    SimScheduler scheduler;
+    SimScheduler::TaskId once = scheduler.after(100, countCall, (void*)0);
+    PreciseTimeSimBackend::advance(150);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.run());
+
+    SimScheduler::TaskId reused = scheduler.every(100, countCall, (void*)1);
+    TEST_ASSERT_TRUE(reused != once);
+    TEST_ASSERT_FALSE(scheduler.isActive(once));
+    TEST_ASSERT_FALSE(scheduler.cancel(once));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, scheduler.deadline(once));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.runs(once));
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.maxLateness(once));
+
+    PreciseTimeSimBackend::advance(100);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.run());
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.runs(reused));
+    TEST_ASSERT_TRUE(scheduler.cancel(reused));
+    TEST_ASSERT_FALSE(scheduler.cancel(reused));
+
+    // clear() ne remet pas les générations à zéro
+    SimScheduler::TaskId before_clear = scheduler.every(100, countCall, (void*)1);
+    scheduler.clear();
+    SimScheduler::TaskId after_clear = scheduler.every(100, countCall, (void*)1);
+    TEST_ASSERT_TRUE(after_clear != before_clear);
+    TEST_ASSERT_FALSE(scheduler.cancel(before_clear));
+    TEST_ASSERT_TRUE(scheduler.isActive(after_clear));
+    TEST_ASSERT_FALSE(scheduler.cancel(SimScheduler::INVALID_TASK));
+    PreciseTimeSimBackend::clear();
+}
+
+void run_scheduler_tests() {
+    RUN_TEST(test_scheduler_zero_drift_over_1e7_periods);
+    RUN_TEST(test_scheduler_overrun_policies);
+    RUN_TEST(test_scheduler_one_shot_and_cancel);
+    RUN_TEST(test_scheduler_callback_cancels_itself_and_rebase);
+    RUN_TEST(test_scheduler_stale_id_after_reuse);
+}
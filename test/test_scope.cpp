@@ -0,0 +1,168 @@
+/**
+ * @file test_scope.cpp
+ * @brief Tests de PRECISE_SCOPE et du registre des sites
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeScope.h>
+
+#if !defined(ARDUINO)
+#include <thread>
+#include <vector>
+#endif
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeScopeRegistry<SimTime> SimScopes;
+
+struct ScopeCapture {
+    char text[512];
+    size_t length;
+
+    ScopeCapture() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+static void scoped_work(uint64_t micros) {
+    PRECISE_SCOPE_CLOCK(SimTime, "scope_work");
+    PreciseTimeSimBackend::advance(micros);
+}
+
+static void scoped_outer() {
+    PRECISE_SCOPE_CLOCK(SimTime, "scope_outer");
+    PreciseTimeSimBackend::advance(100);
+    scoped_work(50);
+    {
+        PRECISE_SCOPE_CLOCK(SimTime, "scope_inner");
+        PreciseTimeSimBackend::advance(25);
+    }
+}
+
+static void scope_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    SimScopes::clearAll();
+}
+
+void test_scope_records_statistics() {
+    scope_setup();
+    scoped_work(30);
+    scoped_work(10);
+    scoped_work(20);
+
+    const PreciseTimeScopeSite<SimTime>* site = SimScopes::find("scope_work");
+    TEST_ASSERT_NOT_NULL(site);
+    TEST_ASSERT_EQUAL_UINT32(3, site->count);
+    TEST_ASSERT_EQUAL_UINT64(60, site->total);
+    TEST_ASSERT_EQUAL_UINT64(10, site->min);
+    TEST_ASSERT_EQUAL_UINT64(30, site->max);
+    TEST_ASSERT_EQUAL_UINT64(20, site->last);
+}
+
+void test_scope_one_site_per_call_site() {
+    scope_setup();
+    uint32_t before = SimScopes::size();
+    for (int i = 0; i < 10; i++) scoped_outer();
+    // scope_outer et scope_inner s'ajoutent une seule fois
+    TEST_ASSERT_TRUE(SimScopes::size() - before <= 2);
+    TEST_ASSERT_EQUAL_UINT32(0, SimScopes::dropped());
+
+    const PreciseTimeScopeSite<SimTime>* outer = SimScopes::find("scope_outer");
+    const PreciseTimeScopeSite<SimTime>* inner = SimScopes::find("scope_inner");
+    const PreciseTimeScopeSite<SimTime>* work = SimScopes::find("scope_work");
+    TEST_ASSERT_NOT_NULL(outer);
+    TEST_ASSERT_NOT_NULL(inner);
+    TEST_ASSERT_EQUAL_UINT32(10, outer->count);
+    TEST_ASSERT_EQUAL_UINT64(175, outer->last);     // portées imbriquées incluses
+    TEST_ASSERT_EQUAL_UINT64(25, inner->max);
+    TEST_ASSERT_EQUAL_UINT32(10, work->count);
+    TEST_ASSERT_NULL(SimScopes::find("scope_absent"));
+}
+
+void test_scope_dump() {
+    scope_setup();
+    scoped_work(1500);
+    scoped_work(500);
+
+    ScopeCapture out;
+    size_t written = SimScopes::dump(out);
+    TEST_ASSERT_EQUAL_UINT32(out.length, written);
+    TEST_ASSERT_NOT_NULL(strstr(out.text,
+        "scope_work : 2 appels, moy 1000 us, min 500, max 1500, dernier 500\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out.text, "scope_inner : 0 appels\n"));
+    PreciseTimeSimBackend::clear();
+}
+
+#if !defined(ARDUINO)
+// Horloge propre au test : son registre est vide au départ
+struct ScopeRaceClock {
+    static const uint64_t TICKS_PER_SECOND = 1000000ULL;
+};
+typedef PreciseTimeScopeRegistry<ScopeRaceClock> RaceScopes;
+
+// Des sites s'inscrivent depuis plusieurs threads pendant qu'un lecteur
+// parcourt le registre : chaque site listé doit être déjà rangé (un
+// emplacement encore vide ferait lire un pointeur nul).
+void test_scope_registry_concurrent_add() {
+    const int WRITERS = 4;
+    const int SITES_PER_WRITER = PRECISE_TIME_SCOPE_MAX_SITES / WRITERS + 2;
+    static const char* names[] = { "race_a", "race_b", "race_c", "race_d" };
+    std::atomic<int> writers_left(WRITERS);
+    std::atomic<uint32_t> empty(0);
+
+    std::thread reader([&]() {
+        while (writers_left.load() > 0) {
+            for (uint32_t i = 0; i < RaceScopes::size(); i++) {
+                if (RaceScopes::site(i).name[0] != 'r') empty++;
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < WRITERS; w++) {
+        writers.push_back(std::thread([&, w]() {
+            // Un site vit aussi longtemps que le registre, comme une statique
+            for (int i = 0; i < SITES_PER_WRITER; i++) {
+                new PreciseTimeScopeSite<ScopeRaceClock>(names[w]);
+            }
+            writers_left--;
+        }));
+    }
+    for (size_t w = 0; w < writers.size(); w++) writers[w].join();
+    reader.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, empty.load());
+    TEST_ASSERT_EQUAL_UINT32(PRECISE_TIME_SCOPE_MAX_SITES, RaceScopes::size());
+    TEST_ASSERT_EQUAL_UINT32(WRITERS * SITES_PER_WRITER - PRECISE_TIME_SCOPE_MAX_SITES,
+                             RaceScopes::dropped());
+    for (uint32_t i = 0; i < RaceScopes::size(); i++) {
+        TEST_ASSERT_TRUE(RaceScopes::site(i).name[0] == 'r');
+    }
+}
+#endif
+
+void run_scope_tests() {
+    RUN_TEST(test_scope_records_statistics);
+    RUN_TEST(test_scope_one_site_per_call_site);
+    RUN_TEST(test_scope_dump);
+#if !defined(ARDUINO)
+    RUN_TEST(test_scope_registry_concurrent_add);
+#endif
+}
@@ -0,0 +1,90 @@
+/**
+ * @file test_seqlock.cpp
+ * @brief Tests du chemin de lecture sans verrou de time_fct_micros
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeSeqlock.h>
+
+#if !defined(ARDUINO)
+#include <thread>
+#include <vector>
+#endif
+
+void test_seqlock_store_load() {
+    PreciseTimeSeqlock64 value;
+    TEST_ASSERT_EQUAL_UINT64(0, value.load());
+    value.store(0x123456789ABCDEF0ULL);
+    TEST_ASSERT_EQUAL_UINT64(0x123456789ABCDEF0ULL, value.load());
+}
+
+void test_seqlock_increment_carries_into_high_word() {
+    PreciseTimeSeqlock64 value;
+    value.store(0xFFFFFFFFULL);
+    value.increment();
+    TEST_ASSERT_EQUAL_UINT64(0x100000000ULL, value.load());
+}
+
+#if !defined(ARDUINO)
+/**
+ * L'écrivain publie des valeurs dont les deux mots sont égaux
+ * (k * 0x100000001) ; toute lecture déchirée mélange deux valeurs et
+ * se voit immédiatement (hi != lo). On vérifie aussi que chaque lecteur
+ * voit une suite croissante.
+ */
+void test_seqlock_no_torn_reads_under_contention() {
+    const uint32_t READS_PER_READER = 5000000;
+    const int READERS = 3;
+    PreciseTimeSeqlock64 value;
+    std::atomic<int> readers_left(READERS);
+    std::atomic<uint32_t> torn(0);
+    std::atomic<uint32_t> backwards(0);
+
+    // L'écrivain tourne tant qu'un lecteur travaille encore
+    std::thread writer([&]() {
+        uint64_t k = 0;
+        while (readers_left.load(std::memory_order_relaxed) > 0) {
+            k++;
+            value.store(k * 0x100000001ULL);
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.push_back(std::thread([&]() {
+            uint64_t previous = 0;
+            for (uint32_t i = 0; i < READS_PER_READER; i++) {
+                uint64_t v = value.load();
+                if ((uint32_t)(v >> 32) != (uint32_t)v) torn++;
+                if (v < previous) backwards++;
+                previous = v;
+            }
+            readers_left--;
+        }));
+    }
+
+    for (size_t r = 0; r < readers.size(); r++) readers[r].join();
+    writer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+    TEST_ASSERT_EQUAL_UINT32(0, backwards.load());
+    TEST_ASSERT_GREATER_THAN_UINT64(0, value.load());
+}
+#endif
+
+void run_seqlock_tests() {
+    RUN_TEST(test_seqlock_store_load);
+    RUN_TEST(test_seqlock_increment_carries_into_high_word);
+#if !defined(ARDUINO)
+    RUN_TEST(test_seqlock_no_torn_reads_under_contention);
+#endif
+}
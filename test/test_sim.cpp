@@ -0,0 +1,149 @@
+/**
+ * @file test_sim.cpp
+ * @brief Tests de l'horloge virtuelle PreciseTimeSimBackend
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTime.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+static uint64_t sim_fired_at[8];
+static int sim_fired_count = 0;
+
+static void record_fire(void* arg) {
+    (void)arg;
+    if (sim_fired_count < 8) sim_fired_at[sim_fired_count] = PreciseTimeSimBackend::now();
+    sim_fired_count++;
+}
+
+static void record_tag(void* arg) {
+    if (sim_fired_count < 8) sim_fired_at[sim_fired_count] = (uint64_t)(uintptr_t)arg;
+    sim_fired_count++;
+}
+
+static uint32_t heartbeat_count = 0;
+
+// Timer périodique : se réarme depuis son propre rappel
+static void heartbeat(void* arg) {
+    heartbeat_count++;
+    uint64_t period = *(uint64_t*)arg;
+    PreciseTimeSimBackend::addTimer(PreciseTimeSimBackend::now() + period, heartbeat, arg);
+}
+
+static void sim_setup() {
+    PreciseTimeSimBackend::clear();
+    sim_fired_count = 0;
+    heartbeat_count = 0;
+    SimTime::begin();
+    SimTime::reset();
+}
+
+void test_sim_time_only_moves_on_advance() {
+    sim_setup();
+    TEST_ASSERT_EQUAL_UINT64(0, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(0, SimTime::getMicroseconds());
+    PreciseTimeSimBackend::advance(1500);
+    TEST_ASSERT_EQUAL_UINT64(1500, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(1, SimTime::getMilliseconds());
+    PreciseTimeSimBackend::runUntil(1000);     // dans le passé : sans effet
+    TEST_ASSERT_EQUAL_UINT64(1500, SimTime::getMicroseconds());
+}
+
+void test_sim_timers_fire_in_deadline_order() {
+    sim_setup();
+    PreciseTimeSimBackend::addTimer(300, record_fire);
+    PreciseTimeSimBackend::addTimer(100, record_fire);
+    PreciseTimeSimBackend::addTimer(200, record_fire);
+    PreciseTimeSimBackend::addTimer(5000, record_fire);
+    uint32_t fired = PreciseTimeSimBackend::advance(1000);
+    TEST_ASSERT_EQUAL_UINT32(3, fired);
+    TEST_ASSERT_EQUAL_UINT64(100, sim_fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT64(200, sim_fired_at[1]);
+    TEST_ASSERT_EQUAL_UINT64(300, sim_fired_at[2]);
+    TEST_ASSERT_EQUAL_UINT64(1000, PreciseTimeSimBackend::now());
+    TEST_ASSERT_EQUAL_UINT64(5000, PreciseTimeSimBackend::nextDeadline());
+}
+
+void test_sim_equal_deadlines_keep_registration_order() {
+    sim_setup();
+    PreciseTimeSimBackend::addTimer(50, record_tag, (void*)1);
+    PreciseTimeSimBackend::addTimer(50, record_tag, (void*)2);
+    PreciseTimeSimBackend::addTimer(50, record_tag, (void*)3);
+    PreciseTimeSimBackend::advance(50);
+    TEST_ASSERT_EQUAL_INT(3, sim_fired_count);
+    TEST_ASSERT_EQUAL_UINT64(1, sim_fired_at[0]);
+    TEST_ASSERT_EQUAL_UINT64(2, sim_fired_at[1]);
+    TEST_ASSERT_EQUAL_UINT64(3, sim_fired_at[2]);
+}
+
+void test_sim_cancel_timer() {
+    sim_setup();
+    int id = PreciseTimeSimBackend::addTimer(100, record_fire);
+    TEST_ASSERT_TRUE(PreciseTimeSimBackend::cancelTimer(id));
+    TEST_ASSERT_FALSE(PreciseTimeSimBackend::cancelTimer(id));
+    PreciseTimeSimBackend::advance(1000);
+    TEST_ASSERT_EQUAL_INT(0, sim_fired_count);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, PreciseTimeSimBackend::nextDeadline());
+}
+
+void test_sim_stale_timer_id_after_reuse() {
+    sim_setup();
+    int fired = PreciseTimeSimBackend::addTimer(100, record_fire);
+    PreciseTimeSimBackend::advance(100);
+    TEST_ASSERT_EQUAL_INT(1, sim_fired_count);
+
+    // Même emplacement, nouvelle génération : l'ancien identifiant ne l'annule pas
+    int reused = PreciseTimeSimBackend::addTimer(300, record_fire);
+    TEST_ASSERT_TRUE(reused != fired);
+    TEST_ASSERT_FALSE(PreciseTimeSimBackend::cancelTimer(fired));
+    TEST_ASSERT_EQUAL_UINT64(300, PreciseTimeSimBackend::nextDeadline());
+
+    int cancelled = PreciseTimeSimBackend::addTimer(400, record_fire);
+    TEST_ASSERT_TRUE(PreciseTimeSimBackend::cancelTimer(cancelled));
+    int replacement = PreciseTimeSimBackend::addTimer(500, record_fire);
+    TEST_ASSERT_FALSE(PreciseTimeSimBackend::cancelTimer(cancelled));
+
+    // clear() ne remet pas les générations à zéro
+    PreciseTimeSimBackend::clear();
+    int after_clear = PreciseTimeSimBackend::addTimer(100, record_fire);
+    TEST_ASSERT_TRUE(after_clear != fired && after_clear != reused && after_clear != replacement);
+    TEST_ASSERT_FALSE(PreciseTimeSimBackend::cancelTimer(reused));
+    TEST_ASSERT_TRUE(PreciseTimeSimBackend::cancelTimer(after_clear));
+    TEST_ASSERT_FALSE(PreciseTimeSimBackend::cancelTimer(-1));
+    PreciseTimeSimBackend::clear();
+}
+
+void test_sim_week_of_uptime() {
+    sim_setup();
+    static uint64_t period = 1000000ULL;
+    PreciseTimeSimBackend::addTimer(period, heartbeat, &period);
+    PreciseTimeSimBackend::advance(7ULL * 86400ULL * 1000000ULL);
+    TEST_ASSERT_EQUAL_UINT32(7UL * 86400UL, heartbeat_count);
+
+    uint64_t days;
+    uint32_t hours, minutes, seconds;
+    SimTime::getFormattedTime(days, hours, minutes, seconds);
+    TEST_ASSERT_EQUAL_UINT64(7, days);
+    TEST_ASSERT_EQUAL_UINT32(0, hours);
+    TEST_ASSERT_EQUAL_UINT32(0, seconds);
+    PreciseTimeSimBackend::clear();
+}
+
+void run_sim_tests() {
+    RUN_TEST(test_sim_time_only_moves_on_advance);
+    RUN_TEST(test_sim_timers_fire_in_deadline_order);
+    RUN_TEST(test_sim_equal_deadlines_keep_registration_order);
+    RUN_TEST(test_sim_cancel_timer);
+    RUN_TEST(test_sim_stale_timer_id_after_reuse);
+    RUN_TEST(test_sim_week_of_uptime);
+}
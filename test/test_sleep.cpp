@@ -0,0 +1,131 @@
+/**
+ * @file test_sleep.cpp
+ * @brief Tests de l'attente hybride sleepUntil()/sleepFor() sur l'horloge
+ *        virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTime.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+/**
+ * @brief Attente virtuelle qui se réveille `late` µs après la durée
+ *        demandée, comme un ordonnanceur chargé
+ */
+struct LateYield {
+    static const uint32_t GRANULARITY_US = 1;
+    static uint64_t late;
+    static uint32_t sleeps;
+    static uint32_t spins;
+
+    static void sleep(uint64_t micros) {
+        sleeps++;
+        PreciseTimeSimBackend::advance(micros + late);
+    }
+
+    static void spin() {
+        spins++;
+        PreciseTimeSimBackend::advance(1);
+    }
+};
+
+uint64_t LateYield::late = 0;
+uint32_t LateYield::sleeps = 0;
+uint32_t LateYield::spins = 0;
+
+typedef PreciseTimeSleeper<SimTime, LateYield> LateSleeper;
+
+static void sleep_setup(uint64_t late) {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    LateYield::late = late;
+    LateYield::sleeps = 0;
+    LateYield::spins = 0;
+}
+
+void test_sleep_for_is_exact_on_sim() {
+    sleep_setup(0);
+    SimTime::sleepFor(500);
+    TEST_ASSERT_EQUAL_UINT64(500, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT64(0, SimTime::sleepUntil(1500));
+    TEST_ASSERT_EQUAL_UINT64(1500, SimTime::getMicroseconds());
+    // Échéance déjà passée : ni attente ni avance
+    TEST_ASSERT_EQUAL_UINT64(500, SimTime::sleepUntil(1000));
+    TEST_ASSERT_EQUAL_UINT64(1500, SimTime::getMicroseconds());
+}
+
+// Un réveil en retard de 200 µs sur une marge de 10 : l'échéance est
+// manquée une fois, puis la marge passe à 250 et la fin se fait en boucle
+// active
+void test_sleep_margin_grows_after_late_wakeup() {
+    sleep_setup(200);
+    LateSleeper::setMargin(10);
+    TEST_ASSERT_EQUAL_UINT64(190, LateSleeper::forDuration(5000));
+    TEST_ASSERT_EQUAL_UINT32(250, LateSleeper::margin());
+
+    uint64_t start = SimTime::getMicroseconds();
+    LateYield::spins = 0;
+    TEST_ASSERT_EQUAL_UINT64(0, LateSleeper::until(start + 5000));
+    TEST_ASSERT_EQUAL_UINT64(start + 5000, SimTime::getMicroseconds());
+    TEST_ASSERT_EQUAL_UINT32(50, LateYield::spins);
+    TEST_ASSERT_EQUAL_UINT32(250, LateSleeper::margin());
+    PreciseTimeSimBackend::clear();
+}
+
+// Réveils redevenus ponctuels : la marge redescend vers le minimum et la
+// boucle active raccourcit, sans jamais manquer l'échéance
+void test_sleep_margin_decays_when_punctual() {
+    sleep_setup(0);
+    LateSleeper::setMargin(250);
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT64(0, LateSleeper::forDuration(2000));
+    }
+    TEST_ASSERT_TRUE(LateSleeper::margin() < 18);
+    TEST_ASSERT_TRUE(LateSleeper::margin() >= PRECISE_TIME_SLEEP_MIN_MARGIN_US);
+
+    LateYield::spins = 0;
+    LateSleeper::forDuration(2000);
+    TEST_ASSERT_TRUE(LateYield::spins < 18);
+    PreciseTimeSimBackend::clear();
+}
+
+// Une durée plus courte que la marge se fait entièrement en boucle active
+void test_sleep_short_duration_spins_only() {
+    sleep_setup(0);
+    LateSleeper::setMargin(100);
+    TEST_ASSERT_EQUAL_UINT64(0, LateSleeper::forDuration(60));
+    TEST_ASSERT_EQUAL_UINT32(0, LateYield::sleeps);
+    TEST_ASSERT_EQUAL_UINT32(60, LateYield::spins);
+    // Sans réveil pour la mesurer, la marge décroît quand même
+    TEST_ASSERT_TRUE(LateSleeper::margin() < 100);
+    PreciseTimeSimBackend::clear();
+}
+
+// Horloge par défaut : jamais de réveil avant l'échéance
+void test_sleep_never_early() {
+    PreciseTime::begin();
+    for (int i = 0; i < 5; i++) {
+        uint64_t deadline = PreciseTime::getMicroseconds() + 1500;
+        PreciseTime::sleepUntil(deadline);
+        TEST_ASSERT_TRUE(PreciseTime::getMicroseconds() >= deadline);
+    }
+}
+
+void run_sleep_tests() {
+    RUN_TEST(test_sleep_for_is_exact_on_sim);
+    RUN_TEST(test_sleep_margin_grows_after_late_wakeup);
+    RUN_TEST(test_sleep_margin_decays_when_punctual);
+    RUN_TEST(test_sleep_short_duration_spins_only);
+    RUN_TEST(test_sleep_never_early);
+}
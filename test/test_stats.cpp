@@ -0,0 +1,251 @@
+/**
+ * @file test_stats.cpp
+ * @brief Tests des statistiques glissantes (Welford, P²)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeStats.h>
+
+#if !defined(ARDUINO)
+#include <vector>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+static uint64_t stats_rng = 0x2545F4914F6CDD1DULL;
+
+static uint32_t stats_random() {
+    stats_rng ^= stats_rng << 13;
+    stats_rng ^= stats_rng >> 7;
+    stats_rng ^= stats_rng << 17;
+    return (uint32_t)(stats_rng >> 32);
+}
+
+/**
+ * 10^8 intervalles autour d'une seconde (1 000 000 µs ± 5 ms) : forte
+ * composante continue, là où somme(x²) - somme(x)²/n perd toute précision
+ * en double. Référence exacte par sommes entières sur 128 bits.
+ */
+void test_stats_welford_accuracy_1e8() {
+    const uint32_t base = 1000000UL;
+    const uint64_t samples = 100000000ULL;
+    PreciseTimeWelford welford;
+    PreciseTimeWelfordInt welford_int;
+    uint64_t sum = 0;
+    unsigned __int128 sum_squares = 0;
+    uint32_t lowest = UINT32_MAX, highest = 0;
+
+    for (uint64_t i = 0; i < samples; i++) {
+        uint32_t offset = stats_random() % 10000UL;
+        uint32_t value = base - 5000UL + offset;
+        welford.add((double)value);
+        welford_int.add(value);
+        sum += offset;
+        sum_squares += (unsigned __int128)offset * offset;
+        if (value < lowest) lowest = value;
+        if (value > highest) highest = value;
+    }
+
+    // Moyenne et variance de population exactes (la variance ne dépend pas
+    // du décalage)
+    long double mean_offset = (long double)sum / samples;
+    long double exact_mean = (long double)(base - 5000UL) + mean_offset;
+    unsigned __int128 scaled = sum_squares * samples - (unsigned __int128)sum * sum;
+    long double exact_variance = (long double)scaled / ((long double)samples * samples);
+
+    TEST_ASSERT_EQUAL_UINT64(samples, welford.samples());
+    TEST_ASSERT_TRUE(fabsl(welford.mean() - exact_mean) / exact_mean < 1e-12L);
+    TEST_ASSERT_TRUE(fabsl(welford.populationVariance() - exact_variance) / exact_variance < 1e-9L);
+    TEST_ASSERT_EQUAL_UINT32(lowest, (uint32_t)welford.min());
+    TEST_ASSERT_EQUAL_UINT32(highest, (uint32_t)welford.max());
+
+    // Entiers : moyenne à 2^-8 près, variance à 10^-4 près
+    TEST_ASSERT_EQUAL_UINT32(samples, welford_int.samples());
+    TEST_ASSERT_TRUE(fabsl(welford_int.meanQ8() / 256.0L - exact_mean) <= 2.0L / 256.0L);
+    TEST_ASSERT_TRUE(fabsl(welford_int.varianceQ8() / 256.0L - exact_variance) / exact_variance < 1e-4L);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(sqrtl(exact_variance) + 0.5L), welford_int.stddev());
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(exact_mean + 0.5L), welford_int.mean());
+    TEST_ASSERT_EQUAL_UINT32(lowest, welford_int.min());
+    TEST_ASSERT_EQUAL_UINT32(highest, welford_int.max());
+}
+
+static double exact_quantile(std::vector<uint32_t>& sorted, double p) {
+    return sorted[(size_t)(p * (sorted.size() - 1) + 0.5)];
+}
+
+/**
+ * @brief P² contre les quantiles exacts, pour trois distributions
+ */
+void test_stats_p2_quantiles() {
+    for (int shape = 0; shape < 3; shape++) {
+        PreciseTimeRunningStats stats;
+        PreciseTimeRunningStatsInt stats_int;
+        std::vector<uint32_t> samples;
+        for (int i = 0; i < 1000000; i++) {
+            uint32_t value;
+            if (shape == 0) {
+                value = 1000 + stats_random() % 1000;                   // uniforme
+            } else if (shape == 1) {
+                value = 0;                                              // ~normale
+                for (int k = 0; k < 12; k++) value += stats_random() % 1000;
+            } else {
+                double u = (stats_random() + 1.0) / 4294967297.0;       // exponentielle
+                value = (uint32_t)(-log(u) * 1000.0);
+            }
+            samples.push_back(value);
+            stats.add(value);
+            stats_int.add(value);
+        }
+        std::sort(samples.begin(), samples.end());
+        double median = exact_quantile(samples, 0.5);
+        double p95 = exact_quantile(samples, 0.95);
+        double range = samples.back() - samples.front();
+
+        // Erreur sous 1 % de l'étendue des valeurs
+        TEST_ASSERT_TRUE(fabs(stats.median() - median) < range * 0.01);
+        TEST_ASSERT_TRUE(fabs(stats.p95() - p95) < range * 0.01);
+        TEST_ASSERT_TRUE(fabs(stats_int.median() - median) < range * 0.01);
+        TEST_ASSERT_TRUE(fabs(stats_int.p95() - p95) < range * 0.01);
+        TEST_ASSERT_EQUAL_UINT32(samples.front(), stats_int.min());
+        TEST_ASSERT_EQUAL_UINT32(samples.back(), stats_int.max());
+    }
+}
+
+/**
+ * @brief P² sur 10^8 échantillons : latences autour de 1000 avec une queue
+ *        de 5 % jusqu'à 11 000, quantiles exacts par comptage
+ */
+void test_stats_p2_quantiles_1e8() {
+    const uint64_t samples = 100000000ULL;
+    const uint32_t span = 12000;
+    std::vector<uint32_t> counts(span, 0);
+    PreciseTimeRunningStats stats;
+    PreciseTimeRunningStatsInt stats_int;
+    for (uint64_t i = 0; i < samples; i++) {
+        uint32_t r = stats_random();
+        uint32_t value = 1000 + r % 1000;
+        if ((r >> 16) % 20 == 0) value += stats_random() % 10000;
+        counts[value]++;
+        stats.add(value);
+        stats_int.add(value);
+    }
+    uint64_t median_rank = (uint64_t)(0.5 * (samples - 1) + 0.5);
+    uint64_t p95_rank = (uint64_t)(0.95 * (samples - 1) + 0.5);
+    uint32_t median = 0, p95 = 0, lowest = span, highest = 0;
+    uint64_t seen = 0;
+    for (uint32_t v = 0; v < span; v++) {
+        if (counts[v] == 0) continue;
+        if (v < lowest) lowest = v;
+        highest = v;
+        if (seen <= median_rank && median_rank < seen + counts[v]) median = v;
+        if (seen <= p95_rank && p95_rank < seen + counts[v]) p95 = v;
+        seen += counts[v];
+    }
+    double range = highest - lowest;
+
+    // Erreur sous 1 % de l'étendue des valeurs
+    TEST_ASSERT_TRUE(fabs(stats.median() - median) < range * 0.01);
+    TEST_ASSERT_TRUE(fabs(stats.p95() - p95) < range * 0.01);
+    TEST_ASSERT_TRUE(fabs((double)stats_int.median() - median) < range * 0.01);
+    TEST_ASSERT_TRUE(fabs((double)stats_int.p95() - p95) < range * 0.01);
+    TEST_ASSERT_EQUAL_UINT32(samples, stats_int.samples());
+}
+
+/**
+ * @brief decay() conserve les estimations et donne plus de poids à la suite
+ */
+void test_stats_int_decay() {
+    PreciseTimeRunningStatsInt stats;
+    for (int i = 0; i < 100001; i++) stats.add(1000 + stats_random() % 1000);
+    uint32_t mean = stats.mean(), median = stats.median(), p95 = stats.p95();
+    uint64_t variance = stats.varianceQ8();
+    stats.decay();
+    TEST_ASSERT_EQUAL_UINT32(50001, stats.samples());
+    TEST_ASSERT_EQUAL_UINT32(mean, stats.mean());
+    // n impair : la moyenne ajoutée réduit la variance de 1/n
+    TEST_ASSERT_TRUE(llabs((long long)(variance - stats.varianceQ8())) <= (long long)(variance / 50000 + 8));
+    TEST_ASSERT_EQUAL_UINT32(median, stats.median());
+    TEST_ASSERT_EQUAL_UINT32(p95, stats.p95());
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.min());
+
+    // La suite garde son poids entier : 50 001 anciens contre 50 000 nouveaux
+    for (int i = 0; i < 50000; i++) stats.add(3000 + stats_random() % 1000);
+    TEST_ASSERT_TRUE(stats.mean() > 2400 && stats.mean() < 2600);
+    TEST_ASSERT_TRUE(stats.p95() > 3800 && stats.p95() < 4000);
+
+    // Variance nulle après decay() malgré les arrondis de Σ
+    PreciseTimeWelfordInt constant;
+    for (int i = 0; i < 3; i++) constant.add(5);
+    constant.decay();
+    TEST_ASSERT_EQUAL_UINT32(2, constant.samples());
+    TEST_ASSERT_EQUAL_UINT32(5, constant.mean());
+    TEST_ASSERT_EQUAL_UINT64(0, constant.varianceQ8());
+}
+
+void test_stats_few_samples() {
+    PreciseTimeRunningStats stats;
+    PreciseTimeRunningStatsInt stats_int;
+    TEST_ASSERT_EQUAL_UINT32(0, stats_int.median());
+    TEST_ASSERT_TRUE(stats.median() == 0.0);
+
+    const uint32_t values[] = { 30, 10, 20 };
+    for (int i = 0; i < 3; i++) {
+        stats.add(values[i]);
+        stats_int.add(values[i]);
+    }
+    TEST_ASSERT_TRUE(stats.median() == 20.0);
+    TEST_ASSERT_TRUE(stats.mean() == 20.0);
+    TEST_ASSERT_TRUE(stats.variance() == 100.0);
+    TEST_ASSERT_TRUE(stats.min() == 10.0);
+    TEST_ASSERT_EQUAL_UINT32(20, stats_int.median());
+    TEST_ASSERT_EQUAL_UINT32(20, stats_int.mean());
+    TEST_ASSERT_EQUAL_UINT32(30, stats_int.p95());
+
+    stats.reset();
+    stats_int.reset();
+    TEST_ASSERT_EQUAL_UINT64(0, stats.samples());
+    TEST_ASSERT_EQUAL_UINT32(0, stats_int.samples());
+}
+
+/**
+ * Bord du domaine : valeurs 0 et 2^24 - 1 alternées, Σx² dépasse 2^64
+ */
+void test_stats_welford_int_domain_edge() {
+    PreciseTimeWelfordInt moments;
+    const uint32_t top = (1UL << 24) - 1;
+    const uint32_t n = 1000000;
+    for (uint32_t i = 0; i < n; i++) moments.add(i & 1 ? top : 0);
+    // Moyenne top/2, variance de population (top/2)^2 exactement
+    TEST_ASSERT_EQUAL_INT64((int64_t)top << 7, moments.meanQ8());
+    TEST_ASSERT_EQUAL_UINT64(((uint64_t)top * top) << 6, moments.varianceQ8());
+    TEST_ASSERT_EQUAL_UINT32((top + 1) / 2, moments.stddev());
+    TEST_ASSERT_EQUAL_UINT32(0, moments.min());
+    TEST_ASSERT_EQUAL_UINT32(top, moments.max());
+
+    moments.reset();
+    for (uint32_t i = 0; i < n; i++) moments.add(top);
+    TEST_ASSERT_EQUAL_UINT64(0, moments.varianceQ8());
+    TEST_ASSERT_EQUAL_UINT32(top, moments.mean());
+}
+
+void run_stats_tests() {
+    RUN_TEST(test_stats_few_samples);
+    RUN_TEST(test_stats_p2_quantiles);
+    RUN_TEST(test_stats_welford_accuracy_1e8);
+    RUN_TEST(test_stats_welford_int_domain_edge);
+    RUN_TEST(test_stats_p2_quantiles_1e8);
+    RUN_TEST(test_stats_int_decay);
+}
+#else
+void run_stats_tests() {
+}
+#endif
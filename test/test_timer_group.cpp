@@ -0,0 +1,120 @@
+/**
+ * @file test_timer_group.cpp
+ * @brief Tests du mode sans interruption ESP32 sur une maquette des registres
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeTimerGroup.h>
+
+/**
+ * @brief Maquette du timer 0 : compteur libre, capture et rechargement
+ *
+ * Chaque accès registre fait avancer le compteur de `step` ticks, ce qui
+ * simule le temps qui passe entre deux instructions. `interfere` est
+ * appelé après la première lecture de LO pour simuler une ISR ou l'autre
+ * cœur qui recapture le compteur au pire moment.
+ */
+struct MockTimerGroupRegs {
+    static uint64_t counter;
+    static uint64_t latched;
+    static uint64_t load;
+    static uint32_t step;
+    static uint32_t low_reads;
+    static void (*interfere)();
+
+    static uint32_t read(PreciseTimeTimerGroupReg reg) {
+        counter += step;
+        if (reg == PRECISE_TIMG_T0LO) {
+            uint32_t value = (uint32_t)latched;
+            if (++low_reads == 1 && interfere) interfere();
+            return value;
+        }
+        if (reg == PRECISE_TIMG_T0HI) return (uint32_t)(latched >> 32);
+        return 0;
+    }
+
+    static void write(PreciseTimeTimerGroupReg reg, uint32_t value) {
+        counter += step;
+        switch (reg) {
+            case PRECISE_TIMG_T0UPDATE: latched = counter; break;
+            case PRECISE_TIMG_T0LOADLO: load = (load & 0xFFFFFFFF00000000ULL) | value; break;
+            case PRECISE_TIMG_T0LOADHI: load = (load & 0xFFFFFFFFULL) | ((uint64_t)value << 32); break;
+            case PRECISE_TIMG_T0LOAD:   counter = load; break;
+            default: break;
+        }
+    }
+
+    static void reset(uint64_t start, uint32_t ticks_per_access) {
+        counter = start;
+        latched = 0;
+        load = 0;
+        step = ticks_per_access;
+        low_reads = 0;
+        interfere = nullptr;
+    }
+};
+
+uint64_t MockTimerGroupRegs::counter = 0;
+uint64_t MockTimerGroupRegs::latched = 0;
+uint64_t MockTimerGroupRegs::load = 0;
+uint32_t MockTimerGroupRegs::step = 0;
+uint32_t MockTimerGroupRegs::low_reads = 0;
+void (*MockTimerGroupRegs::interfere)() = nullptr;
+
+typedef PreciseTimeTimerGroup<MockTimerGroupRegs> MockCounter;
+
+static void relatch_after_wrap() {
+    MockTimerGroupRegs::counter += 16;
+    MockTimerGroupRegs::latched = MockTimerGroupRegs::counter;
+}
+
+void test_timer_group_reads_latched_value() {
+    MockTimerGroupRegs::reset(123456789ULL, 0);
+    TEST_ASSERT_EQUAL_UINT64(123456789ULL, MockCounter::read());
+}
+
+void test_timer_group_monotonic_across_32bit_boundary() {
+    MockTimerGroupRegs::reset(0xFFFFFFF0ULL, 1);
+    uint64_t previous = MockCounter::read();
+    for (int i = 0; i < 64; i++) {
+        uint64_t now = MockCounter::read();
+        TEST_ASSERT_GREATER_THAN_UINT64(previous, now);
+        TEST_ASSERT_LESS_THAN_UINT64(previous + 16, now);
+        previous = now;
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)(previous >> 32));
+}
+
+void test_timer_group_retries_on_concurrent_latch() {
+    // Capture à 0xFFFFFFFE puis recapture concurrente après le passage
+    // à 2^32 : une lecture naïve renverrait 0x1FFFFFFFE (+71 minutes).
+    MockTimerGroupRegs::reset(0xFFFFFFFDULL, 1);
+    MockTimerGroupRegs::interfere = relatch_after_wrap;
+    uint64_t value = MockCounter::read();
+    TEST_ASSERT_GREATER_THAN_UINT32(2, MockTimerGroupRegs::low_reads);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(0x100000000ULL, value);
+    TEST_ASSERT_LESS_THAN_UINT64(0x100000000ULL + 64, value);
+}
+
+void test_timer_group_reload_restarts_count() {
+    MockTimerGroupRegs::reset(5000000000ULL, 1);
+    MockCounter::write(0);
+    uint64_t value = MockCounter::read();
+    TEST_ASSERT_LESS_THAN_UINT64(16, value);
+}
+
+void run_timer_group_tests() {
+    RUN_TEST(test_timer_group_reads_latched_value);
+    RUN_TEST(test_timer_group_monotonic_across_32bit_boundary);
+    RUN_TEST(test_timer_group_retries_on_concurrent_latch);
+    RUN_TEST(test_timer_group_reload_restarts_count);
+}
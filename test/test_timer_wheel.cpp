@@ -0,0 +1,173 @@
+/**
+ * @file test_timer_wheel.cpp
+ * @brief Tests de la roue de temporisation hiérarchique sur l'horloge virtuelle
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeTimerWheel.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+// Petite roue (3 niveaux de 8 cases, 512 ticks) pour traverser souvent
+// les cascades et la liste de débordement
+typedef PreciseTimeTimerWheel<SimTime, 10, 3, 3> SmallWheel;
+typedef PreciseTimeTimerWheel<SimTime> DefaultWheel;
+
+struct WheelProbe {
+    PreciseTimeWheelTimer timer;
+    uint64_t deadline;
+    uint64_t fired_at;
+    uint32_t fired;
+};
+
+static void wheel_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+}
+
+static void recordFire(PreciseTimeWheelTimer&, void* context) {
+    WheelProbe* probe = (WheelProbe*)context;
+    probe->fired_at = SimTime::getMicroseconds();
+    probe->fired++;
+}
+
+// Avance l'horloge virtuelle d'un pas de `step` µs et fait tourner la roue
+template <class Wheel>
+static uint32_t wheel_run(Wheel& wheel, uint64_t until, uint64_t step) {
+    uint32_t expired = 0;
+    while (SimTime::getMicroseconds() < until) {
+        PreciseTimeSimBackend::advance(step);
+        expired += wheel.update();
+    }
+    return expired;
+}
+
+void test_timer_wheel_exact_expiry_across_levels() {
+    wheel_setup();
+    SmallWheel wheel;
+    static WheelProbe probes[400];
+    // Échéances réparties sur 0..20 000 µs : niveau 0, cascades, débordement
+    uint32_t seed = 12345;
+    for (int i = 0; i < 400; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        probes[i].deadline = 10 + (seed >> 8) % 20000;
+        probes[i].fired = 0;
+        wheel.startAt(probes[i].timer, probes[i].deadline, recordFire, &probes[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(400, wheel.pending());
+    TEST_ASSERT_EQUAL_UINT32(400, wheel_run(wheel, 21000, 10));
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.pending());
+
+    for (int i = 0; i < 400; i++) {
+        TEST_ASSERT_EQUAL_UINT32(1, probes[i].fired);
+        // Jamais en avance, au plus un tick de retard
+        uint64_t tick_end = (probes[i].deadline + 9) / 10 * 10;
+        TEST_ASSERT_EQUAL_UINT64(tick_end, probes[i].fired_at);
+        TEST_ASSERT_FALSE(probes[i].timer.isPending());
+    }
+}
+
+void test_timer_wheel_large_jump_batches() {
+    wheel_setup();
+    SmallWheel wheel;
+    static WheelProbe probes[100];
+    for (int i = 0; i < 100; i++) {
+        probes[i].fired = 0;
+        wheel.start(probes[i].timer, 100 + i * 97, recordFire, &probes[i]);
+    }
+    // Un seul advance() sur 10 000 µs : toutes expirent en un lot
+    PreciseTimeSimBackend::advance(10000);
+    TEST_ASSERT_EQUAL_UINT32(100, wheel.update());
+    TEST_ASSERT_EQUAL_UINT64(10000, wheel.now());
+    for (int i = 0; i < 100; i++) TEST_ASSERT_EQUAL_UINT32(1, probes[i].fired);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, wheel.nextDeadline());
+}
+
+void test_timer_wheel_cancel() {
+    wheel_setup();
+    DefaultWheel wheel;
+    WheelProbe a = {}, b = {}, c = {};
+    wheel.start(a.timer, 5000, recordFire, &a);
+    wheel.start(b.timer, 5000, recordFire, &b);
+    wheel.start(c.timer, 70000000, recordFire, &c);    // 19 h : débordement
+    TEST_ASSERT_TRUE(wheel.cancel(b.timer));
+    TEST_ASSERT_FALSE(wheel.cancel(b.timer));
+    TEST_ASSERT_TRUE(wheel.cancel(c.timer));
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.pending());
+    TEST_ASSERT_EQUAL_UINT64(5000, wheel.nextDeadline());
+
+    // Relancer une minuterie armée la déplace
+    wheel.start(a.timer, 8000, recordFire, &a);
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.pending());
+    TEST_ASSERT_EQUAL_UINT32(1, wheel_run(wheel, 10000, 1000));
+    TEST_ASSERT_EQUAL_UINT64(8000, a.fired_at);
+    TEST_ASSERT_EQUAL_UINT32(0, b.fired);
+    TEST_ASSERT_EQUAL_UINT32(0, c.fired);
+}
+
+// Deux minuteries du même lot : la première appelée annule l'autre et se
+// relance deux fois (périodique)
+static SmallWheel* batch_wheel;
+static WheelProbe batch_probes[2];
+
+static void cancelPartnerAndRearm(PreciseTimeWheelTimer& timer, void* context) {
+    WheelProbe* probe = (WheelProbe*)context;
+    recordFire(timer, context);
+    batch_wheel->cancel(batch_probes[probe == &batch_probes[0] ? 1 : 0].timer);
+    if (probe->fired < 3) batch_wheel->start(timer, 50, cancelPartnerAndRearm, context);
+}
+
+void test_timer_wheel_callbacks_modify_batch() {
+    wheel_setup();
+    SmallWheel wheel;
+    batch_wheel = &wheel;
+    for (int i = 0; i < 2; i++) {
+        batch_probes[i].fired = 0;
+        wheel.start(batch_probes[i].timer, 100, cancelPartnerAndRearm, &batch_probes[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, wheel_run(wheel, 1000, 10));
+    TEST_ASSERT_EQUAL_UINT32(3, batch_probes[0].fired + batch_probes[1].fired);
+    TEST_ASSERT_TRUE(batch_probes[0].fired == 0 || batch_probes[1].fired == 0);
+    TEST_ASSERT_EQUAL_UINT64(200, batch_probes[batch_probes[0].fired ? 0 : 1].fired_at);
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.pending());
+}
+
+void test_timer_wheel_next_deadline_and_past_deadline() {
+    wheel_setup();
+    DefaultWheel wheel;
+    WheelProbe near = {}, far = {}, past = {};
+    wheel.start(near.timer, 3000, recordFire, &near);
+    wheel.start(far.timer, 500000, recordFire, &far);
+    TEST_ASSERT_EQUAL_UINT64(3000, wheel.nextDeadline());
+    wheel_run(wheel, 3000, 1000);
+    // 500 ms = 500 ticks : niveau 1, la borne est l'instant de la cascade
+    uint64_t bound = wheel.nextDeadline();
+    TEST_ASSERT_TRUE(bound > 3000 && bound <= 500000);
+
+    wheel.startAt(past.timer, 0, recordFire, &past);     // déjà passée
+    PreciseTimeSimBackend::advance(1000);
+    TEST_ASSERT_EQUAL_UINT32(1, wheel.update());
+    TEST_ASSERT_EQUAL_UINT32(1, past.fired);
+
+    wheel.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, wheel.pending());
+    TEST_ASSERT_FALSE(far.timer.isPending());
+    PreciseTimeSimBackend::clear();
+}
+
+void run_timer_wheel_tests() {
+    RUN_TEST(test_timer_wheel_exact_expiry_across_levels);
+    RUN_TEST(test_timer_wheel_large_jump_batches);
+    RUN_TEST(test_timer_wheel_cancel);
+    RUN_TEST(test_timer_wheel_callbacks_modify_batch);
+    RUN_TEST(test_timer_wheel_next_deadline_and_past_deadline);
+}
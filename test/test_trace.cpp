@@ -0,0 +1,197 @@
+/**
+ * @file test_trace.cpp
+ * @brief Tests de l'anneau de traces et de l'export Chrome JSON
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeTrace.h>
+
+#if !defined(ARDUINO)
+#include <thread>
+#include <vector>
+#endif
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+typedef PreciseTimeTraceBuffer<SimTime, 8> SmallTrace;
+
+struct TraceCapture {
+    char text[2048];
+    size_t length;
+
+    TraceCapture() : length(0) { text[0] = '\0'; }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(text) - 1; i++) {
+            text[length++] = (char)data[i];
+        }
+        text[length] = '\0';
+        return size;
+    }
+};
+
+static void trace_setup() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+}
+
+void test_trace_record_and_pop() {
+    trace_setup();
+    static SmallTrace trace;
+    trace.clear();
+
+    PreciseTimeSimBackend::advance(10);
+    TEST_ASSERT_TRUE(trace.record(PRECISE_TIME_TRACE_BEGIN, 3, 7, 0));
+    PreciseTimeSimBackend::advance(25);
+    TEST_ASSERT_TRUE(trace.record(PRECISE_TIME_TRACE_END, 3, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, trace.size());
+
+    PreciseTimeTraceEvent event;
+    TEST_ASSERT_TRUE(trace.pop(event));
+    TEST_ASSERT_EQUAL_UINT64(10, event.timestamp);
+    TEST_ASSERT_EQUAL_UINT8('B', event.phase);
+    TEST_ASSERT_EQUAL_UINT16(3, event.id);
+    TEST_ASSERT_EQUAL_UINT32(7, event.arg);
+    TEST_ASSERT_TRUE(trace.pop(event));
+    TEST_ASSERT_EQUAL_UINT64(35, event.timestamp);
+    TEST_ASSERT_EQUAL_UINT8('E', event.phase);
+    TEST_ASSERT_FALSE(trace.pop(event));
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+}
+
+void test_trace_full_ring_drops() {
+    trace_setup();
+    static SmallTrace trace;
+    trace.clear();
+
+    for (uint32_t i = 0; i < 11; i++) {
+        TEST_ASSERT_EQUAL(i < 8, trace.record(PRECISE_TIME_TRACE_INSTANT, 1, i, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, trace.size());
+    TEST_ASSERT_EQUAL_UINT32(3, trace.dropped());
+
+    // Les plus anciens sont conservés, dans l'ordre, sur de nombreux tours
+    PreciseTimeTraceEvent events[8];
+    TEST_ASSERT_EQUAL_UINT32(8, trace.drain(events, 8));
+    for (uint32_t i = 0; i < 8; i++) TEST_ASSERT_EQUAL_UINT32(i, events[i].arg);
+    for (uint32_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(trace.record(PRECISE_TIME_TRACE_INSTANT, 1, i, 0));
+        TEST_ASSERT_TRUE(trace.pop(events[0]));
+        TEST_ASSERT_EQUAL_UINT32(i, events[0].arg);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, trace.dropped());
+}
+
+void test_trace_chrome_json() {
+    trace_setup();
+    static SmallTrace trace;
+    trace.clear();
+    trace.setName(1, "loop");
+    trace.setName(2, "rx \"uart\"");
+
+    PreciseTimeSimBackend::advance(1500);
+    trace.record(PRECISE_TIME_TRACE_BEGIN, 1, 0, 0);
+    PreciseTimeSimBackend::advance(250);
+    trace.record(PRECISE_TIME_TRACE_INSTANT, 2, 42, 1);
+    trace.record(PRECISE_TIME_TRACE_INSTANT, 9, 0, 1);
+    PreciseTimeSimBackend::advance(250);
+    trace.record(PRECISE_TIME_TRACE_END, 1, 0, 0);
+    for (int i = 0; i < 6; i++) trace.record(PRECISE_TIME_TRACE_INSTANT, 9, 0, 0);
+
+    TraceCapture out;
+    size_t written = trace.exportChromeJson(out);
+    TEST_ASSERT_EQUAL_UINT32(out.length, written);
+    const char* expected = "{\"traceEvents\":[\n"
+        "{\"name\":\"loop\",\"ph\":\"B\",\"ts\":1500.000,\"pid\":1,\"tid\":0,\"args\":{\"arg\":0}}\n"
+        ",{\"name\":\"rx \\\"uart\\\"\",\"ph\":\"i\",\"ts\":1750.000,\"pid\":1,\"tid\":1,\"s\":\"t\",\"args\":{\"arg\":42}}\n"
+        ",{\"name\":\"event 9\",\"ph\":\"i\",";
+    TEST_ASSERT_EQUAL_INT(0, strncmp(out.text, expected, strlen(expected)));
+    TEST_ASSERT_NOT_NULL(strstr(out.text,
+        ",{\"name\":\"loop\",\"ph\":\"E\",\"ts\":2000.000,\"pid\":1,\"tid\":0,\"args\":{\"arg\":0}}\n"));
+    TEST_ASSERT_NOT_NULL(strstr(out.text,
+        "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":2}}\n"));
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+    PreciseTimeSimBackend::clear();
+}
+
+#if !defined(ARDUINO)
+typedef PreciseTimeT<PreciseTimeNativeBackend> TraceNativeTime;
+typedef PreciseTimeTraceBuffer<TraceNativeTime, 1024> ConcurrentTrace;
+
+#define TRACE_PRODUCERS  4
+#define TRACE_PER_PRODUCER  200000
+
+// Quatre producteurs et un consommateur simultanés : chaque événement est
+// soit reçu une seule fois, dans l'ordre de son producteur, soit compté perdu.
+void test_trace_concurrent_producers() {
+    static ConcurrentTrace trace;
+    trace.clear();
+    TraceNativeTime::begin();
+
+    std::atomic<int> running(TRACE_PRODUCERS);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < TRACE_PRODUCERS; p++) {
+        producers.push_back(std::thread([p, &running]() {
+            for (uint32_t i = 0; i < TRACE_PER_PRODUCER; i++) {
+                trace.record(PRECISE_TIME_TRACE_INSTANT, (uint16_t)p, i, (uint8_t)p);
+            }
+            running--;
+        }));
+    }
+
+    uint32_t received[TRACE_PRODUCERS] = {0};
+    int64_t last_arg[TRACE_PRODUCERS] = {-1, -1, -1, -1};
+    bool ordered = true;
+    PreciseTimeTraceEvent event;
+    for (;;) {
+        bool done = running.load() == 0;
+        while (trace.pop(event)) {
+            if ((int64_t)event.arg <= last_arg[event.track] || event.id != event.track) ordered = false;
+            last_arg[event.track] = event.arg;
+            received[event.track]++;
+        }
+        if (done) break;
+    }
+    for (size_t p = 0; p < producers.size(); p++) producers[p].join();
+
+    uint32_t total = 0;
+    for (int p = 0; p < TRACE_PRODUCERS; p++) total += received[p];
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_EQUAL_UINT32(TRACE_PRODUCERS * TRACE_PER_PRODUCER, total + trace.dropped());
+    TEST_ASSERT_TRUE(total > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+}
+
+void test_trace_native_tracks() {
+    static PreciseTimeTraceBuffer<TraceNativeTime, 16> trace;
+    trace.clear();
+    trace.instant(1);
+    std::thread([]() { trace.instant(2); }).join();
+
+    PreciseTimeTraceEvent first, second;
+    TEST_ASSERT_TRUE(trace.pop(first));
+    TEST_ASSERT_TRUE(trace.pop(second));
+    TEST_ASSERT_TRUE(first.track != second.track);
+    TEST_ASSERT_TRUE(second.timestamp >= first.timestamp);
+}
+#endif
+
+void run_trace_tests() {
+    RUN_TEST(test_trace_record_and_pop);
+    RUN_TEST(test_trace_full_ring_drops);
+    RUN_TEST(test_trace_chrome_json);
+#if !defined(ARDUINO)
+    RUN_TEST(test_trace_concurrent_producers);
+    RUN_TEST(test_trace_native_tracks);
+#endif
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_trace_stream.cpp
+ * @brief Tests aller-retour du flux binaire de traces
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <PreciseTimeTraceStream.h>
+
+typedef PreciseTimeT<PreciseTimeSimBackend> SimTime;
+
+#define STREAM_EVENTS  2000
+
+struct StreamCapture {
+    uint8_t data[STREAM_EVENTS * PRECISE_TIME_TRACE_FRAME_MAX];
+    size_t length;
+
+    StreamCapture() : length(0) {}
+
+    size_t write(const uint8_t* bytes, size_t size) {
+        for (size_t i = 0; i < size && length < sizeof(data); i++) data[length++] = bytes[i];
+        return size;
+    }
+};
+
+static uint32_t stream_seed = 12345;
+
+static uint32_t streamRandom() {
+    stream_seed = stream_seed * 1664525UL + 1013904223UL;
+    return stream_seed;
+}
+
+// Événements variés : deltas nuls, petits, énormes et négatifs
+static void makeEvents(PreciseTimeTraceEvent* events, uint32_t count) {
+    uint64_t timestamp = 1000;
+    static const uint8_t phases[3] = {
+        PRECISE_TIME_TRACE_BEGIN, PRECISE_TIME_TRACE_END, PRECISE_TIME_TRACE_INSTANT
+    };
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t r = streamRandom();
+        switch (r % 8) {
+            case 0: break;
+            case 1: timestamp += 1ULL << 40; break;
+            case 2: timestamp -= r % 50; break;
+            default: timestamp += r % 3000; break;
+        }
+        events[i].timestamp = timestamp;
+        events[i].arg = (r & 0x100) ? streamRandom() : 0;
+        events[i].id = (uint16_t)(streamRandom() % ((r & 0x200) ? 65536 : 100));
+        events[i].phase = phases[(r >> 12) % 3];
+        events[i].track = (uint8_t)((r >> 16) % 30);
+    }
+}
+
+static bool sameEvent(const PreciseTimeTraceEvent& a, const PreciseTimeTraceEvent& b) {
+    return a.timestamp == b.timestamp && a.arg == b.arg && a.id == b.id
+        && a.phase == b.phase && a.track == b.track;
+}
+
+/**
+ * @brief Décode `size` octets par tranches de `chunk` ; renvoie le nombre
+ *        d'événements et compte les synchronisations et octets ignorés
+ */
+static uint32_t decodeAll(const uint8_t* data, size_t size, size_t chunk,
+                          PreciseTimeTraceEvent* out, uint32_t* syncs, size_t* skipped) {
+    PreciseTimeTraceDecoder decoder;
+    PreciseTimeTraceFrame frame;
+    uint32_t count = 0;
+    size_t pos = 0;
+    size_t available = chunk < size ? chunk : size;
+    *syncs = 0;
+    *skipped = 0;
+    for (;;) {
+        size_t used = decoder.next(data + pos, available - pos, frame);
+        if (used == 0) {
+            if (available == size) break;
+            available = (available + chunk < size) ? available + chunk : size;
+            continue;
+        }
+        pos += used;
+        if (frame.kind == PRECISE_TIME_TRACE_FRAME_EVENT) out[count++] = frame.event;
+        if (frame.kind == PRECISE_TIME_TRACE_FRAME_SYNC) (*syncs)++;
+        if (frame.kind == PRECISE_TIME_TRACE_FRAME_SKIPPED) *skipped += used;
+    }
+    return count;
+}
+
+void test_trace_stream_varint() {
+    static const uint64_t values[] = {
+        0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX, 1ULL << 56, UINT64_MAX
+    };
+    uint8_t buffer[10];
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        size_t length = PreciseTimeVarint::put(buffer, values[i]);
+        uint64_t decoded;
+        TEST_ASSERT_EQUAL_INT((int)length, PreciseTimeVarint::get(buffer, length, decoded));
+        TEST_ASSERT_EQUAL_UINT64(values[i], decoded);
+        TEST_ASSERT_EQUAL_INT(0, PreciseTimeVarint::get(buffer, length - 1, decoded));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, PreciseTimeVarint::put(buffer, 127));
+    TEST_ASSERT_EQUAL_UINT32(10, PreciseTimeVarint::put(buffer, UINT64_MAX));
+
+    static const int64_t signed_values[] = { 0, -1, 1, -64, 63, INT64_MIN, INT64_MAX };
+    for (size_t i = 0; i < sizeof(signed_values) / sizeof(signed_values[0]); i++) {
+        TEST_ASSERT_TRUE(PreciseTimeVarint::unzigzag(PreciseTimeVarint::zigzag(signed_values[i])) == signed_values[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT64(1, PreciseTimeVarint::zigzag(-1));
+    TEST_ASSERT_EQUAL_UINT64(126, PreciseTimeVarint::zigzag(63));
+}
+
+void test_trace_stream_round_trip() {
+    static PreciseTimeTraceEvent events[STREAM_EVENTS];
+    static PreciseTimeTraceEvent decoded[STREAM_EVENTS];
+    static StreamCapture out;
+    out.length = 0;
+    makeEvents(events, STREAM_EVENTS);
+
+    PreciseTimeTraceEncoder encoder(1000000ULL, 64);
+    for (uint32_t i = 0; i < STREAM_EVENTS; i++) encoder.write(out, events[i]);
+
+    // Tranches d'un octet : chaque trame est d'abord vue incomplète
+    static const size_t chunks[] = { 1, 7, sizeof(out.data) };
+    for (size_t c = 0; c < 3; c++) {
+        uint32_t syncs;
+        size_t skipped;
+        uint32_t count = decodeAll(out.data, out.length, chunks[c], decoded, &syncs, &skipped);
+        TEST_ASSERT_EQUAL_UINT32(STREAM_EVENTS, count);
+        TEST_ASSERT_EQUAL_UINT32((STREAM_EVENTS + 63) / 64, syncs);
+        TEST_ASSERT_EQUAL_UINT32(0, skipped);
+        for (uint32_t i = 0; i < STREAM_EVENTS; i++) TEST_ASSERT_TRUE(sameEvent(events[i], decoded[i]));
+    }
+}
+
+void test_trace_stream_compact() {
+    static StreamCapture out;
+    out.length = 0;
+    PreciseTimeTraceEncoder encoder(1000000ULL, 64);
+    PreciseTimeTraceEvent event = { 5000000, 0, 3, PRECISE_TIME_TRACE_INSTANT, 1 };
+    for (uint32_t i = 0; i < 64; i++) {
+        event.timestamp += 100;             // une toutes les 100 µs
+        encoder.write(out, event);
+    }
+    // Sync (4 + 3 + 4 + 1 octets) puis 63 trames de 4 octets (étiquette,
+    // delta 100 en 2 octets, identifiant) ; la première a un delta nul.
+    TEST_ASSERT_EQUAL_UINT32(12 + 3 + 63 * 4, out.length);
+    TEST_ASSERT_TRUE(out.length < 64 * sizeof(PreciseTimeTraceEvent) / 3);
+}
+
+void test_trace_stream_resync() {
+    static PreciseTimeTraceEvent events[STREAM_EVENTS];
+    static PreciseTimeTraceEvent decoded[STREAM_EVENTS];
+    static StreamCapture out;
+    out.length = 0;
+    makeEvents(events, STREAM_EVENTS);
+
+    PreciseTimeTraceEncoder encoder(1000000ULL, 16);
+    size_t cut_start = 0, cut_end = 0;
+    for (uint32_t i = 0; i < STREAM_EVENTS; i++) {
+        if (i == 100) cut_start = out.length + 1;      // au milieu d'une trame
+        if (i == 105) cut_end = out.length;
+        encoder.write(out, events[i]);
+    }
+    // Perte de 5 trames au milieu (octets manquants sur la liaison série)
+    memmove(out.data + cut_start, out.data + cut_end, out.length - cut_end);
+    out.length -= cut_end - cut_start;
+
+    uint32_t syncs;
+    size_t skipped;
+    uint32_t count = decodeAll(out.data, out.length, sizeof(out.data), decoded, &syncs, &skipped);
+    // Avant la coupure : intact ; après l'une des synchronisations
+    // suivantes (112, ou 128 si une trame corrompue a avalé la première) : intact
+    for (uint32_t i = 0; i < 100; i++) TEST_ASSERT_TRUE(sameEvent(events[i], decoded[i]));
+    uint32_t tail = STREAM_EVENTS - 128;
+    TEST_ASSERT_TRUE(count >= 100 + tail);
+    for (uint32_t i = 0; i < tail; i++) {
+        TEST_ASSERT_TRUE(sameEvent(events[STREAM_EVENTS - 1 - i], decoded[count - 1 - i]));
+    }
+
+    // Démarrage de la capture au milieu du flux : rien avant la première sync
+    count = decodeAll(out.data + 5, out.length - 5, sizeof(out.data), decoded, &syncs, &skipped);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_TRUE(sameEvent(events[16], decoded[0]) || sameEvent(events[32], decoded[0]));
+}
+
+void test_trace_stream_drain_buffer() {
+    PreciseTimeSimBackend::clear();
+    SimTime::begin();
+    SimTime::reset();
+    static PreciseTimeTraceBuffer<SimTime, 8> trace;
+    trace.clear();
+    trace.setName(1, "tache");
+    trace.setName(2, "irq");
+
+    PreciseTimeSimBackend::advance(1000);
+    trace.begin(1);
+    PreciseTimeSimBackend::advance(40);
+    trace.instant(2, 9);
+    PreciseTimeSimBackend::advance(60);
+    trace.end(1);
+    for (int i = 0; i < 7; i++) trace.instant(2);     // 2 perdus
+
+    static StreamCapture out;
+    out.length = 0;
+    PreciseTimeTraceEncoder encoder(SimTime::TICKS_PER_SECOND);
+    size_t written = encoder.drainTo(trace, out);
+    TEST_ASSERT_EQUAL_UINT32(out.length, written);
+
+    PreciseTimeTraceDecoder decoder;
+    PreciseTimeTraceFrame frame;
+    size_t pos = 0;
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL(PRECISE_TIME_TRACE_FRAME_NAME, frame.kind);
+    TEST_ASSERT_EQUAL_STRING("tache", frame.name);
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL_STRING("irq", frame.name);
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL(PRECISE_TIME_TRACE_FRAME_SYNC, frame.kind);
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, frame.ticks_per_second);
+    TEST_ASSERT_EQUAL_UINT32(2, frame.dropped);
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL(PRECISE_TIME_TRACE_FRAME_EVENT, frame.kind);
+    TEST_ASSERT_EQUAL_UINT64(1000, frame.event.timestamp);
+    TEST_ASSERT_EQUAL_UINT8('B', frame.event.phase);
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL_UINT64(1040, frame.event.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(9, frame.event.arg);
+    pos += decoder.next(out.data + pos, out.length - pos, frame);
+    TEST_ASSERT_EQUAL_UINT64(1100, frame.event.timestamp);
+    TEST_ASSERT_EQUAL_UINT8('E', frame.event.phase);
+    TEST_ASSERT_EQUAL_UINT32(0, trace.size());
+
+    // Second appel : noms déjà envoyés, pas de synchronisation avant 64 événements
+    out.length = 0;
+    trace.instant(1);
+    encoder.drainTo(trace, out);
+    TEST_ASSERT_TRUE(out.length <= 4);
+    PreciseTimeSimBackend::clear();
+}
+
+void run_trace_stream_tests() {
+    RUN_TEST(test_trace_stream_varint);
+    RUN_TEST(test_trace_stream_round_trip);
+    RUN_TEST(test_trace_stream_compact);
+    RUN_TEST(test_trace_stream_resync);
+    RUN_TEST(test_trace_stream_drain_buffer);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file test_tsc.cpp
+ * @brief Tests de la calibration du TSC (hôte x86-64 uniquement)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeTsc.h>
+
+#if defined(PRECISE_TIME_HAS_TSC)
+static uint64_t referenceNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void test_tsc_calibration_frequency() {
+    PreciseTimeTsc tsc;
+    if (!tsc.calibrate()) {
+        TEST_IGNORE_MESSAGE("TSC invariant absent : repli sur clock_gettime()");
+    }
+    TEST_ASSERT_GREATER_THAN_UINT64(100000000ULL, tsc.frequencyHz());
+    TEST_ASSERT_LESS_THAN_UINT64(10000000000ULL, tsc.frequencyHz());
+}
+
+void test_tsc_tracks_monotonic_clock() {
+    PreciseTimeTsc tsc;
+    if (!tsc.calibrate()) {
+        TEST_IGNORE_MESSAGE("TSC invariant absent : repli sur clock_gettime()");
+    }
+    uint64_t start_ref = referenceNanos();
+    uint64_t start_tsc = tsc.nanoseconds();
+    while (referenceNanos() - start_ref < 50000000ULL) {
+    }
+    uint64_t elapsed_tsc = tsc.nanoseconds() - start_tsc;
+    uint64_t elapsed_ref = referenceNanos() - start_ref;
+    // 10 ms de calibration : l'erreur reste bien sous 0,1 % sur 50 ms
+    TEST_ASSERT_UINT64_WITHIN(50000, elapsed_ref, elapsed_tsc);
+}
+
+void test_tsc_conversion_is_monotonic() {
+    PreciseTimeTsc tsc;
+    if (!tsc.calibrate(1000000ULL)) {
+        TEST_IGNORE_MESSAGE("TSC invariant absent : repli sur clock_gettime()");
+    }
+    uint64_t previous = tsc.nanoseconds();
+    for (int i = 0; i < 100000; i++) {
+        uint64_t now = tsc.nanoseconds();
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT64(previous, now);
+        previous = now;
+    }
+}
+#endif
+
+void run_tsc_tests() {
+#if defined(PRECISE_TIME_HAS_TSC)
+    RUN_TEST(test_tsc_calibration_frequency);
+    RUN_TEST(test_tsc_tracks_monotonic_clock);
+    RUN_TEST(test_tsc_conversion_is_monotonic);
+#endif
+}
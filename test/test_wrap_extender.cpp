@@ -0,0 +1,126 @@
+/**
+ * @file test_wrap_extender.cpp
+ * @brief Simulation de millions de débordements d'un compteur 32 bits
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ */
+
+#include <unity.h>
+#include <PreciseTimeWrapExtender.h>
+
+#if defined(ARDUINO)
+#define WRAP_SIMULATION_WRAPS  10000ULL
+#else
+#define WRAP_SIMULATION_WRAPS  2000000ULL
+#endif
+
+/**
+ * @brief Compteur 32 bits simulé, piloté par un temps vrai 64 bits
+ */
+struct SimulatedCounter {
+    uint64_t true_time;
+    uint32_t rng;
+
+    uint32_t operator()() const { return (uint32_t)true_time; }
+
+    // xorshift32 : reproductible et disponible aussi sur cible
+    uint32_t random() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    // Écarts entre appels : surtout petits, parfois proches de la limite
+    // de demi-période (2^31 - 1).
+    uint32_t randomGap() {
+        uint32_t r = random();
+        switch (r & 3) {
+            case 0:  return r >> 22;
+            case 1:  return r >> 12;
+            default: return (r >> 1) & 0x7FFFFFFEUL;
+        }
+    }
+};
+
+/**
+ * @brief Source qui simule une ISR interrompant read() entre la lecture
+ *        de l'état et celle du compteur
+ */
+struct InterruptedSource {
+    SimulatedCounter* counter;
+    PreciseTimeWrapExtender* extender;
+    uint32_t* mismatches;
+
+    uint32_t operator()() const {
+        if ((counter->random() & 7) == 0) {
+            counter->true_time += counter->random() >> 26;
+            uint64_t nested = extender->read(*counter);
+            if (nested != counter->true_time) (*mismatches)++;
+        }
+        return (*counter)();
+    }
+};
+
+void test_wrap_extender_first_read() {
+    PreciseTimeWrapExtender extender;
+    SimulatedCounter counter = { 0xF0000000ULL, 1 };
+    TEST_ASSERT_EQUAL_UINT64(0xF0000000ULL, extender.read(counter));
+    counter.true_time = 0x100000010ULL;
+    TEST_ASSERT_EQUAL_UINT64(0x100000010ULL, extender.read(counter));
+}
+
+void test_wrap_extender_millions_of_wraps() {
+    PreciseTimeWrapExtender extender;
+    SimulatedCounter counter = { 0, 0x12345678UL };
+    uint64_t previous = 0;
+    uint32_t jumps = 0;
+    uint32_t backwards = 0;
+    const uint64_t end = WRAP_SIMULATION_WRAPS << 32;
+
+    while (counter.true_time < end) {
+        counter.true_time += counter.randomGap();
+        uint64_t value = extender.read(counter);
+        if (value != counter.true_time) jumps++;
+        if (value < previous) backwards++;
+        previous = value;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, jumps);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_EQUAL_UINT64(WRAP_SIMULATION_WRAPS, previous >> 32);
+}
+
+void test_wrap_extender_interrupted_reads() {
+    PreciseTimeWrapExtender extender;
+    SimulatedCounter counter = { 0, 0xCAFEBABEUL };
+    uint32_t nested_mismatches = 0;
+    InterruptedSource source = { &counter, &extender, &nested_mismatches };
+    uint64_t previous = 0;
+    uint32_t jumps = 0;
+    const uint64_t end = (WRAP_SIMULATION_WRAPS / 4) << 32;
+
+    while (counter.true_time < end) {
+        // Garde l'écart total (boucle + ISR) sous la demi-période
+        counter.true_time += counter.randomGap() >> 1;
+        uint64_t value = extender.read(source);
+        if (value != counter.true_time || value < previous) jumps++;
+        previous = value;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, jumps);
+    TEST_ASSERT_EQUAL_UINT32(0, nested_mismatches);
+}
+
+void run_wrap_extender_tests() {
+    RUN_TEST(test_wrap_extender_first_read);
+    RUN_TEST(test_wrap_extender_millions_of_wraps);
+    RUN_TEST(test_wrap_extender_interrupted_reads);
+}
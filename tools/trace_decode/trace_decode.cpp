@@ -0,0 +1,149 @@
+/**
+ * @file trace_decode.cpp
+ * @brief Convertit un flux binaire de traces capturé (PreciseTimeTraceStream.h)
+ *        en CSV ou en JSON Chrome Trace Event (pio run -e trace_decode)
+ * @version 1.1.0
+ * @date 2026
+ *
+ * Copyright (C) 2025 Fo170
+ *
+ * Ce programme est un logiciel libre ; vous pouvez le redistribuer
+ * et/ou le modifier selon les termes de la GNU General Public License
+ * telle que publiée par la Free Software Foundation ; soit la version 3
+ * de la Licence, soit (à votre choix) toute version ultérieure.
+ *
+ * Utilisation : trace_decode [--csv | --json] [entrée [sortie]]
+ * Sans fichier (ou "-"), lit l'entrée standard et écrit la sortie standard.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <PreciseTimeTraceStream.h>
+
+#define DECODE_CHUNK  65536
+
+static char names[65536][PRECISE_TIME_TRACE_NAME_MAX + 1];
+
+static void usage() {
+    fprintf(stderr, "Utilisation : trace_decode [--csv | --json] [entrée [sortie]]\n");
+}
+
+// Horodatage en microsecondes avec trois décimales
+static void printMicros(FILE* out, uint64_t ticks, uint64_t ticks_per_second) {
+    unsigned long long nanos = (unsigned long long)((long double)ticks * 1e9L / (long double)ticks_per_second);
+    fprintf(out, "%llu.%03llu", nanos / 1000ULL, nanos % 1000ULL);
+}
+
+// Nom JSON/CSV : caractères de contrôle remplacés, `"` et `\` échappés pour le JSON
+static void printName(FILE* out, uint16_t id, bool json) {
+    if (names[id][0] == '\0') {
+        fprintf(out, "event %u", (unsigned)id);
+        return;
+    }
+    for (const char* c = names[id]; *c != '\0'; c++) {
+        if (*c == '"' || (json && *c == '\\')) fputc(json ? '\\' : '"', out);
+        fputc((unsigned char)*c < ' ' ? ' ' : *c, out);
+    }
+}
+
+int main(int argc, char** argv) {
+    bool json = true;
+    const char* paths[2] = { "-", "-" };
+    int path_count = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            json = false;
+        } else if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            usage();
+            return 2;
+        } else if (path_count < 2) {
+            paths[path_count++] = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    FILE* in = strcmp(paths[0], "-") == 0 ? stdin : fopen(paths[0], "rb");
+    if (in == nullptr) {
+        perror(paths[0]);
+        return 1;
+    }
+    FILE* out = strcmp(paths[1], "-") == 0 ? stdout : fopen(paths[1], "w");
+    if (out == nullptr) {
+        perror(paths[1]);
+        return 1;
+    }
+
+    static uint8_t data[2 * DECODE_CHUNK];
+    size_t size = 0;
+    bool eof = false;
+    PreciseTimeTraceDecoder decoder;
+    PreciseTimeTraceFrame frame;
+    unsigned long long events = 0, skipped = 0;
+    uint32_t dropped = 0;
+
+    if (json) {
+        fprintf(out, "{\"traceEvents\":[\n");
+    } else {
+        fprintf(out, "timestamp_us,track,phase,id,name,arg\n");
+    }
+
+    while (!eof || size > 0) {
+        if (!eof && size < DECODE_CHUNK) {
+            size_t read = fread(data + size, 1, DECODE_CHUNK, in);
+            if (read == 0) eof = true;
+            size += read;
+        }
+        size_t pos = 0;
+        for (;;) {
+            size_t used = decoder.next(data + pos, size - pos, frame);
+            if (used == 0) break;
+            pos += used;
+            if (frame.kind == PRECISE_TIME_TRACE_FRAME_SKIPPED) {
+                skipped += used;
+            } else if (frame.kind == PRECISE_TIME_TRACE_FRAME_NAME) {
+                memcpy(names[frame.event.id], frame.name, sizeof(frame.name));
+            } else if (frame.kind == PRECISE_TIME_TRACE_FRAME_SYNC) {
+                dropped = frame.dropped;
+            } else {
+                const PreciseTimeTraceEvent& e = frame.event;
+                if (json) {
+                    fprintf(out, "%s{\"name\":\"", events > 0 ? "," : "");
+                    printName(out, e.id, true);
+                    fprintf(out, "\",\"ph\":\"%c\",\"ts\":", (char)e.phase);
+                    printMicros(out, e.timestamp, decoder.ticksPerSecond());
+                    fprintf(out, ",\"pid\":1,\"tid\":%u%s,\"args\":{\"arg\":%lu}}\n", (unsigned)e.track,
+                            e.phase == PRECISE_TIME_TRACE_INSTANT ? ",\"s\":\"t\"" : "",
+                            (unsigned long)e.arg);
+                } else {
+                    printMicros(out, e.timestamp, decoder.ticksPerSecond());
+                    fprintf(out, ",%u,%c,%u,\"", (unsigned)e.track, (char)e.phase, (unsigned)e.id);
+                    printName(out, e.id, false);
+                    fprintf(out, "\",%lu\n", (unsigned long)e.arg);
+                }
+                events++;
+            }
+        }
+        memmove(data, data + pos, size - pos);
+        size -= pos;
+        if (eof && size > 0) {
+            // Trame tronquée en fin de capture
+            skipped += size;
+            size = 0;
+        }
+    }
+
+    if (json) {
+        fprintf(out, "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%lu}}\n",
+                (unsigned long)dropped);
+    }
+    fprintf(stderr, "%llu événements, %llu octets ignorés, %lu perdus côté cible\n",
+            events, skipped, (unsigned long)dropped);
+
+    if (in != stdin) fclose(in);
+    if (out != stdout) fclose(out);
+    return 0;
+}